@@ -19,6 +19,7 @@
 
 #include "AppGateway.h"
 #include "AppGatewayTelemetry.h"
+#include "IAppGatewayDrain.h"
 #include <interfaces/IConfiguration.h>
 #include <interfaces/json/JsonData_AppGatewayResolver.h>
 #include <interfaces/json/JAppGatewayResolver.h>
@@ -30,6 +31,11 @@
 #define API_VERSION_NUMBER_MINOR    APPGATEWAY_MINOR_VERSION
 #define API_VERSION_NUMBER_PATCH    APPGATEWAY_PATCH_VERSION
 
+// Time a deactivation gives in-flight app requests to finish before connections are closed
+#ifndef APPGATEWAY_DRAIN_TIMEOUT_MS
+#define APPGATEWAY_DRAIN_TIMEOUT_MS 3000
+#endif
+
 
 namespace WPEFramework {
 
@@ -135,6 +141,15 @@ namespace Plugin {
             connection = service->RemoteConnection(mConnectionId);
         }
 
+        // Drain the app connections while the resolver and telemetry are still up
+        if (mResponder != nullptr) {
+            IAppGatewayDrain* drain = mResponder->QueryInterface<IAppGatewayDrain>();
+            if (drain != nullptr) {
+                drain->Drain(APPGATEWAY_DRAIN_TIMEOUT_MS);
+                drain->Release();
+            }
+        }
+
         // Deinitialize telemetry first (singleton - just call Deinitialize)
         AppGatewayTelemetry::getInstance().Deinitialize();
         if (mTelemetry != nullptr) {
@@ -30,9 +30,20 @@
 #include "UtilsCallsign.h"
 #include "UtilsFirebolt.h"
 #include "StringUtils.h"
+#include "UtilsRequestArena.h"
+#include "UtilsController.h"
+#include "UtilsJsonrpcDirectLink.h"
+#include "UtilsIso3166.h"
 
 #define DEFAULT_CONFIG_PATH "/etc/app-gateway/resolution.base.json"
 #define RESOLUTIONS_PATH_CFG "/etc/app-gateway/resolutions.json"
+// Parsed resolution tables, kept under the plugin's persistent path
+#define RESOLUTIONS_SNAPSHOT_FILE "resolutions.snapshot"
+// Snapshot of a regional table, by region index
+#define RESOLUTIONS_REGION_SNAPSHOT_FILE "resolutions.region%u.snapshot"
+
+#define SYSTEM_CALLSIGN "org.rdk.System"
+#define APPGATEWAY_TERRITORY_TIMEOUT_MS 2000
 
 // Build and vendor config paths are defined via CMake
 // These should be set in the platform-specific .bbappend file
@@ -88,18 +99,6 @@ namespace WPEFramework
                 Core::JSON::ArrayType<Core::JSON::String> countryCodes;
                 Core::JSON::ArrayType<Core::JSON::String> paths;
 
-                bool HasCountryCode(const std::string& country) const {
-                    auto index = countryCodes.Elements();
-                    while (index.Next()) {
-                        std::string code = index.Current().Value();
-                        // Case-insensitive equality using StringUtils::toLower
-                        if (StringUtils::toLower(code) == StringUtils::toLower(country)) {
-                            return true;
-                        }
-                    }
-                    return false;
-                }
-
                 std::vector<std::string> GetPaths() const {
                     std::vector<std::string> result;
                     auto index = paths.Elements();
@@ -118,33 +117,6 @@ namespace WPEFramework
             }
             ~RegionalResolutionConfig() {}
 
-            std::vector<std::string> GetPathsForCountry(const std::string& country) const {
-                std::vector<std::string> result;
-
-                // Search through regions for matching country code
-                auto index = regions.Elements();
-                while (index.Next()) {
-                    const Region& region = index.Current();
-                    if (region.HasCountryCode(country)) {
-                        result = region.GetPaths();
-                        LOGINFO("Found %zu paths for country '%s'", result.size(), country.c_str());
-                        return result;
-                    }
-                }
-
-                // If no match found and we have a default country, try that
-                if (!country.empty() && defaultCountryCode.IsSet()) {
-                    std::string defaultCode = defaultCountryCode.Value();
-                    if (!defaultCode.empty() && StringUtils::toLower(country) != StringUtils::toLower(defaultCode)) {
-                        LOGWARN("Country '%s' not found, trying default country '%s'",
-                                country.c_str(), defaultCode.c_str());
-                        return GetPathsForCountry(defaultCode);
-                    }
-                }
-
-                return result;
-            }
-
         public:
             Core::JSON::String defaultCountryCode;
             Core::JSON::ArrayType<Region> regions;
@@ -153,6 +125,11 @@ namespace WPEFramework
         AppGatewayImplementation::AppGatewayImplementation()
             : mService(nullptr),
             mResolverPtr(nullptr), 
+            mResolvers(),
+            mRegionalResolvers(),
+            mFallbackResolver(nullptr),
+            mTerritoryLock(),
+            mTerritoryLink(),
             mAppNotifications(nullptr),
             mAppGatewayResponder(nullptr),
             mInternalGatewayResponder(nullptr),
@@ -164,6 +141,15 @@ namespace WPEFramework
         AppGatewayImplementation::~AppGatewayImplementation()
         {
             LOGINFO("AppGatewayImplementation destructor");
+            std::shared_ptr<JSONRPC::LinkType<Core::JSON::IElement>> territoryLink;
+            {
+                Core::SafeSyncType<Core::CriticalSection> lock(mTerritoryLock);
+                territoryLink.swap(mTerritoryLink);
+            }
+            // Outside the lock: a territory event in flight takes it to switch tables
+            if (territoryLink) {
+                territoryLink->Unsubscribe(APPGATEWAY_TERRITORY_TIMEOUT_MS, _T("onTerritoryChanged"));
+            }
             if (nullptr != mService)
             {
                 mService->Release();
@@ -197,6 +183,9 @@ namespace WPEFramework
 
             // Shared pointer will automatically clean up
             mResolverPtr.reset();
+            mRegionalResolvers.clear();
+            mFallbackResolver.reset();
+            mResolvers.clear();
         }
 
         uint32_t AppGatewayImplementation::Configure(PluginHost::IShell *shell)
@@ -211,18 +200,13 @@ namespace WPEFramework
             if (Core::ERROR_NONE != result) {
                 return result;
             }
+            if (mResolvers.size() > 1) {
+                Core::IWorkerPool::Instance().Submit(TerritoryJob::Create(this));
+            }
             return result;
         }
         
         uint32_t AppGatewayImplementation::InitializeResolver() {
-            // Initialize resolver after setting mService
-            try {
-                mResolverPtr = std::make_shared<Resolver>(mService);
-            } catch (const std::bad_alloc& e) {
-                LOGERR("Failed to create Resolver instance: %s", e.what());
-                return Core::ERROR_GENERAL;
-            }
-
             // Read country from build config
             std::string country = ReadCountryFromConfigFile();
             if (country.empty()) {
@@ -241,10 +225,9 @@ namespace WPEFramework
                 LOGWARN("Failed to open resolutions config file: %s, falling back to default config", RESOLUTIONS_PATH_CFG);
 
                 // Fallback: Load only the base resolution file
-                std::vector<std::string> fallbackPaths = {DEFAULT_CONFIG_PATH};
                 LOGINFO("Using fallback: loading default config path: %s", DEFAULT_CONFIG_PATH);
-
-                Core::hresult configResult = InternalResolutionConfigure(std::move(fallbackPaths));
+                Core::hresult configResult = CompileResolver({ DEFAULT_CONFIG_PATH }, RESOLUTIONS_SNAPSHOT_FILE, mFallbackResolver);
+                SelectCountry(country);
                 if (configResult != Core::ERROR_NONE) {
                     LOGERR("Failed to configure resolutions from fallback path");
                     return configResult;
@@ -261,8 +244,8 @@ namespace WPEFramework
                 LOGERR("Failed to parse regional resolutions config file, error: '%s'",
                        (error.IsSet() ? error.Value().Message().c_str() : "Unknown"));
                 LOGWARN("Falling back to default config path: %s", DEFAULT_CONFIG_PATH);
-                std::vector<std::string> fallbackPaths = { DEFAULT_CONFIG_PATH };
-                Core::hresult configResult = InternalResolutionConfigure(std::move(fallbackPaths));
+                Core::hresult configResult = CompileResolver({ DEFAULT_CONFIG_PATH }, RESOLUTIONS_SNAPSHOT_FILE, mFallbackResolver);
+                SelectCountry(country);
                 if (configResult != Core::ERROR_NONE) {
                     LOGERR("Failed to configure resolutions from fallback path after parse error");
                     return configResult;
@@ -276,27 +259,165 @@ namespace WPEFramework
                 LOGINFO("Using default country code from config: %s", country.c_str());
             }
 
-            // Get paths for the country
-            std::vector<std::string> configPaths = regionalConfig.GetPathsForCountry(country);
+            return CompileRegionalResolvers(regionalConfig, country);
+        }
 
-            if (configPaths.empty()) {
-                LOGERR("No configuration paths found for country '%s' and no fallback available", country.c_str());
+        uint32_t AppGatewayImplementation::CompileRegionalResolvers(const RegionalResolutionConfig& regionalConfig, const std::string& country) {
+            // Every region is compiled now, so a territory change only swaps tables.
+            // Regions listing the same paths share a table; a country listed twice keeps
+            // its first region.
+            std::map<std::vector<std::string>, ResolverPtr> tables;
+            uint32_t regionIndex = 0;
+            auto index = regionalConfig.regions.Elements();
+            while (index.Next()) {
+                const RegionalResolutionConfig::Region& region = index.Current();
+                std::vector<std::string> paths = region.GetPaths();
+                const uint32_t thisRegion = regionIndex++;
+                if (paths.empty()) {
+                    continue;
+                }
+                auto table = tables.find(paths);
+                if (table == tables.end()) {
+                    char snapshotFile[64];
+                    snprintf(snapshotFile, sizeof(snapshotFile), RESOLUTIONS_REGION_SNAPSHOT_FILE, thisRegion);
+                    ResolverPtr resolver;
+                    std::vector<std::string> key(paths);
+                    if (CompileResolver(std::move(paths), snapshotFile, resolver) != Core::ERROR_NONE) {
+                        LOGERR("Failed to configure resolutions of region %u", thisRegion);
+                    }
+                    table = tables.emplace(std::move(key), resolver).first;
+                }
+                if (table->second == nullptr) {
+                    continue;
+                }
+                auto codes = region.countryCodes.Elements();
+                while (codes.Next()) {
+                    mRegionalResolvers.emplace(StringUtils::toLower(codes.Current().Value()), table->second);
+                }
+            }
 
-                // Last resort fallback
-                configPaths = {DEFAULT_CONFIG_PATH};
-                LOGWARN("Using last resort fallback: %s", DEFAULT_CONFIG_PATH);
+            // Countries without a region use the default country's table, then the base file
+            if (regionalConfig.defaultCountryCode.IsSet()) {
+                auto table = mRegionalResolvers.find(StringUtils::toLower(regionalConfig.defaultCountryCode.Value()));
+                if (table != mRegionalResolvers.end()) {
+                    mFallbackResolver = table->second;
+                }
+            }
+            if (mFallbackResolver == nullptr) {
+                if (CompileResolver({ DEFAULT_CONFIG_PATH }, RESOLUTIONS_SNAPSHOT_FILE, mFallbackResolver) != Core::ERROR_NONE) {
+                    LOGERR("Failed to configure resolutions from last resort fallback: %s", DEFAULT_CONFIG_PATH);
+                }
             }
 
-            LOGINFO("Loading %zu configuration paths for country '%s'", configPaths.size(), country.c_str());
-            Core::hresult configResult = InternalResolutionConfigure(std::move(configPaths));
-            if (configResult != Core::ERROR_NONE) {
+            SelectCountry(country);
+            const ResolverPtr active = ActiveResolver();
+            if ((active == nullptr) || !active->IsConfigured()) {
                 LOGERR("Failed to configure resolutions from country-specific paths");
-                return configResult;
+                return Core::ERROR_GENERAL;
             }
-
+            LOGINFO("Compiled %zu resolution tables for %zu countries", mResolvers.size(), mRegionalResolvers.size());
             return Core::ERROR_NONE;
         }
 
+        Core::hresult AppGatewayImplementation::CompileResolver(std::vector<std::string>&& configPaths, const char* snapshotFile, ResolverPtr& resolver) {
+            try {
+                resolver = std::make_shared<Resolver>(mService);
+            } catch (const std::bad_alloc& e) {
+                LOGERR("Failed to create Resolver instance: %s", e.what());
+                return Core::ERROR_GENERAL;
+            }
+            // Each table holds (and releases) a reference to the shell
+            if (mService != nullptr) {
+                mService->AddRef();
+            }
+            // Kept even if nothing loads, so Configure(paths) can still fill it
+            mResolvers.push_back(resolver);
+
+            LOGINFO("Loading %zu configuration paths", configPaths.size());
+            return WarmResolutionConfigure(*resolver, std::move(configPaths), snapshotFile);
+        }
+
+        ResolverPtr AppGatewayImplementation::ActiveResolver() const {
+            return std::atomic_load(&mResolverPtr);
+        }
+
+        void AppGatewayImplementation::SelectCountry(const std::string& country) {
+            ResolverPtr table = mFallbackResolver;
+            auto entry = mRegionalResolvers.find(StringUtils::toLower(country));
+            if (entry != mRegionalResolvers.end()) {
+                table = entry->second;
+            }
+            if (table == nullptr) {
+                return;
+            }
+            Core::SafeSyncType<Core::CriticalSection> lock(mTerritoryLock);
+            if (std::atomic_load(&mResolverPtr) != table) {
+                std::atomic_store(&mResolverPtr, table);
+                LOGINFO("Resolutions switched to country '%s'%s", country.c_str(),
+                        (entry == mRegionalResolvers.end() ? " (fallback table)" : ""));
+            }
+        }
+
+        // Thunder territories are ISO 3166 alpha-3, Firebolt country codes alpha-2
+        static std::string TerritoryToCountry(const std::string& territory) {
+            std::string country;
+            if (!Utils::Iso3166::Alpha3ToAlpha2(territory, country)) {
+                LOGWARN("Territory '%s' has no ISO 3166 country code, looked up as is", territory.c_str());
+                return StringUtils::toLower(territory);
+            }
+            return country;
+        }
+
+        void AppGatewayImplementation::ApplyTerritory(const std::string& territory) {
+            if (territory.empty()) {
+                return;
+            }
+            // Regions may list either form of the code
+            if (mRegionalResolvers.find(StringUtils::toLower(territory)) != mRegionalResolvers.end()) {
+                SelectCountry(territory);
+            } else {
+                SelectCountry(TerritoryToCountry(territory));
+            }
+        }
+
+        void AppGatewayImplementation::SubscribeTerritory() {
+            auto link = ::Utils::getThunderControllerClient(SYSTEM_CALLSIGN, APP_GATEWAY_CALLSIGN);
+            if (!link) {
+                LOGERR("Failed to create link to %s, resolutions stay on the start-up country", SYSTEM_CALLSIGN);
+                return;
+            }
+            const uint32_t status = link->Subscribe<Core::JSON::VariantContainer>(
+                APPGATEWAY_TERRITORY_TIMEOUT_MS, _T("onTerritoryChanged"), &AppGatewayImplementation::OnTerritoryChanged, this);
+            if (status != Core::ERROR_NONE) {
+                LOGERR("Failed to subscribe to %s.onTerritoryChanged rc=%u, resolutions stay on the start-up country", SYSTEM_CALLSIGN, status);
+                return;
+            }
+            {
+                Core::SafeSyncType<Core::CriticalSection> lock(mTerritoryLock);
+                mTerritoryLink = link;
+            }
+            LOGINFO("Subscribed to %s.onTerritoryChanged", SYSTEM_CALLSIGN);
+
+            // Catch up with a territory set before the subscription
+            auto direct = Utils::GetThunderControllerClient(mService, SYSTEM_CALLSIGN);
+            if (direct) {
+                Core::JSON::VariantContainer params;
+                Core::JSON::VariantContainer response;
+                if ((direct->Invoke<decltype(params), decltype(response)>("getTerritory", params, response) == Core::ERROR_NONE)
+                    && response.HasLabel(_T("territory"))) {
+                    ApplyTerritory(response[_T("territory")].String());
+                }
+            }
+        }
+
+        void AppGatewayImplementation::OnTerritoryChanged(const Core::JSON::VariantContainer& params) {
+            if (!params.HasLabel(_T("newTerritory"))) {
+                LOGERR("onTerritoryChanged without newTerritory");
+                return;
+            }
+            ApplyTerritory(params[_T("newTerritory")].String());
+        }
+
         Core::hresult AppGatewayImplementation::Configure(Exchange::IAppGatewayResolver::IStringIterator *const &paths)
         {
             LOGINFO("Call AppGatewayImplementation::Configure");
@@ -307,7 +428,7 @@ namespace WPEFramework
                 return Core::ERROR_BAD_REQUEST;
             }
 
-            if (mResolverPtr == nullptr)
+            if (ActiveResolver() == nullptr)
             {
                 LOGERR("Resolver not initialized");
                 return Core::ERROR_GENERAL;
@@ -333,11 +454,19 @@ namespace WPEFramework
             }
 
             LOGINFO("Processing %zu configuration paths in override order", configPaths.size());
-            return InternalResolutionConfigure(std::move(configPaths));
-            
+            // Overrides apply to every regional table, so a territory change keeps them
+            Core::hresult result = Core::ERROR_NONE;
+            for (const ResolverPtr& resolver : mResolvers) {
+                const Core::hresult tableResult = InternalResolutionConfigure(*resolver, configPaths);
+                if (tableResult != Core::ERROR_NONE) {
+                    result = tableResult;
+                }
+            }
+            return result;
+
         }
 
-        Core::hresult AppGatewayImplementation::InternalResolutionConfigure(std::vector<std::string>&& configPaths){
+        Core::hresult AppGatewayImplementation::InternalResolutionConfigure(Resolver &resolver, const std::vector<std::string>& configPaths){
             // Process all paths in order - later paths override earlier ones
             bool anyConfigLoaded = false;
             for (size_t i = 0; i < configPaths.size(); i++)
@@ -345,7 +474,7 @@ namespace WPEFramework
                 const std::string &configPath = configPaths[i];
                 LOGINFO("Processing config path %zu/%zu: %s", i + 1, configPaths.size(), configPath.c_str());
 
-                if (mResolverPtr->LoadConfig(configPath))
+                if (resolver.LoadConfig(configPath))
                 {
                     LOGINFO("Successfully loaded configuration from: %s", configPath.c_str());
                     anyConfigLoaded = true;
@@ -368,9 +497,45 @@ namespace WPEFramework
 
         }
 
+        Core::hresult AppGatewayImplementation::WarmResolutionConfigure(Resolver &resolver, std::vector<std::string>&& configPaths, const char* snapshotFile)
+        {
+            std::string snapshotPath = mService->PersistentPath();
+            if (snapshotPath.empty() || resolver.IsConfigured())
+            {
+                return InternalResolutionConfigure(resolver, configPaths);
+            }
+            if (snapshotPath.back() != '/')
+            {
+                snapshotPath += '/';
+            }
+            Core::Directory(snapshotPath.c_str()).CreatePath();
+            snapshotPath += snapshotFile;
+
+            // Hashing the sources is far cheaper than parsing them, and any edit,
+            // replacement or removal of a config file forces a cold load
+            const uint64_t fingerprint = Utils::WarmSnapshot::Fingerprint(configPaths);
+            if (resolver.LoadSnapshot(snapshotPath, fingerprint))
+            {
+                return Core::ERROR_NONE;
+            }
+
+            Core::hresult result = InternalResolutionConfigure(resolver, configPaths);
+            if (result == Core::ERROR_NONE)
+            {
+                resolver.SaveSnapshot(snapshotPath, fingerprint);
+            }
+            return result;
+        }
+
         Core::hresult AppGatewayImplementation::Resolve(const Context& context, const string& origin, const string& method, const string& params, string& resolution)
         {
             LOGTRACE("method=%s params=%s", method.c_str(), params.c_str());
+            // Transient strings built while resolving are released in one step once the
+            // response has been handed to the responder.
+            Utils::RequestArena::Scope arena;
+            // Requests that did not come through the responder's socket (launch delegate,
+            // out-of-process responder) start their trace here
+            Utils::TraceId::Scope trace(Utils::TraceId::CurrentOrNext());
             return InternalResolve(context, method, params, origin, resolution);
         }
 
@@ -385,9 +550,10 @@ namespace WPEFramework
         }
 
         Core::hresult AppGatewayImplementation::FetchResolvedData(const Context &context, const string &method, const string &params, const string &origin, string& resolution) {
-            JsonObject params_obj;
             Core::hresult result = Core::ERROR_NONE;
-            if (mResolverPtr == nullptr)
+            // One table for the whole request, even if the territory changes meanwhile
+            const ResolverPtr resolver = ActiveResolver();
+            if (resolver == nullptr)
             {
                 LOGERR("Resolver not initialized");
                 ErrorUtils::CustomInitialize("Resolver not initialized", resolution);
@@ -395,24 +561,33 @@ namespace WPEFramework
             }
 
             // Check if resolver has any resolutions loaded
-            if (!mResolverPtr->IsConfigured())
+            if (!resolver->IsConfigured())
             {
                 LOGERR("Resolver not configured - no resolutions loaded. Call Configure() first.");
                 ErrorUtils::CustomInitialize("Resolver not configured", resolution);
                 return Core::ERROR_GENERAL;
             }
             // Resolve the alias from the method
-            std::string alias = mResolverPtr->ResolveAlias(method);
+            std::string alias = resolver->ResolveAlias(method);
 
             if (alias.empty())
             {
-                LOGERR("No alias found for method: %s", method.c_str());
+                LOGERR("No alias found for method: %s trace=%s", method.c_str(), Utils::TraceId::ToString(Utils::TraceId::Current()).c_str());
                 ErrorUtils::NotSupported(resolution);
                 return Core::ERROR_GENERAL;
             }
 
+            // Reject malformed params before any permission check or backend call
+            std::string validationError;
+            if (!resolver->ValidateParams(method, params, validationError))
+            {
+                LOGERR("Invalid params for method %s: %s", method.c_str(), validationError.c_str());
+                ErrorUtils::CustomBadRequest(validationError, resolution);
+                return Core::ERROR_BAD_REQUEST;
+            }
+
             std::string permissionGroup;
-            if (mResolverPtr->HasPermissionGroup(method, permissionGroup)) {
+            if (resolver->HasPermissionGroup(method, permissionGroup)) {
                 LOGTRACE("Method '%s' requires permission group '%s'", method.c_str(), permissionGroup.c_str());
                 if (nullptr != GetAppGatewayAuthenticatorInterface()) {
                     bool allowed = false;
@@ -432,16 +607,17 @@ namespace WPEFramework
             }
             LOGTRACE("Resolved method '%s' to alias '%s'", method.c_str(), alias.c_str());            
             // Check if the given method is an event
-            if (mResolverPtr->HasEvent(method)) {
-                result = PreProcessEvent(context, alias, method, origin, params, resolution);
-            } else if(mResolverPtr->HasComRpcRequestSupport(method)) {
-                result = ProcessComRpcRequest(context, alias, method, params, origin, resolution);
+            if (resolver->HasEvent(method)) {
+                result = PreProcessEvent(*resolver, context, alias, method, origin, params, resolution);
+            } else if(resolver->HasComRpcRequestSupport(method)) {
+                result = ProcessComRpcRequest(*resolver, context, alias, method, params, origin, resolution);
             } else {
                 // Check if includeContext is enabled for this method
-                std::string finalParams = UpdateContext(context, method, params, origin);
+                std::string& finalParams = Utils::RequestArena::Current().String();
+                UpdateContext(*resolver, context, method, params, origin, false, finalParams);
                 LOGTRACE("Final Request params alias=%s Params = %s", alias.c_str(), finalParams.c_str());
 
-                result = mResolverPtr->CallThunderPlugin(alias, finalParams, resolution);
+                result = resolver->CallThunderPlugin(alias, finalParams, resolution);
                 if (result != Core::ERROR_NONE) {
                     LOGERR("Failed to retrieve resolution from Thunder method %s", alias.c_str());
                     ErrorUtils::CustomInternal("Failed with internal error", resolution);
@@ -455,10 +631,20 @@ namespace WPEFramework
         }
 
         string AppGatewayImplementation::UpdateContext(const Context &context, const string& method, const string& params, const string& origin, const bool& onlyAdditionalContext) {
+            std::string finalParams;
+            const ResolverPtr resolver = ActiveResolver();
+            if (resolver == nullptr) {
+                return params;
+            }
+            UpdateContext(*resolver, context, method, params, origin, onlyAdditionalContext, finalParams);
+            return finalParams;
+        }
+
+        void AppGatewayImplementation::UpdateContext(Resolver &resolver, const Context &context, const string& method, const string& params, const string& origin, const bool onlyAdditionalContext, string& finalParams) {
             // Check if includeContext is enabled for this method
-            std::string finalParams = params;
+            finalParams = params;
             JsonValue additionalContext;
-            if (mResolverPtr->HasIncludeContext(method, additionalContext)) {
+            if (resolver.HasIncludeContext(method, additionalContext)) {
                 LOGTRACE("Method '%s' requires context inclusion", method.c_str());
                 JsonObject paramsObj;
                 if (!paramsObj.FromString(params))
@@ -470,6 +656,9 @@ namespace WPEFramework
                     if (additionalContext.Content() == WPEFramework::Core::JSON::Variant::type::OBJECT) {
                         JsonObject contextWithOrigin = additionalContext.Object();
                         contextWithOrigin["origin"] = origin;
+                        if (Utils::TraceId::Current() != 0) {
+                            contextWithOrigin["traceId"] = Utils::TraceId::ToString(Utils::TraceId::Current());
+                        }
                         JsonObject finalParamsObject;
                         finalParamsObject["params"] = paramsObj;
                         finalParamsObject["_additionalContext"] = contextWithOrigin;
@@ -482,18 +671,21 @@ namespace WPEFramework
                     contextObj["appId"] = context.appId;
                     contextObj["connectionId"] = context.connectionId;
                     contextObj["requestId"] = context.requestId;
+                    if (Utils::TraceId::Current() != 0) {
+                        contextObj["traceId"] = Utils::TraceId::ToString(Utils::TraceId::Current());
+                    }
                     paramsObj["context"] = contextObj;
                     paramsObj.ToString(finalParams);
                 }                
             }
-            return finalParams;
         }
 
-        uint32_t AppGatewayImplementation::ProcessComRpcRequest(const Context &context, const string& alias, const string& method, const string& params, const string& origin, string &resolution) {
+        uint32_t AppGatewayImplementation::ProcessComRpcRequest(Resolver &resolver, const Context &context, const string& alias, const string& method, const string& params, const string& origin, string &resolution) {
             uint32_t result = Core::ERROR_GENERAL;
             Exchange::IAppGatewayRequestHandler *requestHandler = mService->QueryInterfaceByCallsign<Exchange::IAppGatewayRequestHandler>(alias);
             if (requestHandler != nullptr) {
-                std::string finalParams = UpdateContext(context, method, params, origin, true);
+                std::string& finalParams = Utils::RequestArena::Current().String();
+                UpdateContext(resolver, context, method, params, origin, true, finalParams);
 
                 if (Core::ERROR_NONE != requestHandler->HandleAppGatewayRequest(context, method, finalParams, resolution)) {
                     LOGERR("HandleAppGatewayRequest failed for callsign: %s", alias.c_str());
@@ -517,7 +709,7 @@ namespace WPEFramework
         }
         
 
-        uint32_t AppGatewayImplementation::PreProcessEvent(const Context &context, const string& alias, const string &method, const string& origin, const string& params,
+        uint32_t AppGatewayImplementation::PreProcessEvent(Resolver &resolver, const Context &context, const string& alias, const string &method, const string& origin, const string& params,
         string &resolution) {
             JsonObject params_obj;
             if (params_obj.FromString(params)) {
@@ -525,12 +717,13 @@ namespace WPEFramework
                     // Use ObjectUtils::HasBooleanEntry and populate resultValue
                     if (ObjectUtils::HasBooleanEntry(params_obj, "listen", resultValue)) {
                         LOGTRACE("Event method '%s' with listen: %s", method.c_str(), resultValue ? "true" : "false");
-                        string eventName = method;
-                        if (mResolverPtr->IsVersionedEvent(method)) {
-                            eventName = ContextUtils::GetEventNameFromContextBasedonVersion(context.version, method);
-                        }
-                        
+                        const string eventName = resolver.ResolveEventName(method, context.version);
                         auto ret_value = HandleEvent(context, alias, eventName, origin, resultValue);
+                        if (Core::ERROR_INVALID_RANGE == ret_value) {
+                            LOGERR("Subscription limit reached for connection %d, event '%s' rejected", context.connectionId, method.c_str());
+                            ErrorUtils::CustomBadRequest("Subscription limit reached for this connection", resolution);
+                            return ret_value;
+                        }
                         JsonObject returnResult;
                         returnResult["listening"] = resultValue;
                         returnResult["event"] = method;
@@ -25,14 +25,19 @@
 #include <interfaces/IConfiguration.h>
 #include <interfaces/IAppNotifications.h>
 #include "ContextUtils.h"
+#include "UtilsJobPool.h"
+#include "UtilsTraceId.h"
 #include <com/com.h>
 #include <core/core.h>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 
 namespace WPEFramework {
 namespace Plugin {
     using Context = Exchange::GatewayContext;
+    class RegionalResolutionConfig;
     class AppGatewayImplementation : public Exchange::IAppGatewayResolver, public Exchange::IConfiguration
     {
 
@@ -60,47 +65,101 @@ namespace Plugin {
 
         class EXTERNAL RespondJob : public Core::IDispatch
         {
-        protected:
-            RespondJob(AppGatewayImplementation *parent, 
-            const Context& context,
-            const std::string& payload,
-            const std::string& destination
-            )
-                : mParent(*parent), mPayload(payload), mContext(context), mDestination(destination)
+        public:
+            RespondJob()
+                : mParent(nullptr), mPayload(), mContext(), mDestination(), mTraceId(0)
             {
-                mParent.AddRef();
             }
-
-        public:
-            RespondJob() = delete;
-        RespondJob(const RespondJob &) = delete;
+            RespondJob(const RespondJob &) = delete;
             RespondJob &operator=(const RespondJob &) = delete;
             ~RespondJob()
             {
-                mParent.Release();
+                Clear();
             }
 
         public:
             static Core::ProxyType<Core::IDispatch> Create(AppGatewayImplementation *parent,
                 const Context& context, const std::string& payload, const std::string& origin)
             {
-                return (Core::ProxyType<Core::IDispatch>(Core::ProxyType<RespondJob>::Create(parent, context, payload, origin)));
+                Core::ProxyType<RespondJob> job = Utils::JobPool<RespondJob>::Element();
+                job->Set(parent, context, payload, origin, Utils::TraceId::Current());
+                return (Core::ProxyType<Core::IDispatch>(job));
             }
             virtual void Dispatch()
             {
+                Utils::TraceId::Scope trace(mTraceId);
                 if(ContextUtils::IsOriginGateway(mDestination)) {
-                    mParent.ReturnMessageInSocket(mContext, std::move(mPayload));
+                    mParent->ReturnMessageInSocket(mContext, std::move(mPayload));
                 } else {
-                    mParent.SendToLaunchDelegate(mContext, std::move(mPayload));
+                    mParent->SendToLaunchDelegate(mContext, std::move(mPayload));
                 }
                 
             }
+            // Invoked by the job pool on recycle
+            void Clear()
+            {
+                if (mParent != nullptr) {
+                    mParent->Release();
+                    mParent = nullptr;
+                }
+                mPayload.clear();
+                mContext.appId.clear();
+                mContext.version.clear();
+                mDestination.clear();
+            }
+
+        private:
+            void Set(AppGatewayImplementation *parent, const Context& context,
+                const std::string& payload, const std::string& destination, const uint64_t traceId)
+            {
+                mParent = parent;
+                mParent->AddRef();
+                mPayload = payload;
+                mContext = context;
+                mDestination = destination;
+                mTraceId = traceId;
+            }
+
+            AppGatewayImplementation *mParent;
+            std::string mPayload;
+            Context mContext;
+            std::string mDestination;
+            uint64_t mTraceId;
+        };
+
+        // Subscribes to territory changes off the Configure() path; the System plugin
+        // may still be starting
+        class EXTERNAL TerritoryJob : public Core::IDispatch
+        {
+        protected:
+            TerritoryJob(AppGatewayImplementation *parent)
+                : mParent(parent)
+            {
+                mParent->AddRef();
+            }
+
+        public:
+            TerritoryJob() = delete;
+            TerritoryJob(const TerritoryJob &) = delete;
+            TerritoryJob &operator=(const TerritoryJob &) = delete;
+            ~TerritoryJob()
+            {
+                mParent->Release();
+            }
+
+        public:
+            // Runs once per Configure(), so it is not worth a pooled element
+            static Core::ProxyType<Core::IDispatch> Create(AppGatewayImplementation *parent)
+            {
+                return (Core::ProxyType<Core::IDispatch>(Core::ProxyType<TerritoryJob>::Create(parent)));
+            }
+            virtual void Dispatch()
+            {
+                mParent->SubscribeTerritory();
+            }
 
         private:
-            AppGatewayImplementation &mParent;
-            const std::string mPayload;
-            const Context mContext;
-            const std::string mDestination;
+            AppGatewayImplementation *mParent;
         };
 
         Core::hresult HandleEvent(const Context &context, const string &alias, const string &event, const string &origin,  const bool listen);
@@ -122,7 +181,16 @@ namespace Plugin {
         }
 
         PluginHost::IShell* mService;
+        // Table of the current country; swapped with std::atomic_store, so readers take
+        // one copy per request through ActiveResolver()
         ResolverPtr mResolverPtr;
+        // Tables compiled per region at start-up: every distinct table, the table of
+        // each lower case country code, and the one for countries not listed
+        std::vector<ResolverPtr> mResolvers;
+        std::unordered_map<std::string, ResolverPtr> mRegionalResolvers;
+        ResolverPtr mFallbackResolver;
+        mutable Core::CriticalSection mTerritoryLock;
+        std::shared_ptr<JSONRPC::LinkType<Core::JSON::IElement>> mTerritoryLink;
         mutable Core::CriticalSection mAppNotificationsLock;
         mutable Core::CriticalSection mAppGatewayResponderLock;
         mutable Core::CriticalSection mInternalGatewayResponderLock;
@@ -133,12 +201,26 @@ namespace Plugin {
         Exchange::IAppGatewayAuthenticator *mAuthenticator; // Shared pointer to Authenticator
         uint32_t InitializeResolver();
         uint32_t InitializeWebsocket();
-        uint32_t ProcessComRpcRequest(const Context &context, const string& alias, const string& method, const string& params, const string& origin, string &resolution);
-        uint32_t PreProcessEvent(const Context &context, const string& alias, const string &method, const string& origin, const string& params, string &resolution);
+        uint32_t ProcessComRpcRequest(Resolver &resolver, const Context &context, const string& alias, const string& method, const string& params, const string& origin, string &resolution);
+        uint32_t PreProcessEvent(Resolver &resolver, const Context &context, const string& alias, const string &method, const string& origin, const string& params, string &resolution);
         string UpdateContext(const Context &context, const string& method, const string& params, const string& origin, const bool& onlyAdditionalContext = false);
+        // Writes into a caller-provided buffer, typically a request arena slot
+        void UpdateContext(Resolver &resolver, const Context &context, const string& method, const string& params, const string& origin, const bool onlyAdditionalContext, string& finalParams);
         Core::hresult InternalResolve(const Context &context, const string &method, const string &params, const string &origin, string& resolution);
         Core::hresult FetchResolvedData(const Context &context, const string &method, const string &params, const string &origin, string& resolution);
-        Core::hresult InternalResolutionConfigure(std::vector<std::string>&& configPaths);
+        Core::hresult InternalResolutionConfigure(Resolver &resolver, const std::vector<std::string>& configPaths);
+        // Start-up variant: restores the tables from the warm snapshot when it matches the sources
+        Core::hresult WarmResolutionConfigure(Resolver &resolver, std::vector<std::string>&& configPaths, const char* snapshotFile);
+        // Adds a table loaded from configPaths (or its snapshot) to mResolvers
+        Core::hresult CompileResolver(std::vector<std::string>&& configPaths, const char* snapshotFile, ResolverPtr& resolver);
+        // Compiles one table per distinct set of region paths and indexes them by country
+        uint32_t CompileRegionalResolvers(const RegionalResolutionConfig& regionalConfig, const std::string& country);
+        ResolverPtr ActiveResolver() const;
+        // Makes the table of the given country (or the fallback table) the active one
+        void SelectCountry(const std::string& country);
+        void SubscribeTerritory();
+        void OnTerritoryChanged(const Core::JSON::VariantContainer& params);
+        void ApplyTerritory(const std::string& territory);
         Exchange::IAppGatewayAuthenticator* GetAppGatewayAuthenticatorInterface();
         void SendToLaunchDelegate(const Context& context, const string& payload);
         std::string ReadCountryFromConfigFile();
@@ -25,6 +25,7 @@
 #include "UtilsLogging.h"
 #include "UtilsConnections.h"
 #include "UtilsCallsign.h"
+#include "UtilsFirebolt.h"
 #include <interfaces/IAppNotifications.h>
 
 // App Gateway is only available via local connections,
@@ -32,6 +33,18 @@
 #define APPGATEWAY_SOCKET_ADDRESS "127.0.0.1:3473"
 #define DEFAULT_CONFIG_PATH "/etc/app-gateway/resolution.base.json"
 
+// Gateway-to-app requests that are not answered within this time fail with a timeout error
+#ifndef APPGATEWAY_REQUEST_TIMEOUT_MS
+#define APPGATEWAY_REQUEST_TIMEOUT_MS 10000
+#endif
+// Apps turned away while draining are told to reconnect after this many seconds
+#ifndef APPGATEWAY_DRAIN_RETRY_AFTER_S
+#define APPGATEWAY_DRAIN_RETRY_AFTER_S 2
+#endif
+// Timer wheel resolution and size; longer timeouts take additional revolutions
+#define PENDING_REQUEST_TICK_MS 100
+#define PENDING_REQUEST_WHEEL_SLOTS 128
+
 namespace WPEFramework
 {
     namespace Plugin
@@ -44,7 +57,14 @@ namespace WPEFramework
             mAuthenticator(nullptr),
             mResolver(nullptr),
             mConnectionStatusImplLock(),
-            mEnhancedLoggingEnabled(false)
+            mEnhancedLoggingEnabled(false),
+            mPendingRequests(PENDING_REQUEST_TICK_MS, PENDING_REQUEST_WHEEL_SLOTS),
+            mPendingRequestTimerLock(),
+            mPendingRequestTimer(1024 * 64, _T("AppGwRequestTimer")),
+            mPendingRequestTimerArmed(false),
+            mEventRingLock(),
+            mEventRing(),
+            mEventRingScheduled(false)
         {
             LOGINFO("AppGatewayResponderImplementation constructor");
 #ifdef ENABLE_APP_GATEWAY_AUTOMATION
@@ -64,7 +84,10 @@ namespace WPEFramework
             mWsManager.SetMessageHandler(nullptr);
             mWsManager.SetAuthHandler(nullptr);
             mWsManager.SetDisconnectHandler(nullptr);
+            mWsManager.SetResponseHandler(nullptr);
             // Note: WebSocketConnectionManager destructor will handle channel cleanup
+
+            mPendingRequestTimer.Revoke(PendingRequestTimer(this));
             
             if (nullptr != mService)
             {
@@ -116,7 +139,14 @@ namespace WPEFramework
             mWsManager.SetMessageHandler(
                 [this](const std::string &method, const std::string &params, const int requestId, const uint32_t connectionId)
                 {
-                    Core::IWorkerPool::Instance().Submit(WsMsgJob::Create(this, method, params, requestId, connectionId));
+                    if (!mDrain.Accept(connectionId, requestId)) {
+                        string error;
+                        ErrorUtils::CustomConnectionClosed("Gateway is restarting, retry after " + std::to_string(APPGATEWAY_DRAIN_RETRY_AFTER_S) + " s", error);
+                        mWsManager.SendMessageToConnection(connectionId, error, requestId);
+                        return;
+                    }
+                    // The trace ID is assigned at frame receipt and follows the request through every hop
+                    Core::IWorkerPool::Instance().Submit(WsMsgJob::Create(this, method, params, requestId, connectionId, Utils::TraceId::Next()));
                 });
 
             mWsManager.SetAuthHandler(
@@ -180,6 +210,12 @@ namespace WPEFramework
                     return false;
                 });
 
+            mWsManager.SetResponseHandler(
+                [this](const uint32_t connectionId, const uint32_t requestId, const std::string &payload, const bool isError) -> bool
+                {
+                    return OnAppResponse(connectionId, requestId, payload, isError);
+                });
+
             mWsManager.SetDisconnectHandler(
                 [this](const uint32_t connectionId)
                 {
@@ -202,6 +238,15 @@ namespace WPEFramework
                     
                     mAppIdRegistry.Remove(connectionId);
                     mCompliantJsonRpcRegistry.CleanupConnectionId(connectionId);
+                    mDrain.CompleteConnection(connectionId);
+
+                    std::vector<Utils::PendingRequestTable::Entry> abandoned;
+                    mPendingRequests.RemoveConnection(connectionId, abandoned);
+                    if (!abandoned.empty()) {
+                        string error;
+                        ErrorUtils::CustomConnectionClosed("Connection closed before the app responded", error);
+                        CompletePendingRequests(abandoned, Core::ERROR_CONNECTION_CLOSED, error);
+                    }
                     Exchange::IAppNotifications* appNotifications = mService->QueryInterfaceByCallsign<Exchange::IAppNotifications>(APP_NOTIFICATIONS_CALLSIGN);
                     if (appNotifications != nullptr) {
                         if (Core::ERROR_NONE != appNotifications->Cleanup(connectionId, APP_GATEWAY_CALLSIGN)) {
@@ -216,15 +261,51 @@ namespace WPEFramework
             return Core::ERROR_NONE;
         }
 
+        Core::hresult AppGatewayResponderImplementation::Drain(const uint32_t timeoutMs)
+        {
+            const uint64_t start = NowMs();
+            LOGINFO("Draining: %u connections, %u requests and %u queued messages in flight, deadline %u ms",
+                mWsManager.Connections(), mDrain.Requests(), mDrain.Jobs(), timeoutMs);
+
+            // No new connections or requests from here on; apps are told when to come back
+            mDrain.Begin();
+            mWsManager.BeginDrain("retry-after=" + std::to_string(APPGATEWAY_DRAIN_RETRY_AFTER_S));
+
+            // Let in-flight resolutions finish and their responses, and pending emits, be sent
+            const bool settled = mDrain.Wait(timeoutMs);
+            const uint32_t requests = mDrain.Requests();
+            const uint32_t messages = mDrain.Jobs();
+            const size_t appRequests = mPendingRequests.Size();
+
+            // Close frames go out after whatever is still queued; requests the apps have
+            // not answered fail with connection closed as the connections go down
+            const uint64_t elapsed = NowMs() - start;
+            const uint32_t open = mWsManager.CloseAll(elapsed < timeoutMs ? static_cast<uint32_t>(timeoutMs - elapsed) : 0);
+
+            const uint64_t total = NowMs() - start;
+            if (settled && (open == 0)) {
+                LOGINFO("Drained in %llu ms", static_cast<unsigned long long>(total));
+                return Core::ERROR_NONE;
+            }
+            LOGWARN("Drain cut off after %llu ms: %u requests unresolved, %u messages unsent, %zu app requests unanswered, %u connections still open",
+                static_cast<unsigned long long>(total), requests, messages, appRequests, open);
+            return Core::ERROR_TIMEDOUT;
+        }
+
         Core::hresult AppGatewayResponderImplementation::Respond(const Context& context, const string& payload)
         {
+            mDrain.AddJob();
             Core::IWorkerPool::Instance().Submit(RespondJob::Create(this, context.connectionId, context.requestId, payload));
             return Core::ERROR_NONE;
         }
 
         Core::hresult AppGatewayResponderImplementation::Emit(const Context& context /* @in */, 
                 const string& method /* @in */, const string& payload /* @in @opaque */) {
+            if (method == APP_GATEWAY_EVENT_RING_DOORBELL) {
+                return OnEventRingDoorbell(payload);
+            }
             // check if the connection is compliant with JSON RPC
+            mDrain.AddJob();
             if (mCompliantJsonRpcRegistry.IsCompliantJsonRpc(context.connectionId)) {
                 Core::IWorkerPool::Instance().Submit(EmitJob::Create(this, context.connectionId, method, payload));
             }
@@ -234,12 +315,144 @@ namespace WPEFramework
             return Core::ERROR_NONE;
         }
 
+        Core::hresult AppGatewayResponderImplementation::OnEventRingDoorbell(const string& payload) {
+            string name;
+            uint64_t key = 0;
+            if (!Utils::SharedEventRing::ParseDoorbellPayload(payload, name, key)
+                || (name.compare(0, sizeof(APP_GATEWAY_EVENT_RING_PREFIX) - 1, APP_GATEWAY_EVENT_RING_PREFIX) != 0)) {
+                LOGERR("Event ring doorbell with an invalid payload: %s", payload.c_str());
+                return Core::ERROR_BAD_REQUEST;
+            }
+
+            {
+                // A different name means the producer started over with a new ring. Only
+                // the producer knows the key: a doorbell without it is turned away, and
+                // leaves the ring attached so far alone.
+                Core::SafeSyncType<Core::CriticalSection> lock(mEventRingLock);
+                if (!mEventRing.IsOpen() || (mEventRing.Name() != name)) {
+                    if (!mEventRing.Attach(name, key)) {
+                        LOGERR("Could not attach to event ring %s", name.c_str());
+                        return Core::ERROR_UNAVAILABLE;
+                    }
+                    LOGINFO("Attached to event ring %s (%u bytes)", name.c_str(), mEventRing.Capacity());
+                } else if (mEventRing.Key() != key) {
+                    LOGERR("Event ring doorbell for %s with the wrong key", name.c_str());
+                    return Core::ERROR_PRIVILIGED_REQUEST;
+                }
+            }
+
+            if (!mEventRingScheduled.exchange(true)) {
+                mDrain.AddJob();
+                Core::IWorkerPool::Instance().Submit(EventRingJob::Create(this));
+            }
+            return Core::ERROR_NONE;
+        }
+
+        void AppGatewayResponderImplementation::DrainEventRing() {
+            // Cleared first: a doorbell that arrives while draining schedules another pass
+            mEventRingScheduled = false;
+
+            Core::SafeSyncType<Core::CriticalSection> lock(mEventRingLock);
+            uint32_t corrupt = 0;
+            mEventRing.Drain([this](const Utils::SharedEventRing::Frame& frame) {
+                // Same routing as Emit(), without a job per event
+                if (mCompliantJsonRpcRegistry.IsCompliantJsonRpc(frame.connectionId)) {
+                    mWsManager.DispatchNotificationToConnection(frame.connectionId, frame.method, frame.payload);
+                } else {
+                    ReturnMessageInSocket(frame.connectionId, static_cast<int>(frame.requestId), frame.payload);
+                }
+            }, corrupt);
+            if (corrupt != 0) {
+                LOGERR("Dropped corrupt contents of event ring %s", mEventRing.Name().c_str());
+            }
+        }
+
         Core::hresult AppGatewayResponderImplementation::Request(const uint32_t connectionId /* @in */, 
                 const uint32_t id /* @in */, const string& method /* @in */, const string& params /* @in @opaque */) {
+            // COM-RPC callers have no completion channel; outcomes other than a response are
+            // logged and counted so that unanswered requests do not linger in the table.
+            return Request(connectionId, id, method, params, APPGATEWAY_REQUEST_TIMEOUT_MS,
+                [this](const Utils::PendingRequestTable::Entry& entry, const Core::hresult result, const string& payload) {
+                    if (Core::ERROR_NONE != result) {
+                        LOGERR("Request %u '%s' on connection %u failed: %u",
+                            entry.requestId, entry.method.c_str(), entry.connectionId, result);
+                        string appId;
+                        if (!mAppIdRegistry.Get(entry.connectionId, appId)) {
+                            appId = "UNKNOWN";
+                        }
+                        Exchange::GatewayContext context = {entry.requestId, entry.connectionId, appId};
+                        AppGatewayTelemetry::getInstance().RecordApiError(context, entry.method);
+                    }
+                });
+        }
+
+        Core::hresult AppGatewayResponderImplementation::Request(const uint32_t connectionId, const uint32_t id,
+                const string& method, const string& params, const uint32_t timeoutMs,
+                const Utils::PendingRequestTable::Callback& callback) {
+            Core::hresult result = mPendingRequests.Add(connectionId, id, method, timeoutMs, NowMs(), callback);
+            if (Core::ERROR_NONE != result) {
+                LOGERR("Request %u is already outstanding on connection %u", id, connectionId);
+                return result;
+            }
+
+            {
+                Core::SafeSyncType<Core::CriticalSection> lock(mPendingRequestTimerLock);
+                if (!mPendingRequestTimerArmed) {
+                    mPendingRequestTimerArmed = true;
+                    mPendingRequestTimer.Schedule(Core::Time::Now().Add(PENDING_REQUEST_TICK_MS), PendingRequestTimer(this));
+                }
+            }
+
+            mDrain.AddJob();
             Core::IWorkerPool::Instance().Submit(RequestJob::Create(this, connectionId, id, method, params));
             return Core::ERROR_NONE;
         }
 
+        bool AppGatewayResponderImplementation::OnAppResponse(const uint32_t connectionId, const uint32_t requestId,
+                const string& payload, const bool isError) {
+            Utils::PendingRequestTable::Entry entry;
+            if (!mPendingRequests.Complete(connectionId, requestId, entry)) {
+                LOGWARN("Unsolicited or late response for request %u on connection %u", requestId, connectionId);
+                return false;
+            }
+            if (entry.callback) {
+                entry.callback(entry, isError ? Core::ERROR_GENERAL : Core::ERROR_NONE, payload);
+            }
+            return true;
+        }
+
+        uint64_t AppGatewayResponderImplementation::OnPendingRequestTimer(const uint64_t scheduledTime) {
+            std::vector<Utils::PendingRequestTable::Entry> expired;
+            mPendingRequests.Expire(NowMs(), expired);
+            if (!expired.empty()) {
+                string error;
+                ErrorUtils::CustomTimeout("App did not respond in time", error);
+                CompletePendingRequests(expired, Core::ERROR_TIMEDOUT, error);
+            }
+
+            // Re-check under the lock so a concurrent Request() either sees the timer
+            // armed or re-arms it itself.
+            Core::SafeSyncType<Core::CriticalSection> lock(mPendingRequestTimerLock);
+            if (mPendingRequests.Size() == 0) {
+                mPendingRequestTimerArmed = false;
+                return 0;
+            }
+            return Core::Time(scheduledTime).Add(PENDING_REQUEST_TICK_MS).Ticks();
+        }
+
+        void AppGatewayResponderImplementation::CompletePendingRequests(std::vector<Utils::PendingRequestTable::Entry>& entries,
+                const Core::hresult result, const string& payload) {
+            for (const auto& entry : entries) {
+                if (entry.callback) {
+                    entry.callback(entry, result, payload);
+                }
+            }
+        }
+
+        uint64_t AppGatewayResponderImplementation::NowMs() {
+            return Core::Time::Now().Ticks() / Core::Time::TicksPerMillisecond;
+        }
+
         Core::hresult AppGatewayResponderImplementation::GetGatewayConnectionContext(const uint32_t connectionId /* @in */,
                 const string& contextKey /* @in */, 
                  string& contextValue /* @out */) {
@@ -294,8 +507,9 @@ namespace WPEFramework
             if (hasAppId) {
 
                 if (mEnhancedLoggingEnabled || !mDebugDisabledConnectionsRegistry.IsDebugDisabled(connectionId)) {
-                    LOGDBG("%s-->[[a-%d-%d]] method=%s, params=%s",
-                           appId.c_str(),connectionId, requestId, method.c_str(), params.c_str());
+                    LOGDBG("%s-->[[a-%d-%d]] trace=%s method=%s, params=%s",
+                           appId.c_str(),connectionId, requestId, Utils::TraceId::ToString(Utils::TraceId::Current()).c_str(),
+                           method.c_str(), params.c_str());
                 }
 
                 if (nullptr == mResolver) {
@@ -305,6 +519,7 @@ namespace WPEFramework
                         // Track failed call
                         AppGatewayTelemetry::getInstance().IncrementFailedCalls(context);
                         AppGatewayTelemetry::getInstance().RecordApiError(context, method);
+                        mDrain.Complete(connectionId, requestId);
                         return;
                     } else {
                         LOGINFO("Resolver interface acquired");
@@ -316,6 +531,7 @@ namespace WPEFramework
                     // Track failed call and specific API error
                     AppGatewayTelemetry::getInstance().IncrementFailedCalls(context);
                     AppGatewayTelemetry::getInstance().RecordApiError(context, method);
+                    mDrain.Complete(connectionId, requestId);
                 } else {
                     // Track successful call
                     // Response will be sent asynchronously, so we will track success/failure when sending the response back to client
@@ -324,6 +540,7 @@ namespace WPEFramework
                 LOGERR("No App ID found for connection %d. Terminate connection", connectionId);
                 // Track failed call due to missing appId
                 AppGatewayTelemetry::getInstance().IncrementFailedCalls(context);
+                mDrain.Complete(connectionId, requestId);
                 mWsManager.Close(connectionId);
             }
         }
@@ -331,8 +548,8 @@ namespace WPEFramework
         void AppGatewayResponderImplementation::ReturnMessageInSocket(const uint32_t connectionId, 
                                                     const int requestId, const string payload ) {
             if (mEnhancedLoggingEnabled || !mDebugDisabledConnectionsRegistry.IsDebugDisabled(connectionId)) {
-                LOGDBG("<--[[a-%d-%d]] payload=%s",
-                        connectionId, requestId, payload.c_str());
+                LOGDBG("<--[[a-%d-%d]] trace=%s payload=%s",
+                        connectionId, requestId, Utils::TraceId::ToString(Utils::TraceId::Current()).c_str(), payload.c_str());
             }
 
             // Get appId for context
@@ -351,6 +568,7 @@ namespace WPEFramework
             
             // Send response back to client
             mWsManager.SendMessageToConnection(connectionId, payload, requestId);
+            mDrain.Complete(connectionId, static_cast<uint32_t>(requestId));
         }
 
         Core::hresult AppGatewayResponderImplementation::Register(Exchange::IAppGatewayResponder::INotification *notification)
@@ -21,9 +21,15 @@
 
 #include "Module.h"
 #include "WsManager.h"
+#include "IAppGatewayDrain.h"
 #include <interfaces/IAppGateway.h>
 #include <interfaces/IConfiguration.h>
 #include "ContextUtils.h"
+#include "UtilsJobPool.h"
+#include "PendingRequestTable.h"
+#include "UtilsTraceId.h"
+#include "UtilsDrainTracker.h"
+#include "UtilsSharedEventRing.h"
 #include <com/com.h>
 #include <core/core.h>
 #include <map>
@@ -35,7 +41,7 @@
 namespace WPEFramework {
 namespace Plugin {
     using Context = Exchange::GatewayContext;
-    class AppGatewayResponderImplementation : public Exchange::IConfiguration, public Exchange::IAppGatewayResponder
+    class AppGatewayResponderImplementation : public Exchange::IConfiguration, public Exchange::IAppGatewayResponder, public IAppGatewayDrain
     {
 
     public:
@@ -49,6 +55,7 @@ namespace Plugin {
         BEGIN_INTERFACE_MAP(AppGatewayResponderImplementation)
         INTERFACE_ENTRY(Exchange::IConfiguration)
         INTERFACE_ENTRY(Exchange::IAppGatewayResponder)
+        INTERFACE_ENTRY(IAppGatewayDrain)
         END_INTERFACE_MAP
 
     public:
@@ -57,6 +64,10 @@ namespace Plugin {
                 const string& method /* @in */, const string& payload /* @in @opaque */) override;
         Core::hresult Request(const uint32_t connectionId /* @in */, 
                 const uint32_t id /* @in */, const string& method /* @in */, const string& params /* @in @opaque */) override;
+        // In-process variant: the callback receives the app's result or error payload,
+        // a timeout error after timeoutMs, or a connection-closed error on disconnect
+        Core::hresult Request(const uint32_t connectionId, const uint32_t id, const string& method, const string& params,
+                const uint32_t timeoutMs, const Utils::PendingRequestTable::Callback& callback);
         Core::hresult GetGatewayConnectionContext(const uint32_t connectionId /* @in */,
                 const string& contextKey /* @in */, 
                  string& contextValue /* @out */) override;
@@ -72,211 +83,338 @@ namespace Plugin {
         // IConfiguration interface
         uint32_t Configure(PluginHost::IShell* service) override;
 
+        // IAppGatewayDrain interface
+        Core::hresult Drain(const uint32_t timeoutMs) override;
+
     private:
         class EXTERNAL WsMsgJob : public Core::IDispatch
         {
-        protected:
-            WsMsgJob(AppGatewayResponderImplementation *parent, 
-            const std::string& method,
-            const std::string& params,
-            const uint32_t requestId,
-            const uint32_t connectionId)
-                : mParent(*parent), mMethod(method), mParams(params), mRequestId(requestId), mConnectionId(connectionId)
+        public:
+            WsMsgJob()
+                : mParent(nullptr), mMethod(), mParams(), mRequestId(0), mConnectionId(0), mTraceId(0)
             {
-                mParent.AddRef();
             }
-
-        public:
-            WsMsgJob() = delete;
             WsMsgJob(const WsMsgJob &) = delete;
             WsMsgJob &operator=(const WsMsgJob &) = delete;
             ~WsMsgJob()
             {
-                mParent.Release();
+                Clear();
             }
 
         public:
             static Core::ProxyType<Core::IDispatch> Create(AppGatewayResponderImplementation *parent,
                 const std::string& method, const std::string& params, const uint32_t requestId,
-                const uint32_t connectionId)
+                const uint32_t connectionId, const uint64_t traceId)
             {
-                return (Core::ProxyType<Core::IDispatch>(Core::ProxyType<WsMsgJob>::Create(parent, method, params, requestId, connectionId)));
+                Core::ProxyType<WsMsgJob> job = Utils::JobPool<WsMsgJob>::Element();
+                job->Set(parent, method, params, requestId, connectionId, traceId);
+                return (Core::ProxyType<Core::IDispatch>(job));
             }
             virtual void Dispatch()
             {
-                mParent.DispatchWsMsg(mMethod, mParams, mRequestId, mConnectionId);
+                Utils::TraceId::Scope trace(mTraceId);
+                mParent->DispatchWsMsg(mMethod, mParams, mRequestId, mConnectionId);
+            }
+            // Invoked by the job pool on recycle
+            void Clear()
+            {
+                if (mParent != nullptr) {
+                    mParent->Release();
+                    mParent = nullptr;
+                }
+                mMethod.clear();
+                mParams.clear();
             }
 
         private:
-            AppGatewayResponderImplementation &mParent;
-            const std::string mMethod;
-            const std::string mParams;
-            const uint32_t mRequestId;
-            const uint32_t mConnectionId;
+            void Set(AppGatewayResponderImplementation *parent, const std::string& method,
+                const std::string& params, const uint32_t requestId, const uint32_t connectionId,
+                const uint64_t traceId)
+            {
+                mParent = parent;
+                mParent->AddRef();
+                mMethod = method;
+                mParams = params;
+                mRequestId = requestId;
+                mConnectionId = connectionId;
+                mTraceId = traceId;
+            }
+
+            AppGatewayResponderImplementation *mParent;
+            std::string mMethod;
+            std::string mParams;
+            uint32_t mRequestId;
+            uint32_t mConnectionId;
+            uint64_t mTraceId;
         };
 
         class EXTERNAL RespondJob : public Core::IDispatch
         {
-        protected:
-            RespondJob(AppGatewayResponderImplementation *parent, 
-            const uint32_t connectionId,
-            const uint32_t requestId,
-            const std::string& payload
-            )
-                : mParent(*parent), mPayload(payload), mRequestId(requestId), mConnectionId(connectionId)
+        public:
+            RespondJob()
+                : mParent(nullptr), mPayload(), mRequestId(0), mConnectionId(0), mTraceId(0)
             {
-                mParent.AddRef();
             }
-
-        public:
-            RespondJob() = delete;
-        RespondJob(const RespondJob &) = delete;
+            RespondJob(const RespondJob &) = delete;
             RespondJob &operator=(const RespondJob &) = delete;
             ~RespondJob()
             {
-                mParent.Release();
+                Clear();
             }
 
         public:
             static Core::ProxyType<Core::IDispatch> Create(AppGatewayResponderImplementation *parent,
                 const uint32_t connectionId, const uint32_t requestId, const std::string& payload)
             {
-                return (Core::ProxyType<Core::IDispatch>(Core::ProxyType<RespondJob>::Create(parent, connectionId, requestId, payload)));
+                Core::ProxyType<RespondJob> job = Utils::JobPool<RespondJob>::Element();
+                job->Set(parent, connectionId, requestId, payload, Utils::TraceId::Current());
+                return (Core::ProxyType<Core::IDispatch>(job));
             }
             virtual void Dispatch()
             {
-                mParent.ReturnMessageInSocket(mConnectionId, mRequestId, mPayload);                
+                Utils::TraceId::Scope trace(mTraceId);
+                mParent->ReturnMessageInSocket(mConnectionId, mRequestId, mPayload);
+                mParent->mDrain.JobDone();
+            }
+            // Invoked by the job pool on recycle
+            void Clear()
+            {
+                if (mParent != nullptr) {
+                    mParent->Release();
+                    mParent = nullptr;
+                }
+                mPayload.clear();
             }
 
         private:
-            AppGatewayResponderImplementation &mParent;
-            const std::string mPayload;
-            const uint32_t mRequestId;
-            const uint32_t mConnectionId;
+            void Set(AppGatewayResponderImplementation *parent, const uint32_t connectionId,
+                const uint32_t requestId, const std::string& payload, const uint64_t traceId)
+            {
+                mParent = parent;
+                mParent->AddRef();
+                mPayload = payload;
+                mRequestId = requestId;
+                mConnectionId = connectionId;
+                mTraceId = traceId;
+            }
+
+            AppGatewayResponderImplementation *mParent;
+            std::string mPayload;
+            uint32_t mRequestId;
+            uint32_t mConnectionId;
+            uint64_t mTraceId;
         };
 
-          class EXTERNAL EmitJob : public Core::IDispatch
+        class EXTERNAL EmitJob : public Core::IDispatch
         {
-        protected:
-            EmitJob(AppGatewayResponderImplementation *parent, 
-            const uint32_t connectionId,
-            const std::string& designator,
-            const std::string& payload
-            )
-                : mParent(*parent), mPayload(payload), mDesignator(designator), mConnectionId(connectionId)
+        public:
+            EmitJob()
+                : mParent(nullptr), mPayload(), mDesignator(), mConnectionId(0)
             {
-                mParent.AddRef();
             }
-
-        public:
-            EmitJob() = delete;
             EmitJob(const EmitJob &) = delete;
             EmitJob &operator=(const EmitJob &) = delete;
             ~EmitJob()
             {
-                mParent.Release();
+                Clear();
             }
 
         public:
             static Core::ProxyType<Core::IDispatch> Create(AppGatewayResponderImplementation *parent,
                 const uint32_t connectionId, const std::string& designator, const std::string& payload)
             {
-                return (Core::ProxyType<Core::IDispatch>(Core::ProxyType<EmitJob>::Create(parent, connectionId, designator, payload)));
+                Core::ProxyType<EmitJob> job = Utils::JobPool<EmitJob>::Element();
+                job->Set(parent, connectionId, designator, payload);
+                return (Core::ProxyType<Core::IDispatch>(job));
             }
             virtual void Dispatch()
             {
-                mParent.mWsManager.DispatchNotificationToConnection(mConnectionId, mDesignator, mPayload);
+                mParent->mWsManager.DispatchNotificationToConnection(mConnectionId, mDesignator, mPayload);
+                mParent->mDrain.JobDone();
+            }
+            // Invoked by the job pool on recycle
+            void Clear()
+            {
+                if (mParent != nullptr) {
+                    mParent->Release();
+                    mParent = nullptr;
+                }
+                mPayload.clear();
+                mDesignator.clear();
             }
 
         private:
-            AppGatewayResponderImplementation &mParent;
-            const std::string mPayload;
-            const std::string mDesignator;
-            const uint32_t mConnectionId;
+            void Set(AppGatewayResponderImplementation *parent, const uint32_t connectionId,
+                const std::string& designator, const std::string& payload)
+            {
+                mParent = parent;
+                mParent->AddRef();
+                mPayload = payload;
+                mDesignator = designator;
+                mConnectionId = connectionId;
+            }
+
+            AppGatewayResponderImplementation *mParent;
+            std::string mPayload;
+            std::string mDesignator;
+            uint32_t mConnectionId;
         };
 
         class EXTERNAL RequestJob : public Core::IDispatch
         {
-        protected:
-            RequestJob(AppGatewayResponderImplementation *parent, 
-            const uint32_t connectionId,
-            const uint32_t requestId,
-            const std::string& designator,
-            const std::string& payload
-            )
-                : mParent(*parent), mPayload(payload), mDesignator(designator), mConnectionId(connectionId), mRequestId(requestId)
+        public:
+            RequestJob()
+                : mParent(nullptr), mPayload(), mDesignator(), mConnectionId(0), mRequestId(0)
             {
-                mParent.AddRef();
             }
-
-        public:
-            RequestJob() = delete;
             RequestJob(const RequestJob &) = delete;
             RequestJob &operator=(const RequestJob &) = delete;
             ~RequestJob()
             {
-                mParent.Release();
+                Clear();
             }
 
         public:
             static Core::ProxyType<Core::IDispatch> Create(AppGatewayResponderImplementation *parent,
                 const uint32_t connectionId, const uint32_t mRequestId, const std::string& designator, const std::string& payload)
             {
-                return (Core::ProxyType<Core::IDispatch>(Core::ProxyType<RequestJob>::Create(parent, connectionId, mRequestId, designator, payload)));
+                Core::ProxyType<RequestJob> job = Utils::JobPool<RequestJob>::Element();
+                job->Set(parent, connectionId, mRequestId, designator, payload);
+                return (Core::ProxyType<Core::IDispatch>(job));
             }
             virtual void Dispatch()
             {
-                mParent.mWsManager.SendRequestToConnection(mConnectionId, mDesignator, mRequestId, mPayload);
+                mParent->mWsManager.SendRequestToConnection(mConnectionId, mDesignator, mRequestId, mPayload);
+                mParent->mDrain.JobDone();
+            }
+            // Invoked by the job pool on recycle
+            void Clear()
+            {
+                if (mParent != nullptr) {
+                    mParent->Release();
+                    mParent = nullptr;
+                }
+                mPayload.clear();
+                mDesignator.clear();
             }
 
         private:
-            AppGatewayResponderImplementation &mParent;
-            const std::string mPayload;
-            const std::string mDesignator;
-            const uint32_t mConnectionId;
-            const uint32_t mRequestId;
+            void Set(AppGatewayResponderImplementation *parent, const uint32_t connectionId,
+                const uint32_t requestId, const std::string& designator, const std::string& payload)
+            {
+                mParent = parent;
+                mParent->AddRef();
+                mPayload = payload;
+                mDesignator = designator;
+                mConnectionId = connectionId;
+                mRequestId = requestId;
+            }
+
+            AppGatewayResponderImplementation *mParent;
+            std::string mPayload;
+            std::string mDesignator;
+            uint32_t mConnectionId;
+            uint32_t mRequestId;
         };
 
-        class EXTERNAL ConnectionStatusNotificationJob : public Core::IDispatch
+        // Delivers the frames of the shared-memory event ring after a doorbell
+        class EXTERNAL EventRingJob : public Core::IDispatch
         {
-        protected:
-            ConnectionStatusNotificationJob(AppGatewayResponderImplementation *parent,
-            const uint32_t connectionId,
-            const std::string& appId,
-            const bool connected
-            )
-                : mParent(*parent), mConnectionId(connectionId), mAppId(appId), mConnected(connected)
+        public:
+            EventRingJob()
+                : mParent(nullptr)
             {
-                mParent.AddRef();
+            }
+            EventRingJob(const EventRingJob &) = delete;
+            EventRingJob &operator=(const EventRingJob &) = delete;
+            ~EventRingJob()
+            {
+                Clear();
             }
 
         public:
-            ConnectionStatusNotificationJob() = delete;
+            static Core::ProxyType<Core::IDispatch> Create(AppGatewayResponderImplementation *parent)
+            {
+                Core::ProxyType<EventRingJob> job = Utils::JobPool<EventRingJob>::Element();
+                job->Set(parent);
+                return (Core::ProxyType<Core::IDispatch>(job));
+            }
+            virtual void Dispatch()
+            {
+                mParent->DrainEventRing();
+                mParent->mDrain.JobDone();
+            }
+            // Invoked by the job pool on recycle
+            void Clear()
+            {
+                if (mParent != nullptr) {
+                    mParent->Release();
+                    mParent = nullptr;
+                }
+            }
+
+        private:
+            void Set(AppGatewayResponderImplementation *parent)
+            {
+                mParent = parent;
+                mParent->AddRef();
+            }
+
+            AppGatewayResponderImplementation *mParent;
+        };
+
+        class EXTERNAL ConnectionStatusNotificationJob : public Core::IDispatch
+        {
+        public:
+            ConnectionStatusNotificationJob()
+                : mParent(nullptr), mConnectionId(0), mAppId(), mConnected(false)
+            {
+            }
             ConnectionStatusNotificationJob(const ConnectionStatusNotificationJob &) = delete;
             ConnectionStatusNotificationJob &operator=(const ConnectionStatusNotificationJob &) = delete;
             ~ConnectionStatusNotificationJob()
             {
-                mParent.Release();
+                Clear();
             }
 
         public:
             static Core::ProxyType<Core::IDispatch> Create(AppGatewayResponderImplementation *parent,
                 const uint32_t connectionId, const std::string& appId, const bool connected)
             {
-                return (Core::ProxyType<Core::IDispatch>(Core::ProxyType<ConnectionStatusNotificationJob>::Create(parent, connectionId, appId, connected)));
+                Core::ProxyType<ConnectionStatusNotificationJob> job = Utils::JobPool<ConnectionStatusNotificationJob>::Element();
+                job->Set(parent, connectionId, appId, connected);
+                return (Core::ProxyType<Core::IDispatch>(job));
             }
             virtual void Dispatch()
             {
-                mParent.OnConnectionStatusChanged(mAppId, mConnectionId, mConnected);
+                mParent->OnConnectionStatusChanged(mAppId, mConnectionId, mConnected);
+            }
+            // Invoked by the job pool on recycle
+            void Clear()
+            {
+                if (mParent != nullptr) {
+                    mParent->Release();
+                    mParent = nullptr;
+                }
+                mAppId.clear();
             }
 
         private:
-            AppGatewayResponderImplementation &mParent;
-            const uint32_t mConnectionId;
-            const std::string mAppId;
-            const bool mConnected;
-        };
+            void Set(AppGatewayResponderImplementation *parent, const uint32_t connectionId,
+                const std::string& appId, const bool connected)
+            {
+                mParent = parent;
+                mParent->AddRef();
+                mConnectionId = connectionId;
+                mAppId = appId;
+                mConnected = connected;
+            }
 
+            AppGatewayResponderImplementation *mParent;
+            uint32_t mConnectionId;
+            std::string mAppId;
+            bool mConnected;
+        };
 
         class AppIdRegistry{
         public:
@@ -370,13 +508,41 @@ namespace Plugin {
             std::mutex mCompliantJsonRpcMutex;
         };
 
+        // Drives the pending request timer wheel while requests are outstanding
+        class PendingRequestTimer
+        {
+        public:
+            PendingRequestTimer(AppGatewayResponderImplementation* parent) : mParent(parent) {}
+
+            uint64_t Timed(const uint64_t scheduledTime)
+            {
+                return mParent->OnPendingRequestTimer(scheduledTime);
+            }
+
+            // Required by TimerType::Revoke for comparison
+            bool operator==(const PendingRequestTimer& other) const
+            {
+                return mParent == other.mParent;
+            }
+
+        private:
+            AppGatewayResponderImplementation* mParent;
+        };
+
         void DispatchWsMsg(const std::string& method,
             const std::string& params,
             const uint32_t requestId,
             const uint32_t connectionId);
 
+        bool OnAppResponse(const uint32_t connectionId, const uint32_t requestId, const string& payload, const bool isError);
+        uint64_t OnPendingRequestTimer(const uint64_t scheduledTime);
+        void CompletePendingRequests(std::vector<Utils::PendingRequestTable::Entry>& entries, const Core::hresult result, const string& payload);
+        static uint64_t NowMs();
+
 
         void ReturnMessageInSocket(const uint32_t connectionId, const int requestId, const string payload);
+        Core::hresult OnEventRingDoorbell(const string& payload);
+        void DrainEventRing();
 
         PluginHost::IShell* mService;
         WebSocketConnectionManager mWsManager;
@@ -391,6 +557,16 @@ namespace Plugin {
         bool mEnhancedLoggingEnabled;
         CompliantJsonRpcRegistry mCompliantJsonRpcRegistry;
         DebugDisabledConnectionsRegistry mDebugDisabledConnectionsRegistry;
+        Utils::PendingRequestTable mPendingRequests;
+        Core::CriticalSection mPendingRequestTimerLock;
+        Core::TimerType<PendingRequestTimer> mPendingRequestTimer;
+        bool mPendingRequestTimerArmed;
+        // Requests being resolved and responses/emits/requests queued for the sockets
+        Utils::DrainTracker mDrain;
+        // Events from AppNotifications through shared memory, see UtilsSharedEventRing.h
+        Core::CriticalSection mEventRingLock;
+        Utils::SharedEventRing mEventRing;
+        std::atomic<bool> mEventRingScheduled;
     };
 } // namespace Plugin
 } // namespace WPEFramework
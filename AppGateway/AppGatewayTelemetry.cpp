@@ -18,6 +18,7 @@
  */
 
 #include "AppGatewayTelemetry.h"
+#include "AppGatewayTelemetryCodec.h"
 #include "UtilsLogging.h"
 #include "UtilsTelemetry.h"
 #include <limits>
@@ -46,6 +47,11 @@ namespace Plugin {
         , mTimerRunning(false)
         , mCachedEventCount(0)
         , mInitialized(false)
+        , mBatchSequence(0)
+        , mT2Queue([](const std::string& marker, const std::string& payload) {
+              // The T2 API signature takes non-const char* but doesn't modify the strings
+              ::Utils::Telemetry::sendMessage(const_cast<char*>(marker.c_str()), const_cast<char*>(payload.c_str()));
+          }, TELEMETRY_DEFAULT_SEND_QUEUE_CAPACITY)
     {
         LOGTRACE("AppGatewayTelemetry constructor");
     }
@@ -72,6 +78,8 @@ namespace Plugin {
         // including AppGateway. Avoid calling init() here to prevent multiple initializations.
         // Utils::Telemetry::init();
 
+        mT2Queue.Start();
+
         // Start the periodic reporting timer
         if (!mTimerRunning) {
             uint64_t intervalMs = static_cast<uint64_t>(mReportingIntervalSec) * 1000;
@@ -106,8 +114,12 @@ namespace Plugin {
 
         LOGINFO("AppGatewayTelemetry: Flushing final telemetry data on shutdown");
 
-        // Flush any remaining telemetry data synchronously
+        // Flush any remaining telemetry data and give the sender time to deliver it
         FlushTelemetryData();
+        if (!mT2Queue.Stop(TELEMETRY_SEND_QUEUE_DRAIN_TIMEOUT_MS)) {
+            LOGWARN("AppGatewayTelemetry: T2 sender did not drain in %u ms, %llu markers dropped in total",
+                    TELEMETRY_SEND_QUEUE_DRAIN_TIMEOUT_MS, static_cast<unsigned long long>(mT2Queue.Dropped()));
+        }
 
         {
             Core::SafeSyncType<Core::CriticalSection> lock(mAdminLock);
@@ -143,7 +155,8 @@ namespace Plugin {
         Core::SafeSyncType<Core::CriticalSection> lock(mAdminLock);
         mTelemetryFormat = format;
         LOGTRACE("AppGatewayTelemetry: Telemetry format set to %s", 
-                format == TelemetryFormat::JSON ? "JSON" : "COMPACT");
+                format == TelemetryFormat::JSON ? "JSON" :
+                format == TelemetryFormat::COMPACT ? "COMPACT" : "BINARY");
     }
 
     TelemetryFormat AppGatewayTelemetry::GetTelemetryFormat() const
@@ -339,6 +352,7 @@ namespace Plugin {
         // Supported event name patterns:
         // - "ENTS_ERROR_AppGwPluginApiError" - API errors from other plugins (sent immediately)
         // - "ENTS_ERROR_AppGwPlugExtnSrvErr" - External service errors (sent immediately)
+        // - "ENTS_INFO_AppGwAppMetric" - App metrics summaries from AppGatewayCommon (sent immediately)
         // - Any other event name - Generic telemetry event (cached and flushed periodically)
 
         bool isImmediateEvent = false;
@@ -363,6 +377,11 @@ namespace Plugin {
 
             isImmediateEvent = true;
         }
+        // App metrics summaries are aggregated by the sender already - send immediately to T2
+        else if (AGW_MARKER_APP_METRIC == eventName) {
+            SendT2Event(eventName.c_str(), eventData, context);
+            isImmediateEvent = true;
+        }
         // Check if this is an external service error event - send immediately to T2
         else if (AGW_MARKER_PLUGIN_EXT_SERVICE_ERROR == eventName) {
             // Extract service name from eventData if possible
@@ -988,13 +1007,14 @@ namespace Plugin {
             auto now = std::chrono::steady_clock::now();
             auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - mReportingStartTime).count();
 
-            LOGINFO("Flushing telemetry data synchronously (reporting period: %ld seconds)", elapsed);
+            LOGINFO("Flushing telemetry data (reporting period: %ld seconds)", elapsed);
 
             // Snapshot configuration
             snapshot->reportingIntervalSec = static_cast<uint32_t>(elapsed);  // Actual elapsed time, not configured interval
             snapshot->reportingStartTime = mReportingStartTime;
             snapshot->parent = this;
             snapshot->format = mTelemetryFormat;
+            snapshot->batchSequence = ++mBatchSequence;
             
             // Snapshot health statistics (atomic values)
             snapshot->websocketConnections = mHealthStats.websocketConnections.load(std::memory_order_relaxed);
@@ -1033,12 +1053,23 @@ namespace Plugin {
             mCachedEventCount = 0;
             mReportingStartTime = now;
             
-            LOGTRACE("Snapshot created, sending telemetry synchronously");
+            LOGTRACE("Snapshot created, queueing telemetry");
         }
         // Lock released - new telemetry can now be recorded while snapshot is being sent
 
-        // Send telemetry synchronously (no WorkerPool dispatch)
+        // Queue the whole flush as one batch for the T2 sender thread; formatting
+        // stays on this thread, the T2 calls do not
+        Utils::TelemetryQueue::Batch batch(mT2Queue);
         snapshot->SendAll();
+
+        const uint64_t dropped = mT2Queue.TakeDropped();
+        if (dropped > 0) {
+            LOGWARN("AppGatewayTelemetry: %llu T2 markers dropped since the last flush", static_cast<unsigned long long>(dropped));
+            JsonObject droppedPayload;
+            droppedPayload["dropped"] = static_cast<uint32_t>(dropped);
+            droppedPayload["unit"] = AGW_UNIT_COUNT;
+            SendT2Event(AGW_MARKER_TELEMETRY_DROPPED, droppedPayload, CreateSystemContext());
+        }
     }
 
     void AppGatewayTelemetry::SendHealthStats()
@@ -1442,10 +1473,8 @@ namespace Plugin {
         // Format according to telemetry format setting and send
         std::string formattedPayload = FormatTelemetryPayload(contextPayload);
 
-        // The T2 API signature takes non-const char* but doesn't modify the strings
         LOGINFO("marker=%s, payload=%s", marker, formattedPayload.c_str());
-        Utils::Telemetry::sendMessage(const_cast<char*>(marker), 
-                                        const_cast<char*>(formattedPayload.c_str()));
+        mT2Queue.Post(std::string(marker), std::move(formattedPayload));
     }
 
     void AppGatewayTelemetry::SendT2Event(const char* marker, const JsonObject& payload, const Exchange::GatewayContext& context)
@@ -1474,10 +1503,8 @@ namespace Plugin {
         // Format according to telemetry format setting and send
         std::string formattedPayload = FormatTelemetryPayload(contextPayload);
 
-        // The T2 API signature takes non-const char* but doesn't modify the strings
         LOGINFO("marker=%s, payload=%s", marker, formattedPayload.c_str());
-        Utils::Telemetry::sendMessage(const_cast<char*>(marker),
-                                        const_cast<char*>(formattedPayload.c_str()));
+        mT2Queue.Post(std::string(marker), std::move(formattedPayload));
     }
 
     void AppGatewayTelemetry::ResetHealthStats()
@@ -1525,8 +1552,8 @@ namespace Plugin {
 
     std::string AppGatewayTelemetry::FormatTelemetryPayload(const JsonObject& jsonPayload)
     {
-        if (mTelemetryFormat == TelemetryFormat::JSON) {
-            // JSON format: Return as-is
+        if (mTelemetryFormat != TelemetryFormat::COMPACT) {
+            // JSON format: Return as-is (BINARY only changes how flushes are batched)
             std::string payloadStr;
             jsonPayload.ToString(payloadStr);
             return payloadStr;
@@ -1617,6 +1644,11 @@ namespace Plugin {
 
         LOGINFO("TelemetrySnapshot: Sending telemetry data (reporting interval: %u sec)", reportingIntervalSec);
 
+        if (format == TelemetryFormat::BINARY) {
+            SendBinaryBatch();
+            return;
+        }
+
         // Send all aggregated telemetry data
         // Note: These methods use the snapshot's data members directly
         
@@ -1956,6 +1988,88 @@ namespace Plugin {
         LOGINFO("TelemetrySnapshot: Aggregated metrics sent: %zu metrics", metricsCache.size());
     }
 
+    void AppGatewayTelemetry::TelemetrySnapshot::SendBinaryBatch()
+    {
+        // Same selection and reductions as the per-marker senders above, so the
+        // decoder reproduces their payloads exactly
+        TelemetryBatchEncoder encoder(reportingIntervalSec);
+
+        if (totalCalls != 0 || websocketConnections != 0 || !requestStates.empty()) {
+            encoder.AddHealth(websocketConnections, totalCalls, totalResponses, successfulCalls, failedCalls);
+        }
+
+        auto minOf = [](double value) { return (value == std::numeric_limits<double>::max()) ? 0.0 : value; };
+        auto maxOf = [](double value) { return (value == std::numeric_limits<double>::lowest()) ? 0.0 : value; };
+
+        for (const auto& item : apiMethodStats) {
+            const ApiMethodStats& stats = item.second;
+            if (stats.successCount == 0 && stats.errorCount == 0) {
+                continue;
+            }
+            encoder.AddMethodStats(TelemetryBatchCodec::KindApiMethod, stats.pluginName, stats.methodName,
+                stats.successCount, minOf(stats.minSuccessLatencyMs), maxOf(stats.maxSuccessLatencyMs),
+                (stats.successCount > 0) ? stats.totalSuccessLatencyMs / stats.successCount : 0.0,
+                stats.errorCount, minOf(stats.minErrorLatencyMs), maxOf(stats.maxErrorLatencyMs),
+                (stats.errorCount > 0) ? stats.totalErrorLatencyMs / stats.errorCount : 0.0);
+        }
+        for (const auto& item : apiLatencyStats) {
+            const ApiLatencyStats& stats = item.second;
+            if (stats.count == 0) {
+                continue;
+            }
+            encoder.AddLatencyStats(TelemetryBatchCodec::KindApiLatency, stats.pluginName, stats.apiName, stats.count,
+                stats.totalLatencyMs / stats.count, minOf(stats.minLatencyMs), maxOf(stats.maxLatencyMs));
+        }
+        for (const auto& item : serviceMethodStats) {
+            const ServiceMethodStats& stats = item.second;
+            if (stats.successCount == 0 && stats.errorCount == 0) {
+                continue;
+            }
+            encoder.AddMethodStats(TelemetryBatchCodec::KindServiceMethod, stats.pluginName, stats.serviceName,
+                stats.successCount, minOf(stats.minSuccessLatencyMs), maxOf(stats.maxSuccessLatencyMs),
+                (stats.successCount > 0) ? stats.totalSuccessLatencyMs / stats.successCount : 0.0,
+                stats.errorCount, minOf(stats.minErrorLatencyMs), maxOf(stats.maxErrorLatencyMs),
+                (stats.errorCount > 0) ? stats.totalErrorLatencyMs / stats.errorCount : 0.0);
+        }
+        for (const auto& item : serviceLatencyStats) {
+            const ServiceLatencyStats& stats = item.second;
+            if (stats.count == 0) {
+                continue;
+            }
+            encoder.AddLatencyStats(TelemetryBatchCodec::KindServiceLatency, stats.pluginName, stats.serviceName, stats.count,
+                stats.totalLatencyMs / stats.count, minOf(stats.minLatencyMs), maxOf(stats.maxLatencyMs));
+        }
+        for (const auto& item : apiErrorCounts) {
+            encoder.AddErrorCount(TelemetryBatchCodec::KindApiError, item.first, item.second);
+        }
+        for (const auto& item : externalServiceErrorCounts) {
+            encoder.AddErrorCount(TelemetryBatchCodec::KindServiceError, item.first, item.second);
+        }
+        for (const auto& item : metricsCache) {
+            const MetricData& data = item.second;
+            if (data.count == 0) {
+                continue;
+            }
+            encoder.AddMetric(item.first, data.unit, data.count, minOf(data.min), maxOf(data.max),
+                data.sum / static_cast<double>(data.count));
+        }
+
+        if (encoder.RecordCount() == 0) {
+            LOGINFO("TelemetrySnapshot: No telemetry to report");
+            return;
+        }
+
+        std::vector<std::string> chunks;
+        encoder.Finish(batchSequence, TELEMETRY_BATCH_CHUNK_SIZE, chunks);
+        for (const std::string& chunk : chunks) {
+            LOGINFO("marker=%s, payload=%s", AGW_MARKER_TELEMETRY_BATCH, chunk.c_str());
+            parent->mT2Queue.Post(AGW_MARKER_TELEMETRY_BATCH, chunk);
+        }
+
+        LOGINFO("TelemetrySnapshot: Binary batch %u sent: %u records in %zu chunks",
+                batchSequence, encoder.RecordCount(), chunks.size());
+    }
+
     // FlushJob Implementation - Async telemetry sending (DEPRECATED - kept for compatibility)
 
     void AppGatewayTelemetry::FlushJob::Dispatch()
@@ -28,6 +28,7 @@
 
 // Include consolidated telemetry markers
 #include "AppGatewayTelemetryMarkers.h"
+#include "UtilsTelemetryQueue.h"
 
 // Default reporting interval in seconds (1 hour)
 #define TELEMETRY_DEFAULT_REPORTING_INTERVAL_SEC             3600
@@ -35,6 +36,17 @@
 // Default cache threshold (number of records before forced flush)
 #define TELEMETRY_DEFAULT_CACHE_THRESHOLD                    1000
 
+// Maximum base64 characters per T2 event when sending a binary flush batch
+#define TELEMETRY_BATCH_CHUNK_SIZE                           1024
+
+// Markers waiting for the T2 sender thread before the oldest is dropped; a flush
+// is never cut short by it
+#define TELEMETRY_DEFAULT_SEND_QUEUE_CAPACITY                1024
+
+// Time given to the T2 sender thread to empty its queue on shutdown; best effort,
+// a T2 call in progress by then is waited for
+#define TELEMETRY_SEND_QUEUE_DRAIN_TIMEOUT_MS                2000
+
 namespace WPEFramework {
 namespace Plugin {
 
@@ -44,11 +56,14 @@ namespace Plugin {
      * Determines how telemetry data is formatted before sending to T2:
      * - JSON: Full JSON objects with field names (more verbose, self-describing)
      * - COMPACT: Comma-separated values (smaller payload, requires schema knowledge)
+     * - BINARY: Periodic flushes are sent as one dictionary-coded batch (see
+     *           AppGatewayTelemetryCodec.h); immediate events stay JSON
      */
     enum class TelemetryFormat
     {
         JSON,       // {"field1":"value1","field2":123} - Self-describing, extensible
-        COMPACT     // value1,value2,123 - Minimal size, requires external schema
+        COMPACT,    // value1,value2,123 - Minimal size, requires external schema
+        BINARY      // <seq>.<part>/<parts>:<base64> - Whole flush in one batch, decoded off-device
     };
 
     /**
@@ -66,7 +81,8 @@ namespace Plugin {
      * - External service errors: Failures from external services (GrpcServer, Permission, etc.)
      * 
      * Data is reported via T2 telemetry at configurable intervals (default 1 hour)
-     * or when cache threshold is reached.
+     * or when cache threshold is reached. Markers are handed to a bounded queue
+     * and sent by its own thread, so a slow T2 daemon never stalls the caller.
      */
     class AppGatewayTelemetry : public Exchange::IAppGatewayTelemetry
     {
@@ -139,7 +155,8 @@ namespace Plugin {
          * @brief Set the telemetry output format
          * 
          * @param format TelemetryFormat::JSON for self-describing JSON payloads,
-         *               TelemetryFormat::COMPACT for comma-separated values
+         *               TelemetryFormat::COMPACT for comma-separated values,
+         *               TelemetryFormat::BINARY for one encoded batch per flush
          */
         void SetTelemetryFormat(TelemetryFormat format);
         
@@ -376,6 +393,7 @@ namespace Plugin {
             std::chrono::steady_clock::time_point reportingStartTime;
             AppGatewayTelemetry* parent;  // Reference to parent for SendT2Event
             TelemetryFormat format;
+            uint32_t batchSequence;  // Identifies this flush's chunks in BINARY format
             
             // Health statistics (atomic values snapshotted)
             uint32_t websocketConnections;
@@ -400,6 +418,7 @@ namespace Plugin {
                 : reportingIntervalSec(0)
                 , parent(nullptr)
                 , format(TelemetryFormat::JSON)
+                , batchSequence(0)
                 , websocketConnections(0)
                 , totalCalls(0)
                 , totalResponses(0)
@@ -420,6 +439,9 @@ namespace Plugin {
             void SendApiErrorStats();
             void SendExternalServiceErrorStats();
             void SendAggregatedMetrics();
+
+            // Encodes all of the above into one batch (TelemetryFormat::BINARY)
+            void SendBinaryBatch();
         };
 
         /**
@@ -637,6 +659,12 @@ namespace Plugin {
 
         // Initialization state
         bool mInitialized;
+
+        // Sequence number of the last binary flush batch
+        uint32_t mBatchSequence;
+
+        // T2 send queue; t2_event_s() is only called from its sender thread
+        Utils::TelemetryQueue mT2Queue;
     };
 
 } // namespace Plugin
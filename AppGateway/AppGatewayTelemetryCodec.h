@@ -0,0 +1,579 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// Deliberately free of Thunder dependencies: the decoder side is also built
+// into the host tool that expands collected batches (tools/TelemetryBatchDecoder.cpp).
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "AppGatewayTelemetryMarkers.h"
+
+namespace WPEFramework {
+namespace Plugin {
+
+    /**
+     * @brief Binary layout of one telemetry flush
+     *
+     * header   : magic "AGTB" (u32), version (u16), key count (u16), reporting interval (u32)
+     * keys     : key count x { length (u16), bytes } - every plugin, method, service, metric
+     *            and unit name appears once and is referenced by index
+     * records  : kind (u8) followed by a fixed-width body per kind
+     *
+     * All integers are little-endian, latencies are float32 milliseconds and generic metric
+     * values float64. Records hold the already reduced min/max/avg, so the decoder rebuilds
+     * exactly the JSON payloads the per-marker path sends today.
+     */
+    class TelemetryBatchCodec {
+    public:
+        enum Kind : uint8_t {
+            KindHealth = 1,
+            KindApiMethod = 2,
+            KindApiLatency = 3,
+            KindServiceMethod = 4,
+            KindServiceLatency = 5,
+            KindApiError = 6,
+            KindServiceError = 7,
+            KindMetric = 8
+        };
+
+        static constexpr uint32_t Magic = 0x42544741; // "AGTB"
+        static constexpr uint16_t Version = 1;
+
+        static std::string Base64Encode(const std::string& data)
+        {
+            static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            std::string out;
+            out.reserve(((data.size() + 2) / 3) * 4);
+            size_t index = 0;
+            for (; index + 2 < data.size(); index += 3) {
+                const uint32_t v = (static_cast<uint8_t>(data[index]) << 16) | (static_cast<uint8_t>(data[index + 1]) << 8) | static_cast<uint8_t>(data[index + 2]);
+                out += table[(v >> 18) & 0x3F];
+                out += table[(v >> 12) & 0x3F];
+                out += table[(v >> 6) & 0x3F];
+                out += table[v & 0x3F];
+            }
+            if (index < data.size()) {
+                uint32_t v = static_cast<uint8_t>(data[index]) << 16;
+                if (index + 1 < data.size()) {
+                    v |= static_cast<uint8_t>(data[index + 1]) << 8;
+                }
+                out += table[(v >> 18) & 0x3F];
+                out += table[(v >> 12) & 0x3F];
+                out += (index + 1 < data.size()) ? table[(v >> 6) & 0x3F] : '=';
+                out += '=';
+            }
+            return out;
+        }
+
+        static bool Base64Decode(const std::string& text, std::string& data)
+        {
+            data.clear();
+            uint32_t buffer = 0;
+            int bits = 0;
+            for (const char c : text) {
+                int value;
+                if (c >= 'A' && c <= 'Z') value = c - 'A';
+                else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+                else if (c >= '0' && c <= '9') value = c - '0' + 52;
+                else if (c == '+') value = 62;
+                else if (c == '/') value = 63;
+                else if (c == '=') break;
+                else return false;
+                buffer = (buffer << 6) | static_cast<uint32_t>(value);
+                bits += 6;
+                if (bits >= 8) {
+                    bits -= 8;
+                    data += static_cast<char>((buffer >> bits) & 0xFF);
+                }
+            }
+            return true;
+        }
+
+    protected:
+        static void PutU8(std::string& out, const uint8_t value) { out += static_cast<char>(value); }
+        static void PutU16(std::string& out, const uint16_t value)
+        {
+            out += static_cast<char>(value & 0xFF);
+            out += static_cast<char>(value >> 8);
+        }
+        static void PutU32(std::string& out, const uint32_t value)
+        {
+            PutU16(out, static_cast<uint16_t>(value & 0xFFFF));
+            PutU16(out, static_cast<uint16_t>(value >> 16));
+        }
+        static void PutF32(std::string& out, const double value)
+        {
+            const float narrowed = static_cast<float>(value);
+            uint32_t bits;
+            ::memcpy(&bits, &narrowed, sizeof(bits));
+            PutU32(out, bits);
+        }
+        static void PutF64(std::string& out, const double value)
+        {
+            uint64_t bits;
+            ::memcpy(&bits, &value, sizeof(bits));
+            PutU32(out, static_cast<uint32_t>(bits & 0xFFFFFFFFULL));
+            PutU32(out, static_cast<uint32_t>(bits >> 32));
+        }
+    };
+
+    // Builds one batch while the flush walks its aggregation maps
+    class TelemetryBatchEncoder : public TelemetryBatchCodec {
+    public:
+        explicit TelemetryBatchEncoder(const uint32_t reportingIntervalSec)
+            : mReportingIntervalSec(reportingIntervalSec)
+            , mKeys()
+            , mKeyTable()
+            , mRecords()
+            , mRecordCount(0)
+        {
+            // Index 0 is always the empty key, so names that do not fit have a slot to collapse to
+            Key(std::string());
+        }
+
+        TelemetryBatchEncoder(const TelemetryBatchEncoder&) = delete;
+        TelemetryBatchEncoder& operator=(const TelemetryBatchEncoder&) = delete;
+
+        void AddHealth(const uint32_t websocketConnections, const uint32_t totalCalls, const uint32_t totalResponses,
+                       const uint32_t successfulCalls, const uint32_t failedCalls)
+        {
+            PutU8(mRecords, KindHealth);
+            PutU32(mRecords, websocketConnections);
+            PutU32(mRecords, totalCalls);
+            PutU32(mRecords, totalResponses);
+            PutU32(mRecords, successfulCalls);
+            PutU32(mRecords, failedCalls);
+            ++mRecordCount;
+        }
+
+        // kind is KindApiMethod or KindServiceMethod; min/max/avg are ignored for zero counts
+        void AddMethodStats(const Kind kind, const std::string& plugin, const std::string& name,
+                            const uint32_t successCount, const double successMin, const double successMax, const double successAvg,
+                            const uint32_t errorCount, const double errorMin, const double errorMax, const double errorAvg)
+        {
+            PutU8(mRecords, kind);
+            PutU16(mRecords, Key(plugin));
+            PutU16(mRecords, Key(name));
+            PutU32(mRecords, successCount);
+            PutF32(mRecords, successMin);
+            PutF32(mRecords, successMax);
+            PutF32(mRecords, successAvg);
+            PutU32(mRecords, errorCount);
+            PutF32(mRecords, errorMin);
+            PutF32(mRecords, errorMax);
+            PutF32(mRecords, errorAvg);
+            ++mRecordCount;
+        }
+
+        // kind is KindApiLatency or KindServiceLatency
+        void AddLatencyStats(const Kind kind, const std::string& plugin, const std::string& name,
+                             const uint32_t count, const double avg, const double min, const double max)
+        {
+            PutU8(mRecords, kind);
+            PutU16(mRecords, Key(plugin));
+            PutU16(mRecords, Key(name));
+            PutU32(mRecords, count);
+            PutF32(mRecords, avg);
+            PutF32(mRecords, min);
+            PutF32(mRecords, max);
+            ++mRecordCount;
+        }
+
+        // kind is KindApiError or KindServiceError
+        void AddErrorCount(const Kind kind, const std::string& name, const uint32_t count)
+        {
+            PutU8(mRecords, kind);
+            PutU16(mRecords, Key(name));
+            PutU32(mRecords, count);
+            ++mRecordCount;
+        }
+
+        void AddMetric(const std::string& name, const std::string& unit, const uint32_t count,
+                       const double min, const double max, const double avg)
+        {
+            PutU8(mRecords, KindMetric);
+            PutU16(mRecords, Key(name));
+            PutU16(mRecords, Key(unit));
+            PutU32(mRecords, count);
+            PutF64(mRecords, min);
+            PutF64(mRecords, max);
+            PutF64(mRecords, avg);
+            ++mRecordCount;
+        }
+
+        uint32_t RecordCount() const
+        {
+            return mRecordCount;
+        }
+
+        // Serializes the batch and splits its base64 form into chunks of at most chunkSize
+        // characters, each prefixed with "<sequence>.<part>/<parts>:"
+        void Finish(const uint32_t sequence, const size_t chunkSize, std::vector<std::string>& chunks) const
+        {
+            std::string batch;
+            batch.reserve(12 + mKeyTable.size() * 16 + mRecords.size());
+            PutU32(batch, Magic);
+            PutU16(batch, Version);
+            PutU16(batch, static_cast<uint16_t>(mKeyTable.size()));
+            PutU32(batch, mReportingIntervalSec);
+            for (const std::string* key : mKeyTable) {
+                PutU16(batch, static_cast<uint16_t>(key->size()));
+                batch.append(*key);
+            }
+            batch.append(mRecords);
+
+            const std::string encoded = Base64Encode(batch);
+            const size_t step = (chunkSize == 0) ? encoded.size() : chunkSize;
+            const size_t parts = (encoded.empty() || step == 0) ? 1 : (encoded.size() + step - 1) / step;
+            for (size_t part = 0; part < parts; ++part) {
+                chunks.push_back(std::to_string(sequence) + "." + std::to_string(part + 1) + "/" + std::to_string(parts) + ":"
+                    + encoded.substr(part * step, step));
+            }
+        }
+
+    private:
+        uint16_t Key(const std::string& name)
+        {
+            // Names past the u16 index space or length collapse to the empty key
+            auto it = mKeys.find(name);
+            if (it != mKeys.end()) {
+                return it->second;
+            }
+            if (mKeyTable.size() >= 0xFFFF || name.size() > 0xFFFF) {
+                return 0;
+            }
+            const uint16_t index = static_cast<uint16_t>(mKeyTable.size());
+            it = mKeys.emplace(name, index).first;
+            mKeyTable.push_back(&it->first);
+            return index;
+        }
+
+        const uint32_t mReportingIntervalSec;
+        std::unordered_map<std::string, uint16_t> mKeys;
+        std::vector<const std::string*> mKeyTable;
+        std::string mRecords;
+        uint32_t mRecordCount;
+    };
+
+    // Expands batches back into the (marker, JSON payload) pairs of the per-marker format
+    class TelemetryBatchDecoder : public TelemetryBatchCodec {
+    public:
+        typedef std::pair<std::string, std::string> Event;
+
+        TelemetryBatchDecoder()
+            : mData()
+            , mOffset(0)
+        {
+        }
+
+        // Reassembles the chunks of one sequence (any order) and decodes the batch
+        static bool DecodeChunks(const std::vector<std::string>& chunks, std::vector<Event>& events, std::string& error)
+        {
+            std::vector<std::string> parts;
+            for (const std::string& chunk : chunks) {
+                unsigned part = 0;
+                unsigned total = 0;
+                const size_t colon = chunk.find(':');
+                if (colon == std::string::npos || std::sscanf(chunk.c_str(), "%*u.%u/%u", &part, &total) != 2
+                    || part == 0 || part > total) {
+                    error = "malformed chunk header";
+                    return false;
+                }
+                if (parts.empty()) {
+                    parts.resize(total);
+                } else if (parts.size() != total) {
+                    error = "chunks from different batches";
+                    return false;
+                }
+                parts[part - 1] = chunk.substr(colon + 1);
+            }
+            std::string encoded;
+            for (const std::string& part : parts) {
+                if (part.empty()) {
+                    error = "missing chunk";
+                    return false;
+                }
+                encoded += part;
+            }
+            std::string batch;
+            if (!Base64Decode(encoded, batch)) {
+                error = "invalid base64";
+                return false;
+            }
+            TelemetryBatchDecoder decoder;
+            return decoder.Decode(batch, events, error);
+        }
+
+        bool Decode(const std::string& batch, std::vector<Event>& events, std::string& error)
+        {
+            mData = batch;
+            mOffset = 0;
+            uint32_t magic = 0;
+            uint16_t version = 0;
+            uint16_t keyCount = 0;
+            uint32_t interval = 0;
+            if (!GetU32(magic) || magic != Magic || !GetU16(version) || version != Version
+                || !GetU16(keyCount) || !GetU32(interval)) {
+                error = "not a telemetry batch";
+                return false;
+            }
+            std::vector<std::string> keys(keyCount);
+            for (std::string& key : keys) {
+                uint16_t length = 0;
+                if (!GetU16(length) || mData.size() - mOffset < length) {
+                    error = "truncated key table";
+                    return false;
+                }
+                key.assign(mData, mOffset, length);
+                mOffset += length;
+            }
+
+            while (mOffset < mData.size()) {
+                uint8_t kind = 0;
+                GetU8(kind);
+                std::string marker;
+                std::string json;
+                if (!DecodeRecord(static_cast<Kind>(kind), keys, interval, marker, json)) {
+                    error = "truncated or unknown record";
+                    return false;
+                }
+                events.emplace_back(std::move(marker), std::move(json));
+            }
+            return true;
+        }
+
+    private:
+        bool DecodeRecord(const Kind kind, const std::vector<std::string>& keys, const uint32_t interval,
+                          std::string& marker, std::string& json)
+        {
+            JsonWriter out(json);
+            switch (kind) {
+            case KindHealth: {
+                uint32_t values[5];
+                for (uint32_t& value : values) {
+                    if (!GetU32(value)) return false;
+                }
+                marker = AGW_MARKER_HEALTH_STATS;
+                out.Number("reporting_interval_sec", interval);
+                out.Number("websocket_connections", values[0]);
+                out.Number("total_calls", values[1]);
+                out.Number("total_responses", values[2]);
+                out.Number("successful_calls", values[3]);
+                out.Number("failed_calls", values[4]);
+                out.String("unit", AGW_UNIT_COUNT);
+                break;
+            }
+            case KindApiMethod:
+            case KindServiceMethod: {
+                uint16_t plugin, name;
+                uint32_t successCount, errorCount;
+                float success[3], failure[3];
+                if (!GetKey(plugin, keys) || !GetKey(name, keys) || !GetU32(successCount)
+                    || !GetF32(success[0]) || !GetF32(success[1]) || !GetF32(success[2]) || !GetU32(errorCount)
+                    || !GetF32(failure[0]) || !GetF32(failure[1]) || !GetF32(failure[2])) {
+                    return false;
+                }
+                const bool api = (kind == KindApiMethod);
+                marker = api ? AGW_MARKER_API_METHOD_STAT : AGW_MARKER_SERVICE_METHOD_STAT;
+                out.String("plugin_name", keys[plugin]);
+                out.String(api ? "method_name" : "service_name", keys[name]);
+                out.Number("reporting_interval_sec", interval);
+                out.Number("success_count", successCount);
+                if (successCount > 0) {
+                    out.Float("success_latency_min_ms", success[0]);
+                    out.Float("success_latency_max_ms", success[1]);
+                    out.Float("success_latency_avg_ms", success[2]);
+                }
+                out.Number("error_count", errorCount);
+                if (errorCount > 0) {
+                    out.Float("error_latency_min_ms", failure[0]);
+                    out.Float("error_latency_max_ms", failure[1]);
+                    out.Float("error_latency_avg_ms", failure[2]);
+                }
+                if (api) {
+                    out.Number("total_count", successCount + errorCount);
+                }
+                break;
+            }
+            case KindApiLatency:
+            case KindServiceLatency: {
+                uint16_t plugin, name;
+                uint32_t count;
+                float avg, min, max;
+                if (!GetKey(plugin, keys) || !GetKey(name, keys) || !GetU32(count)
+                    || !GetF32(avg) || !GetF32(min) || !GetF32(max)) {
+                    return false;
+                }
+                const bool api = (kind == KindApiLatency);
+                marker = api ? AGW_MARKER_API_LATENCY : AGW_MARKER_SERVICE_LATENCY;
+                out.String("plugin_name", keys[plugin]);
+                out.String(api ? "api_name" : "service_name", keys[name]);
+                out.Number("reporting_interval_sec", interval);
+                out.Number("count", count);
+                out.Float("avg_ms", avg);
+                out.Float("min_ms", min);
+                out.Float("max_ms", max);
+                out.String("unit", AGW_UNIT_MILLISECONDS);
+                break;
+            }
+            case KindApiError:
+            case KindServiceError: {
+                uint16_t name;
+                uint32_t count;
+                if (!GetKey(name, keys) || !GetU32(count)) {
+                    return false;
+                }
+                const bool api = (kind == KindApiError);
+                marker = api ? AGW_MARKER_API_ERROR_COUNT : AGW_MARKER_EXT_SERVICE_ERROR_COUNT;
+                out.Number("reporting_interval_sec", interval);
+                out.String(api ? "ApiName" : "ServiceName", keys[name]);
+                out.Number("count", count);
+                out.String("unit", AGW_UNIT_COUNT);
+                break;
+            }
+            case KindMetric: {
+                uint16_t name, unit;
+                uint32_t count;
+                double min, max, avg;
+                if (!GetKey(name, keys) || !GetKey(unit, keys) || !GetU32(count)
+                    || !GetF64(min) || !GetF64(max) || !GetF64(avg)) {
+                    return false;
+                }
+                marker = keys[name];
+                out.Float("min", min, 15);
+                out.Float("max", max, 15);
+                out.Number("count", count);
+                out.Float("avg", avg, 15);
+                out.String("unit", keys[unit]);
+                out.Number("reporting_interval_sec", interval);
+                break;
+            }
+            default:
+                return false;
+            }
+            out.Close();
+            return true;
+        }
+
+        class JsonWriter {
+        public:
+            explicit JsonWriter(std::string& out)
+                : mOut(out)
+            {
+                mOut = "{";
+            }
+            void Number(const char* label, const uint32_t value)
+            {
+                Label(label);
+                mOut += std::to_string(value);
+            }
+            void Float(const char* label, const double value, const int digits = 6)
+            {
+                char text[32];
+                std::snprintf(text, sizeof(text), "%.*g", digits, value);
+                Label(label);
+                mOut += text;
+            }
+            void String(const char* label, const std::string& value)
+            {
+                Label(label);
+                mOut += '"';
+                for (const char c : value) {
+                    if (c == '"' || c == '\\') {
+                        mOut += '\\';
+                        mOut += c;
+                    } else if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                        mOut += escaped;
+                    } else {
+                        mOut += c;
+                    }
+                }
+                mOut += '"';
+            }
+            void Close() { mOut += '}'; }
+
+        private:
+            void Label(const char* label)
+            {
+                if (mOut.size() > 1) {
+                    mOut += ',';
+                }
+                mOut += '"';
+                mOut += label;
+                mOut += "\":";
+            }
+            std::string& mOut;
+        };
+
+        bool GetU8(uint8_t& value)
+        {
+            if (mOffset >= mData.size()) return false;
+            value = static_cast<uint8_t>(mData[mOffset++]);
+            return true;
+        }
+        bool GetU16(uint16_t& value)
+        {
+            if (mData.size() - mOffset < 2) return false;
+            value = static_cast<uint16_t>(static_cast<uint8_t>(mData[mOffset]) | (static_cast<uint8_t>(mData[mOffset + 1]) << 8));
+            mOffset += 2;
+            return true;
+        }
+        bool GetU32(uint32_t& value)
+        {
+            uint16_t low, high;
+            if (!GetU16(low) || !GetU16(high)) return false;
+            value = static_cast<uint32_t>(low) | (static_cast<uint32_t>(high) << 16);
+            return true;
+        }
+        bool GetF32(float& value)
+        {
+            uint32_t bits;
+            if (!GetU32(bits)) return false;
+            ::memcpy(&value, &bits, sizeof(value));
+            return true;
+        }
+        bool GetF64(double& value)
+        {
+            uint32_t low, high;
+            if (!GetU32(low) || !GetU32(high)) return false;
+            const uint64_t bits = static_cast<uint64_t>(low) | (static_cast<uint64_t>(high) << 32);
+            ::memcpy(&value, &bits, sizeof(value));
+            return true;
+        }
+        bool GetKey(uint16_t& index, const std::vector<std::string>& keys)
+        {
+            return GetU16(index) && index < keys.size();
+        }
+
+        std::string mData;
+        size_t mOffset;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
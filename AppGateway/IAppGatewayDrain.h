@@ -0,0 +1,40 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2025 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#pragma once
+
+#include "Module.h"
+
+namespace WPEFramework {
+namespace Plugin {
+    // Lets the plugin drain the responder before deactivating it. Private to this
+    // library and without a proxy/stub: when the responder runs out of process the
+    // query fails and the plugin deactivates without draining.
+    struct EXTERNAL IAppGatewayDrain : virtual public Core::IUnknown {
+        enum { ID = 0x8A670001 };
+
+        ~IAppGatewayDrain() override = default;
+
+        // Stops taking new connections and requests, lets in-flight ones finish and
+        // closes every connection with a retry hint, all within timeoutMs. Returns
+        // Core::ERROR_NONE if nothing was cut off, Core::ERROR_TIMEDOUT otherwise.
+        virtual Core::hresult Drain(const uint32_t timeoutMs) = 0;
+    };
+} // namespace Plugin
+} // namespace WPEFramework
@@ -18,11 +18,14 @@
  **/
 
 #include "Resolver.h"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include "UtilsLogging.h"
 #include "StringUtils.h"
+#include "ContextUtils.h"
 #include "UtilsJsonrpcDirectLink.h"
+#include "UtilsRequestArena.h"
 #include <core/JSON.h>
 
 
@@ -32,7 +35,7 @@ namespace WPEFramework
     {
 
         Resolver::Resolver(PluginHost::IShell *shell)
-            : mService(shell), mResolutions(), mMutex()
+            : mService(shell), mResolutions(), mPrefixTrie(), mPrefixRules(), mMutex()
         {
             LOGINFO("[Resolver] Constructor - configurations will be loaded via LoadConfig");
         }
@@ -110,11 +113,35 @@ namespace WPEFramework
                     r.useComRpc = ExtractBooleanField(resolutionObj, "useComRpc", hasAdditionalContext);
                     // Event which has different payload based on version
                     r.versionedEvent = ExtractBooleanField(resolutionObj, "versionedEvent", hasAdditionalContext);
+                    if (r.versionedEvent && (key.empty() || key.back() != '*')) {
+                        r.versionedEventName = ContextUtils::GetRDK8VersionedEventName(it.Label());
+                    }
+                    if (resolutionObj.HasLabel("params"))
+                    {
+                        r.validator = CompileValidator(key, resolutionObj["params"]);
+                    }
 
                     LOGINFO("[Resolver] Loaded resolution for key: %s -> alias: %s, event: %s, permissionGroup: %s, includeContext: %s, useComRpc: %s",
                             key.c_str(), r.alias.c_str(), r.event.c_str(), r.permissionGroup.c_str(),
                             r.includeContext ? "true" : "false", r.useComRpc ? "true" : "false");
 
+                    if (!key.empty() && key.back() == '*')
+                    {
+                        bool overridden = false;
+                        if (!AddPrefixRule(key, std::move(r), overridden))
+                        {
+                            LOGWARN("[Resolver] Ignoring wildcard key with '*' before its end: %s", key.c_str());
+                            continue;
+                        }
+                        if (overridden)
+                        {
+                            LOGTRACE("[Resolver] Overriding prefix rule for key: %s", key.c_str());
+                            overriddenCount++;
+                        }
+                        loadedCount++;
+                        continue;
+                    }
+
                     // Check if this resolution already exists (will be overridden)
                     if (mResolutions.find(key) != mResolutions.end())
                     {
@@ -127,8 +154,8 @@ namespace WPEFramework
                 }
             }
 
-            LOGINFO("[Resolver] Loaded %zu resolutions from %s (%zu new, %zu overridden). Total resolutions: %zu",
-                    loadedCount, path.c_str(), loadedCount - overriddenCount, overriddenCount, mResolutions.size());
+            LOGINFO("[Resolver] Loaded %zu resolutions from %s (%zu new, %zu overridden). Total resolutions: %zu exact, %zu prefix",
+                    loadedCount, path.c_str(), loadedCount - overriddenCount, overriddenCount, mResolutions.size(), mPrefixRules.size());
 
             return true;
         }
@@ -137,25 +164,306 @@ namespace WPEFramework
         {
             std::lock_guard<std::mutex> lock(mMutex);
             mResolutions.clear();
+            mPrefixTrie.clear();
+            mPrefixRules.clear();
             LOGINFO("[Resolver] Cleared all resolutions");
         }
 
         bool Resolver::IsConfigured()
         {
             std::lock_guard<std::mutex> lock(mMutex);
-            return !mResolutions.empty();
+            return !mResolutions.empty() || !mPrefixRules.empty();
+        }
+
+        // Bump whenever the Resolution record layout below changes
+        static constexpr uint32_t kSnapshotSchemaVersion = 1;
+
+        bool Resolver::SaveSnapshot(const std::string &path, const uint64_t fingerprint)
+        {
+            Utils::WarmSnapshot::Writer writer(kSnapshotSchemaVersion, fingerprint);
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                writer.Put(static_cast<uint32_t>(mResolutions.size()));
+                for (const auto &entry : mResolutions)
+                {
+                    PutResolution(writer, entry.first, entry.second);
+                }
+
+                // The trie does not keep keys; rebuild each rule's key from its path
+                writer.Put(static_cast<uint32_t>(mPrefixRules.size()));
+                std::vector<std::pair<uint32_t, std::string>> pending;
+                if (!mPrefixTrie.empty())
+                {
+                    pending.emplace_back(0, std::string());
+                }
+                while (!pending.empty())
+                {
+                    const std::pair<uint32_t, std::string> current = std::move(pending.back());
+                    pending.pop_back();
+                    const PrefixNode &node = mPrefixTrie[current.first];
+                    if (node.rule >= 0)
+                    {
+                        PutResolution(writer, current.second + "*", mPrefixRules[node.rule]);
+                    }
+                    for (const auto &child : node.children)
+                    {
+                        pending.emplace_back(child.second, current.second + child.first);
+                    }
+                }
+            }
+
+            if (!writer.Commit(path))
+            {
+                LOGWARN("[Resolver] Failed to write resolution snapshot: %s", path.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        bool Resolver::LoadSnapshot(const std::string &path, const uint64_t fingerprint)
+        {
+            Utils::WarmSnapshot::Reader reader;
+            if (!reader.Open(path, kSnapshotSchemaVersion, fingerprint))
+            {
+                return false;
+            }
+
+            // Decode everything before touching the tables, so a bad record leaves them as they were
+            std::vector<std::pair<std::string, Resolution>> exact;
+            std::vector<std::pair<std::string, Resolution>> prefix;
+            uint32_t count = 0;
+            for (std::vector<std::pair<std::string, Resolution>> *table : { &exact, &prefix })
+            {
+                if (!reader.Get(count))
+                {
+                    return false;
+                }
+                table->resize(count);
+                for (auto &entry : *table)
+                {
+                    if (!GetResolution(reader, entry.first, entry.second))
+                    {
+                        LOGWARN("[Resolver] Discarding malformed resolution snapshot: %s", path.c_str());
+                        return false;
+                    }
+                }
+            }
+            if (!reader.AtEnd())
+            {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            mResolutions.clear();
+            mPrefixTrie.clear();
+            mPrefixRules.clear();
+            mResolutions.reserve(exact.size());
+            for (auto &entry : exact)
+            {
+                mResolutions.emplace(std::move(entry.first), std::move(entry.second));
+            }
+            for (auto &entry : prefix)
+            {
+                bool overridden = false;
+                AddPrefixRule(entry.first, std::move(entry.second), overridden);
+            }
+            LOGINFO("[Resolver] Restored %zu exact and %zu prefix resolutions from snapshot %s",
+                    mResolutions.size(), mPrefixRules.size(), path.c_str());
+            return true;
+        }
+
+        void Resolver::PutResolution(Utils::WarmSnapshot::Writer &writer, const std::string &key, const Resolution &resolution)
+        {
+            // Kept as raw text whatever its type, so a warm start sees what the config said
+            std::string additionalContext;
+            if (resolution.additionalContext.IsSet())
+            {
+                resolution.additionalContext.ToString(additionalContext);
+            }
+            const uint32_t flags = (resolution.includeContext ? 0x1 : 0)
+                | (resolution.useComRpc ? 0x2 : 0)
+                | (resolution.versionedEvent ? 0x4 : 0);
+
+            writer.Put(key);
+            writer.Put(resolution.alias);
+            writer.Put(resolution.event);
+            writer.Put(resolution.permissionGroup);
+            writer.Put(additionalContext);
+            writer.Put(flags);
+            writer.Put(resolution.versionedEventName);
+            writer.Put((resolution.validator != nullptr) ? resolution.validator->Schema() : std::string());
+        }
+
+        bool Resolver::GetResolution(Utils::WarmSnapshot::Reader &reader, std::string &key, Resolution &resolution)
+        {
+            std::string additionalContext;
+            std::string schema;
+            uint32_t flags = 0;
+            if (!reader.Get(key) || !reader.Get(resolution.alias) || !reader.Get(resolution.event)
+                || !reader.Get(resolution.permissionGroup) || !reader.Get(additionalContext) || !reader.Get(flags)
+                || !reader.Get(resolution.versionedEventName) || !reader.Get(schema))
+            {
+                return false;
+            }
+            resolution.includeContext = (flags & 0x1) != 0;
+            resolution.useComRpc = (flags & 0x2) != 0;
+            resolution.versionedEvent = (flags & 0x4) != 0;
+
+            if (!additionalContext.empty() && !resolution.additionalContext.FromString(additionalContext))
+            {
+                return false;
+            }
+            if (!schema.empty())
+            {
+                WPEFramework::Core::JSON::VariantContainer object;
+                std::shared_ptr<Utils::ParamValidator> validator = std::make_shared<Utils::ParamValidator>();
+                std::string error;
+                if (!object.FromString(schema) || !validator->Compile(object, error))
+                {
+                    return false;
+                }
+                resolution.validator = validator;
+            }
+            return true;
         }
 
         std::string Resolver::ResolveAlias(const std::string &key)
         {
-            std::string lowerKey = StringUtils::toLower(key);
+            Utils::RequestArena::Scope scratch;
+            const std::string& lowerKey = Utils::RequestArena::Current().ToLower(key);
             std::lock_guard<std::mutex> lock(mMutex);
+            size_t matchedLength = 0;
+            const Resolution *resolution = FindResolution(lowerKey, matchedLength);
+            if (resolution == nullptr)
+            {
+                return {}; // return empty if not found
+            }
+            const std::string &alias = resolution->alias;
+            if (!alias.empty() && alias.back() == '*')
+            {
+                if (matchedLength == key.size())
+                {
+                    // "device." leaves no method name to forward; the raw "X.*" is not callable
+                    return {};
+                }
+                // "device.*" -> "org.rdk.System.*" forwards the unmatched tail of the
+                // method, in the caller's case, as the plugin method name
+                return alias.substr(0, alias.size() - 1) + key.substr(matchedLength);
+            }
+            return alias;
+        }
+
+        bool Resolver::AddPrefixRule(const std::string &lowerKey, Resolution &&resolution, bool &overridden)
+        {
+            const std::string prefix = lowerKey.substr(0, lowerKey.size() - 1);
+            if (prefix.find('*') != std::string::npos)
+            {
+                return false;
+            }
+            if (mPrefixTrie.empty())
+            {
+                mPrefixTrie.emplace_back();
+            }
+
+            uint32_t node = 0;
+            for (const char c : prefix)
+            {
+                std::vector<std::pair<char, uint32_t>> &children = mPrefixTrie[node].children;
+                auto child = std::lower_bound(children.begin(), children.end(), c,
+                    [](const std::pair<char, uint32_t> &entry, char value) { return entry.first < value; });
+                if (child != children.end() && child->first == c)
+                {
+                    node = child->second;
+                    continue;
+                }
+                const uint32_t next = static_cast<uint32_t>(mPrefixTrie.size());
+                children.insert(child, std::make_pair(c, next));
+                // emplace_back may reallocate, so children is not used past this point
+                mPrefixTrie.emplace_back();
+                node = next;
+            }
+
+            overridden = (mPrefixTrie[node].rule >= 0);
+            if (overridden)
+            {
+                mPrefixRules[mPrefixTrie[node].rule] = std::move(resolution);
+            }
+            else
+            {
+                mPrefixTrie[node].rule = static_cast<int32_t>(mPrefixRules.size());
+                mPrefixRules.push_back(std::move(resolution));
+            }
+            return true;
+        }
+
+        const Resolution *Resolver::FindResolution(const std::string &lowerKey, size_t &matchedLength) const
+        {
             auto it = mResolutions.find(lowerKey);
             if (it != mResolutions.end())
             {
-                return it->second.alias;
+                matchedLength = lowerKey.size();
+                return &it->second;
+            }
+            if (mPrefixTrie.empty())
+            {
+                return nullptr;
+            }
+
+            // Longest prefix wins: a "device.audio.*" rule takes precedence over "device.*"
+            int32_t rule = mPrefixTrie[0].rule;
+            matchedLength = 0;
+            uint32_t node = 0;
+            for (size_t index = 0; index < lowerKey.size(); ++index)
+            {
+                const std::vector<std::pair<char, uint32_t>> &children = mPrefixTrie[node].children;
+                auto child = std::lower_bound(children.begin(), children.end(), lowerKey[index],
+                    [](const std::pair<char, uint32_t> &entry, char value) { return entry.first < value; });
+                if (child == children.end() || child->first != lowerKey[index])
+                {
+                    break;
+                }
+                node = child->second;
+                if (mPrefixTrie[node].rule >= 0)
+                {
+                    rule = mPrefixTrie[node].rule;
+                    matchedLength = index + 1;
+                }
+            }
+            return (rule >= 0) ? &mPrefixRules[rule] : nullptr;
+        }
+
+        bool Resolver::ValidateParams(const std::string &key, const std::string &params, std::string &message)
+        {
+            std::shared_ptr<const Utils::ParamValidator> validator;
+            {
+                Utils::RequestArena::Scope scratch;
+                const std::string& lowerKey = Utils::RequestArena::Current().ToLower(key);
+                std::lock_guard<std::mutex> lock(mMutex);
+                size_t matchedLength = 0;
+                const Resolution *resolution = FindResolution(lowerKey, matchedLength);
+                if (resolution != nullptr)
+                {
+                    validator = resolution->validator;
+                }
             }
-            return {}; // return empty if not found
+            return (validator == nullptr) || validator->Validate(params, message);
+        }
+
+        std::shared_ptr<const Utils::ParamValidator> Resolver::CompileValidator(const std::string &key, const WPEFramework::Core::JSON::Variant &schema)
+        {
+            if (schema.Content() != WPEFramework::Core::JSON::Variant::type::OBJECT)
+            {
+                LOGERR("[Resolver] Ignoring 'params' schema for %s: not an object", key.c_str());
+                return nullptr;
+            }
+            std::shared_ptr<Utils::ParamValidator> validator = std::make_shared<Utils::ParamValidator>();
+            std::string error;
+            if (!validator->Compile(schema.Object(), error))
+            {
+                LOGERR("[Resolver] Ignoring 'params' schema for %s: %s", key.c_str(), error.c_str());
+                return nullptr;
+            }
+            return validator->IsEmpty() ? nullptr : validator;
         }
 
         void Resolver::ParseAlias(const std::string &alias, std::string &callsign, std::string &pluginMethod)
@@ -255,11 +563,13 @@ namespace WPEFramework
         bool Resolver::HasEvent(const std::string &key)
             {
                 std::lock_guard<std::mutex> lock(mMutex);
-                std::string lowerKey = StringUtils::toLower(key);
-                auto it = mResolutions.find(lowerKey);
-                if (it != mResolutions.end())
+                Utils::RequestArena::Scope scratch;
+                const std::string& lowerKey = Utils::RequestArena::Current().ToLower(key);
+                size_t matchedLength = 0;
+                const Resolution *resolution = FindResolution(lowerKey, matchedLength);
+                if (resolution != nullptr)
                 {
-                    return !it->second.event.empty();
+                    return !resolution->event.empty();
                 }
                 return false;
             }
@@ -267,48 +577,75 @@ namespace WPEFramework
         bool Resolver::HasIncludeContext(const std::string &key, JsonValue& additionalContext)
             {
                 std::lock_guard<std::mutex> lock(mMutex);
-                std::string lowerKey = StringUtils::toLower(key);
-                auto it = mResolutions.find(lowerKey);
-                if (it != mResolutions.end())
+                Utils::RequestArena::Scope scratch;
+                const std::string& lowerKey = Utils::RequestArena::Current().ToLower(key);
+                size_t matchedLength = 0;
+                const Resolution *resolution = FindResolution(lowerKey, matchedLength);
+                if (resolution != nullptr)
                 {
-                    if (it->second.additionalContext.IsSet()) {
-                        additionalContext = it->second.additionalContext;
+                    if (resolution->additionalContext.IsSet()) {
+                        additionalContext = resolution->additionalContext;
                     }
-                    return it->second.includeContext;
+                    return resolution->includeContext;
                 }
                 return false;
             }
 
         bool Resolver::HasComRpcRequestSupport(const std::string &key) {
-            std::string lowerKey = StringUtils::toLower(key);
+            Utils::RequestArena::Scope scratch;
+            const std::string& lowerKey = Utils::RequestArena::Current().ToLower(key);
             std::lock_guard<std::mutex> lock(mMutex);
-            auto it = mResolutions.find(lowerKey);
-            if (it != mResolutions.end())
+            size_t matchedLength = 0;
+            const Resolution *resolution = FindResolution(lowerKey, matchedLength);
+            if (resolution != nullptr)
             {
-                return it->second.useComRpc;
+                return resolution->useComRpc;
             }
             return false;
         }
 
         bool Resolver::IsVersionedEvent(const std::string &key) {
-            std::string lowerKey = StringUtils::toLower(key);
+            Utils::RequestArena::Scope scratch;
+            const std::string& lowerKey = Utils::RequestArena::Current().ToLower(key);
             std::lock_guard<std::mutex> lock(mMutex);
-            auto it = mResolutions.find(lowerKey);
-            if (it != mResolutions.end())
+            size_t matchedLength = 0;
+            const Resolution *resolution = FindResolution(lowerKey, matchedLength);
+            if (resolution != nullptr)
             {
-                return it->second.versionedEvent;
+                return resolution->versionedEvent;
             }
             return false;
         }
 
+        std::string Resolver::ResolveEventName(const std::string &key, const std::string &version) {
+            if (!ContextUtils::IsRDK8Compliant(version)) {
+                return key;
+            }
+            Utils::RequestArena::Scope scratch;
+            const std::string& lowerKey = Utils::RequestArena::Current().ToLower(key);
+            std::lock_guard<std::mutex> lock(mMutex);
+            size_t matchedLength = 0;
+            const Resolution *resolution = FindResolution(lowerKey, matchedLength);
+            if (resolution != nullptr && resolution->versionedEvent)
+            {
+                // Prefix rules have no single label to precompute the name from
+                return resolution->versionedEventName.empty()
+                    ? ContextUtils::GetRDK8VersionedEventName(key)
+                    : resolution->versionedEventName;
+            }
+            return key;
+        }
+
         bool Resolver::HasPermissionGroup(const std::string& key, std::string& permissionGroup )
         {
             std::lock_guard<std::mutex> lock(mMutex);
-            std::string lowerKey = StringUtils::toLower(key);
-            auto it = mResolutions.find(lowerKey);
-            if (it != mResolutions.end())
+            Utils::RequestArena::Scope scratch;
+            const std::string& lowerKey = Utils::RequestArena::Current().ToLower(key);
+            size_t matchedLength = 0;
+            const Resolution *resolution = FindResolution(lowerKey, matchedLength);
+            if (resolution != nullptr)
             {
-                permissionGroup = it->second.permissionGroup;
+                permissionGroup = resolution->permissionGroup;
                 return !permissionGroup.empty();
             }
             return false;
@@ -22,7 +22,11 @@
 #include "Module.h"
 #include "UtilsLogging.h"
 #include "StringUtils.h"
+#include "ParamValidator.h"
+#include "UtilsWarmSnapshot.h"
+#include <memory>
 #include <unordered_map>
+#include <vector>
 #include <mutex>
 #include <core/Enumerate.h>
 
@@ -57,6 +61,11 @@ namespace WPEFramework
             bool includeContext = false;
             bool useComRpc = false;
             bool versionedEvent = false;
+            // RDK8 event name precomputed at load time for versioned events
+            std::string versionedEventName;
+            // Compiled from the optional "params" schema; shared so a lookup can
+            // release the resolver lock before validating
+            std::shared_ptr<const Utils::ParamValidator> validator;
         };
 
 
@@ -77,6 +86,14 @@ namespace WPEFramework
             // Check if resolver has been properly configured
             bool IsConfigured();
 
+            // Writes the loaded tables to a warm-start snapshot tagged with the
+            // fingerprint of the config files they were loaded from
+            bool SaveSnapshot(const std::string &path, const uint64_t fingerprint);
+
+            // Replaces the tables with a snapshot written for the same fingerprint;
+            // false, leaving the tables untouched, if it is missing or stale
+            bool LoadSnapshot(const std::string &path, const uint64_t fingerprint);
+
             std::string ResolveAlias(const std::string &request);
             Core::hresult CallThunderPlugin(const std::string &alias, const std::string &params, std::string &response);
 
@@ -95,9 +112,30 @@ namespace WPEFramework
             // New method to check if the event is version based
             bool IsVersionedEvent(const std::string &key);
 
+            // Returns the event name to subscribe with for the given Firebolt version;
+            // the precomputed versioned name for versioned events, otherwise the key itself
+            std::string ResolveEventName(const std::string &key, const std::string &version);
+
+            // Checks params against the method's "params" schema, if it has one; on
+            // failure message holds the reason to return to the caller
+            bool ValidateParams(const std::string &key, const std::string &params, std::string &message);
+
         private:
             void ParseAlias(const std::string &alias, std::string &callsign, std::string &pluginMethod);
 
+            // Adds a trailing-'*' key ("device.*", "device*", "*") as a prefix rule
+            bool AddPrefixRule(const std::string &lowerKey, Resolution &&resolution, bool &overridden);
+
+            // Exact match first, then the longest matching prefix rule; mMutex must be held.
+            // matchedLength is the number of key characters consumed by the match.
+            const Resolution *FindResolution(const std::string &lowerKey, size_t &matchedLength) const;
+
+            static void PutResolution(Utils::WarmSnapshot::Writer &writer, const std::string &key, const Resolution &resolution);
+            static bool GetResolution(Utils::WarmSnapshot::Reader &reader, std::string &key, Resolution &resolution);
+
+            // Compiles a "params" schema; nullptr (logged) if it is absent or unusable
+            static std::shared_ptr<const Utils::ParamValidator> CompileValidator(const std::string &key, const WPEFramework::Core::JSON::Variant &schema);
+
             // Helper function to extract string field from JSON variant with type checking
             static std::string ExtractStringField(const WPEFramework::Core::JSON::VariantContainer &obj, const char *fieldName);
 
@@ -108,6 +146,16 @@ namespace WPEFramework
             
             PluginHost::IShell *mService;
             std::unordered_map<std::string, Resolution> mResolutions;
+
+            // Prefix rules compiled into a byte trie; node 0 is the root and each node
+            // keeps its children sorted by character, so a lookup is O(key length)
+            struct PrefixNode
+            {
+                std::vector<std::pair<char, uint32_t>> children;
+                int32_t rule = -1;
+            };
+            std::vector<PrefixNode> mPrefixTrie;
+            std::vector<Resolution> mPrefixRules;
             std::mutex mMutex;
         };
 
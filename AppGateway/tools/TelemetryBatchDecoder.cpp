@@ -0,0 +1,74 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// agw-telemetry-decode: expands ENTS_INFO_AppGwTelemetryBatch payloads back into the
+// per-marker JSON events AppGateway sends in TelemetryFormat::JSON.
+//
+// Reads one chunk per line from stdin ("<seq>.<part>/<parts>:<base64>", optionally
+// preceded by anything up to and including "payload="), groups chunks by sequence and
+// prints "marker=<marker>, payload=<json>" for every record once a batch is complete.
+
+#include "../AppGatewayTelemetryCodec.h"
+
+#include <iostream>
+#include <map>
+
+using namespace WPEFramework::Plugin;
+
+int main()
+{
+    std::map<uint32_t, std::vector<std::string>> pending;
+    int status = 0;
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        const size_t prefix = line.find("payload=");
+        std::string chunk = (prefix == std::string::npos) ? line : line.substr(prefix + 8);
+        while (!chunk.empty() && (chunk.back() == '\r' || chunk.back() == ' ')) {
+            chunk.pop_back();
+        }
+        unsigned sequence = 0;
+        unsigned part = 0;
+        unsigned parts = 0;
+        if (chunk.empty() || std::sscanf(chunk.c_str(), "%u.%u/%u:", &sequence, &part, &parts) != 3) {
+            continue;
+        }
+        std::vector<std::string>& chunks = pending[sequence];
+        chunks.push_back(chunk);
+        if (chunks.size() < parts) {
+            continue;
+        }
+
+        std::vector<TelemetryBatchDecoder::Event> events;
+        std::string error;
+        if (TelemetryBatchDecoder::DecodeChunks(chunks, events, error)) {
+            for (const TelemetryBatchDecoder::Event& event : events) {
+                std::cout << "marker=" << event.first << ", payload=" << event.second << std::endl;
+            }
+        } else {
+            std::cerr << "batch " << sequence << ": " << error << std::endl;
+            status = 1;
+        }
+        pending.erase(sequence);
+    }
+    for (const auto& batch : pending) {
+        std::cerr << "batch " << batch.first << ": incomplete (" << batch.second.size() << " chunks)" << std::endl;
+        status = 1;
+    }
+    return status;
+}
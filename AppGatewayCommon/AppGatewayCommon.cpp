@@ -30,6 +30,17 @@
 #define API_VERSION_NUMBER_MINOR    APPGATEWAYCOMMON_MINOR_VERSION
 #define API_VERSION_NUMBER_PATCH    APPGATEWAYCOMMON_PATCH_VERSION
 
+// App metrics summaries are pushed to AppGateway telemetry at most this often,
+// one ENTS_INFO_AppGwAppMetric event per (app, metric) pair used in the interval.
+#ifndef APP_METRICS_FLUSH_INTERVAL_MS
+#define APP_METRICS_FLUSH_INTERVAL_MS (60 * 1000)
+#endif
+
+// Deinitialize reports registrations that outlast this; it still waits for them
+#ifndef APP_JOB_DRAIN_REPORT_MS
+#define APP_JOB_DRAIN_REPORT_MS 2000
+#endif
+
 AGW_DEFINE_TELEMETRY_CLIENT(AGW_PLUGIN_APPGATEWAYCOMMON)
 
 namespace WPEFramework {
@@ -69,6 +80,7 @@ namespace Plugin {
 
         mShell = service;
         mShell->AddRef();
+        mJobs.Resume();
 
         AGW_TELEMETRY_INIT(mShell);
         AGW_RECORD_BOOTSTRAP_TIME();
@@ -91,11 +103,16 @@ namespace Plugin {
         // may be blocked inside Thunder Subscribe() calls (up to the
         // SYSTEM_DELEGATE_SUBSCRIBE_TIMEOUT_MS timeout).  Destroying the
         // delegate while a job is executing causes use-after-free.
-        {
-            std::unique_lock<std::mutex> lk(mJobDrainMutex);
-            mJobDrainCv.wait(lk, [this] { return mActiveJobs.load(std::memory_order_acquire) == 0; });
+        // No new jobs are admitted from here on.
+        mJobs.Begin();
+        if (!mJobs.Wait(APP_JOB_DRAIN_REPORT_MS)) {
+            LOGWARN("Deinitialize: %u jobs still running after %u ms, waiting for them", mJobs.Jobs(), APP_JOB_DRAIN_REPORT_MS);
+            mJobs.WaitIdle();
         }
 
+        // Push whatever was recorded since the last interval while telemetry is still up
+        FlushAppMetrics();
+
         mDelegate->Cleanup();
         // Clean up the delegate
         mDelegate.reset();
@@ -428,12 +445,9 @@ namespace Plugin {
                 result = "{\"error\":\"Invalid payload: 'value' field must be a string or array\"}";
                 return Core::ERROR_BAD_REQUEST;
             }
-            // lowermethod starts with metrics. just log the payload for now, as this is only used for RDK8 compliance and there are no specific requirements around handling this event for RDK8 compliance other than not returning an error when it's received.
             else if (lowerMethod.rfind("metrics.", 0) == 0)
             {
-                LOGINFO("Received %s event. AppId: %s, Payload: %s", method.c_str(), context.appId.c_str(), payload.c_str());
-                result = "null";
-                return Core::ERROR_NONE; // No-op for now, as this is only used for RDK8 compliance which requires no action on the AppGatewayCommon side when this event is received.
+                return RecordAppMetric(context, lowerMethod, payload, result);
             }
 
             // If method not found, return error
@@ -480,11 +494,62 @@ namespace Plugin {
                 return false;
             }
 
-            mActiveJobs.fetch_add(1, std::memory_order_acq_rel);
+            if (!mJobs.AdmitJob()) {
+                LOGERR("SafeSubmitEventRegistrationJob: Shutting down, not registering %s", event.c_str());
+                return false;
+            }
             Core::IWorkerPool::Instance().Submit(job);
             return true;
         }
 
+        Core::hresult AppGatewayCommon::RecordAppMetric(const Exchange::GatewayContext& context, const string& method,
+                                                        const string& payload, string& result)
+        {
+            // No per-call logging: apps send these at high rates
+            mMetricsSink.Record(context.appId, method.substr(sizeof("metrics.") - 1), payload);
+
+            const uint64_t nowMs = Core::Time::Now().Ticks() / Core::Time::TicksPerMillisecond;
+            // While shutting down the summaries are flushed by Deinitialize instead
+            if (mMetricsSink.FlushDue(nowMs, APP_METRICS_FLUSH_INTERVAL_MS) && mJobs.AdmitJob()) {
+                Core::IWorkerPool::Instance().Submit(MetricsFlushJob::Create(this));
+            }
+
+            result = "null";
+            return Core::ERROR_NONE;
+        }
+
+        void AppGatewayCommon::FlushAppMetrics()
+        {
+            std::vector<AppMetricsSink::Summary> summaries;
+            mMetricsSink.Drain(summaries);
+            if (summaries.empty()) {
+                return;
+            }
+
+            const uint32_t dropped = mMetricsSink.Dropped();
+            LOGINFO("Flushing %zu app metric summaries (dropped so far: %u)", summaries.size(), dropped);
+            for (const auto& summary : summaries) {
+                Exchange::GatewayContext context;
+                context.requestId = 0;
+                context.connectionId = 0;
+                context.appId = summary.appId;
+
+                JsonObject payload;
+                payload["metric"] = summary.metric;
+                payload["count"] = summary.count;
+                if (summary.valueCount > 0) {
+                    payload["mean"] = summary.mean;
+                    payload["max"] = summary.max;
+                    payload["p50"] = summary.p50;
+                    payload["p95"] = summary.p95;
+                }
+                payload["dropped"] = dropped;
+                string data;
+                payload.ToString(data);
+                AGW_REPORT_EVENT(context, AGW_MARKER_APP_METRIC, data);
+            }
+        }
+
         // Delegated alias methods
 
         Core::hresult AppGatewayCommon::GetDeviceMake(string &make)
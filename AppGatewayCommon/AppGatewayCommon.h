@@ -28,6 +28,8 @@
 #include "UtilsLogging.h"
 #include "UtilsController.h"
 #include "delegate/SettingsDelegate.h"
+#include "AppMetricsSink.h"
+#include "UtilsDrainTracker.h"
 #include <unordered_map>
 #include <functional>
 
@@ -75,14 +77,8 @@ namespace WPEFramework {
                 virtual void Dispatch()
                 {
                     mParent.mDelegate->HandleAppEventNotifier(mCallback, mEvent, mListen);
-                    // fetch_sub returns the previous value; if it was 1 the
-                    // counter is now 0 (last in-flight job finished). Lock
-                    // the mutex so the notify wakes up Deinitialize's
-                    // wait — this ensures the signal is never missed.
-                    if (1 == mParent.mActiveJobs.fetch_sub(1, std::memory_order_acq_rel)) {
-                        std::lock_guard<std::mutex> lk(mParent.mJobDrainMutex);
-                        mParent.mJobDrainCv.notify_all();
-                    }
+                    // The last job to finish wakes up Deinitialize's drain
+                    mParent.mJobs.JobDone();
                 }
 
             private:
@@ -93,6 +89,31 @@ namespace WPEFramework {
 
         };
 
+        class EXTERNAL MetricsFlushJob : public Core::IDispatch
+        {
+            protected:
+                MetricsFlushJob(AppGatewayCommon *parent): mParent(*parent) {}
+            public:
+                MetricsFlushJob() = delete;
+                MetricsFlushJob(const MetricsFlushJob &) = delete;
+                MetricsFlushJob &operator=(const MetricsFlushJob &) = delete;
+                ~MetricsFlushJob() {}
+
+                static Core::ProxyType<Core::IDispatch> Create(AppGatewayCommon *parent)
+                {
+                    return (Core::ProxyType<Core::IDispatch>(Core::ProxyType<MetricsFlushJob>::Create(parent)));
+                }
+                virtual void Dispatch()
+                {
+                    mParent.FlushAppMetrics();
+                    // Same drain accounting as EventRegistrationJob
+                    mParent.mJobs.JobDone();
+                }
+
+            private:
+            AppGatewayCommon &mParent;
+        };
+
 
         public:
             AppGatewayCommon();
@@ -200,16 +221,19 @@ namespace WPEFramework {
             Core::hresult GetDisplayEdid(string &result /* @out */);
             Core::hresult GetDisplaySize(string &result /* @out */);
             Core::hresult GetDisplayMaxResolution(string &result /* @out */);
+            // Records one metrics.* call; summaries are pushed to telemetry once per flush interval
+            Core::hresult RecordAppMetric(const Exchange::GatewayContext& context, const string& method, const string& payload, string& result);
+            void FlushAppMetrics();
         private:
             PluginHost::IShell* mShell;
             uint32_t mConnectionId;
             std::shared_ptr<SettingsDelegate> mDelegate;
+            AppMetricsSink mMetricsSink;
 
             // Track in-flight EventRegistrationJobs so Deinitialize() can
-            // wait for them before destroying the delegate.
-            std::atomic<int> mActiveJobs{0};
-            std::mutex mJobDrainMutex;
-            std::condition_variable mJobDrainCv;
+            // wait for them before destroying the delegate; no new ones are
+            // admitted once it has started draining.
+            Utils::DrainTracker mJobs;
         };
 	} // namespace Plugin
 } // namespace WPEFramework
@@ -0,0 +1,363 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Aggregates app-reported metrics.* calls per (appId, metric) without locks.
+    // Slots live in a fixed open-addressing table and are claimed once with a CAS;
+    // after that every Record() is a handful of relaxed atomic increments. Numeric
+    // payload values go into a log2 histogram so Drain() can report count, mean,
+    // max and approximate p50/p95 per slot. A slot that saw no call during a whole
+    // drain interval is given back, so the table holds the pairs apps are using
+    // now rather than every pair ever seen; pairs beyond the capacity within one
+    // interval are counted as dropped rather than allocated.
+    class AppMetricsSink {
+    public:
+        enum : uint32_t {
+            Capacity = 256,
+            Buckets = 24
+        };
+
+        struct Summary {
+            std::string appId;
+            std::string metric;
+            uint32_t count;
+            uint32_t valueCount;
+            double mean;
+            double max;
+            double p50;
+            double p95;
+        };
+
+        AppMetricsSink()
+            : mSlots()
+            , mDrainLock()
+            , mDropped(0)
+            , mNextFlushMs(0)
+        {
+        }
+
+        AppMetricsSink(const AppMetricsSink&) = delete;
+        AppMetricsSink& operator=(const AppMetricsSink&) = delete;
+
+        // Parses the payload once and records the first numeric value field, if any
+        bool Record(const std::string& appId, const std::string& metric, const std::string& payload)
+        {
+            double value = 0.0;
+            return Record(appId, metric, ExtractValue(payload, value), value);
+        }
+
+        bool Record(const std::string& appId, const std::string& metric, const bool hasValue, const double value)
+        {
+            Slot* slot = Acquire(appId, metric);
+            if (slot == nullptr) {
+                mDropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            slot->count.fetch_add(1, std::memory_order_relaxed);
+            if (hasValue && std::isfinite(value)) {
+                const uint64_t scaled = Scale(value);
+                slot->valueCount.fetch_add(1, std::memory_order_relaxed);
+                slot->sum.fetch_add(scaled, std::memory_order_relaxed);
+                uint64_t current = slot->max.load(std::memory_order_relaxed);
+                while (scaled > current && !slot->max.compare_exchange_weak(current, scaled, std::memory_order_relaxed)) {
+                }
+                slot->buckets[Bucket(scaled)].fetch_add(1, std::memory_order_relaxed);
+            }
+            slot->users.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+
+        // True for exactly one caller once the interval has elapsed
+        bool FlushDue(const uint64_t nowMs, const uint64_t intervalMs)
+        {
+            uint64_t next = mNextFlushMs.load(std::memory_order_relaxed);
+            if (next == 0) {
+                mNextFlushMs.compare_exchange_strong(next, nowMs + intervalMs, std::memory_order_relaxed);
+                return false;
+            }
+            return (nowMs >= next) && mNextFlushMs.compare_exchange_strong(next, nowMs + intervalMs, std::memory_order_relaxed);
+        }
+
+        // Moves the counters accumulated since the last drain into summaries and
+        // frees the slots that were idle for the whole interval
+        void Drain(std::vector<Summary>& summaries)
+        {
+            std::lock_guard<std::mutex> guard(mDrainLock);
+
+            // A pair whose slot was freed while a Record() still probed past it may
+            // briefly have two slots; their counters are merged here
+            std::map<std::pair<std::string, std::string>, Totals> totals;
+            for (uint32_t index = 0; index < Capacity; ++index) {
+                Slot& slot = mSlots[index];
+                if (slot.state.load(std::memory_order_acquire) != Ready) {
+                    continue;
+                }
+                const uint32_t count = slot.count.exchange(0, std::memory_order_relaxed);
+                if (count == 0) {
+                    Reclaim(slot);
+                    continue;
+                }
+                Totals& entry = totals[std::make_pair(slot.appId, slot.metric)];
+                entry.count += count;
+                entry.valueCount += slot.valueCount.exchange(0, std::memory_order_relaxed);
+                entry.sum += slot.sum.exchange(0, std::memory_order_relaxed);
+                const uint64_t max = slot.max.exchange(0, std::memory_order_relaxed);
+                entry.max = (max > entry.max) ? max : entry.max;
+                for (uint32_t bucket = 0; bucket < Buckets; ++bucket) {
+                    entry.histogram[bucket] += slot.buckets[bucket].exchange(0, std::memory_order_relaxed);
+                }
+            }
+
+            for (const auto& entry : totals) {
+                Summary summary;
+                summary.appId = entry.first.first;
+                summary.metric = entry.first.second;
+                summary.count = entry.second.count;
+                summary.valueCount = entry.second.valueCount;
+                summary.max = entry.second.max / 1000.0;
+                summary.mean = (summary.valueCount > 0) ? (entry.second.sum / 1000.0) / summary.valueCount : 0.0;
+                summary.p50 = Percentile(entry.second.histogram, summary.valueCount, 50, summary.max);
+                summary.p95 = Percentile(entry.second.histogram, summary.valueCount, 95, summary.max);
+                summaries.push_back(std::move(summary));
+            }
+        }
+
+        // Slots currently holding a pair
+        uint32_t InUse() const
+        {
+            uint32_t used = 0;
+            for (uint32_t index = 0; index < Capacity; ++index) {
+                used += (mSlots[index].hash.load(std::memory_order_relaxed) != 0) ? 1 : 0;
+            }
+            return used;
+        }
+
+        uint32_t Dropped() const
+        {
+            return mDropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        enum : uint32_t {
+            Empty = 0,
+            Ready = 1,
+            Retiring = 2
+        };
+
+        struct Totals {
+            Totals()
+                : count(0), valueCount(0), sum(0), max(0), histogram()
+            {
+            }
+
+            uint32_t count;
+            uint32_t valueCount;
+            uint64_t sum;
+            uint64_t max;
+            uint32_t histogram[Buckets];
+        };
+
+        struct Slot {
+            Slot()
+                : hash(0), state(Empty), users(0), appId(), metric(), count(0), valueCount(0), sum(0), max(0)
+            {
+                for (uint32_t bucket = 0; bucket < Buckets; ++bucket) {
+                    buckets[bucket].store(0, std::memory_order_relaxed);
+                }
+            }
+
+            std::atomic<uint64_t> hash;
+            std::atomic<uint32_t> state;
+            // Record() calls between finding the slot and finishing their update
+            std::atomic<uint32_t> users;
+            // Written by the claiming thread before state becomes Ready, cleared by
+            // Reclaim() once no Record() can still be reading them
+            std::string appId;
+            std::string metric;
+            std::atomic<uint32_t> count;
+            std::atomic<uint32_t> valueCount;
+            std::atomic<uint64_t> sum;
+            std::atomic<uint64_t> max;
+            std::atomic<uint32_t> buckets[Buckets];
+        };
+
+        static uint64_t Hash(const std::string& appId, const std::string& metric)
+        {
+            // FNV-1a over "appId\0metric"; 0 is reserved for empty slots
+            uint64_t hash = 14695981039346656037ULL;
+            for (const char c : appId) {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+            }
+            hash = (hash ^ 0) * 1099511628211ULL;
+            for (const char c : metric) {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+            }
+            return (hash == 0) ? 1 : hash;
+        }
+
+        // Returns the pair's slot with a user reference the caller drops when done
+        Slot* Acquire(const std::string& appId, const std::string& metric)
+        {
+            const uint64_t hash = Hash(appId, metric);
+            for (uint32_t probe = 0; probe < Capacity; ++probe) {
+                Slot& slot = mSlots[(hash + probe) % Capacity];
+                // Announced before the slot is inspected, so Reclaim() either sees
+                // this user or this thread sees the slot retiring (both seq_cst)
+                slot.users.fetch_add(1, std::memory_order_seq_cst);
+                uint64_t current = slot.hash.load(std::memory_order_seq_cst);
+                if (current == 0) {
+                    if (slot.hash.compare_exchange_strong(current, hash, std::memory_order_seq_cst)) {
+                        slot.appId = appId;
+                        slot.metric = metric;
+                        slot.state.store(Ready, std::memory_order_seq_cst);
+                        return &slot;
+                    }
+                    // Lost the race; current now holds the winner's hash
+                }
+                if (current == hash) {
+                    // The claiming thread publishes the key strings right after its CAS;
+                    // a slot being freed goes back to hash 0 instead
+                    uint32_t state = slot.state.load(std::memory_order_seq_cst);
+                    while (state == Empty && slot.hash.load(std::memory_order_seq_cst) == hash) {
+                        std::this_thread::yield();
+                        state = slot.state.load(std::memory_order_seq_cst);
+                    }
+                    if (state == Ready && slot.appId == appId && slot.metric == metric) {
+                        return &slot;
+                    }
+                }
+                slot.users.fetch_sub(1, std::memory_order_release);
+            }
+            return nullptr;
+        }
+
+        // Frees a slot that saw no Record() since the last drain, unless one is
+        // under way right now; it is then tried again at the next drain
+        void Reclaim(Slot& slot)
+        {
+            uint32_t expected = Ready;
+            if (!slot.state.compare_exchange_strong(expected, Retiring, std::memory_order_seq_cst)) {
+                return;
+            }
+            if (slot.users.load(std::memory_order_seq_cst) != 0 || slot.count.load(std::memory_order_acquire) != 0) {
+                slot.state.store(Ready, std::memory_order_seq_cst);
+                return;
+            }
+            slot.appId.clear();
+            slot.metric.clear();
+            slot.valueCount.store(0, std::memory_order_relaxed);
+            slot.sum.store(0, std::memory_order_relaxed);
+            slot.max.store(0, std::memory_order_relaxed);
+            for (uint32_t bucket = 0; bucket < Buckets; ++bucket) {
+                slot.buckets[bucket].store(0, std::memory_order_relaxed);
+            }
+            slot.state.store(Empty, std::memory_order_seq_cst);
+            slot.hash.store(0, std::memory_order_seq_cst);
+        }
+
+        // Values are kept in thousandths so fractional progress survives; whatever an
+        // app sends is clamped to [0, UINT64_MAX / 1000] before it is converted
+        static uint64_t Scale(const double value)
+        {
+            static constexpr uint64_t Largest = UINT64_MAX / 1000;
+            if (!(value > 0.0)) {
+                return 0;
+            }
+            if (value >= static_cast<double>(Largest)) {
+                return Largest * 1000;
+            }
+            return static_cast<uint64_t>(value * 1000.0 + 0.5);
+        }
+
+        static uint32_t Bucket(const uint64_t scaled)
+        {
+            // Bucket 0 holds values below 1.0, bucket n holds [2^(n-1), 2^n)
+            uint64_t whole = scaled / 1000;
+            uint32_t bucket = 0;
+            while (whole > 0 && bucket < (Buckets - 1)) {
+                whole >>= 1;
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        static double Percentile(const uint32_t histogram[], const uint32_t total, const uint32_t percent, const double max)
+        {
+            if (total == 0) {
+                return 0.0;
+            }
+            const uint64_t rank = (static_cast<uint64_t>(total) * percent + 99) / 100;
+            uint64_t seen = 0;
+            for (uint32_t bucket = 0; bucket < Buckets; ++bucket) {
+                seen += histogram[bucket];
+                if (seen >= rank) {
+                    // Upper bound of the bucket, never above the observed maximum
+                    const double upper = (bucket == 0) ? 1.0 : static_cast<double>(1ULL << bucket);
+                    return (upper < max) ? upper : max;
+                }
+            }
+            return max;
+        }
+
+        static bool ExtractValue(const std::string& payload, double& value)
+        {
+            static const char* const fields[] = { "progress", "position", "duration", "value" };
+            JsonObject params;
+            if (payload.empty() || !params.FromString(payload)) {
+                return false;
+            }
+            for (const char* field : fields) {
+                if (params.HasLabel(field)) {
+                    const Core::JSON::Variant& entry = params[field];
+                    if (entry.Content() == Core::JSON::Variant::type::NUMBER) {
+                        value = static_cast<double>(entry.Number());
+                        return true;
+                    }
+                    if (entry.Content() == Core::JSON::Variant::type::FLOAT) {
+                        value = entry.Float();
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        Slot mSlots[Capacity];
+        std::mutex mDrainLock;
+        std::atomic<uint32_t> mDropped;
+        std::atomic<uint64_t> mNextFlushMs;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
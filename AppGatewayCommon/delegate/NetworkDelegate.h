@@ -31,6 +31,8 @@
 #include <set>
 #include "ObjectUtils.h"
 #include "UtilsFirebolt.h"
+#include "UtilsInterfaceCache.h"
+#include <memory>
 #include <mutex>
 
 using namespace WPEFramework;
@@ -43,32 +45,28 @@ static const std::set<string> VALID_NETWORK_EVENT = {
     "network.onconnectedchanged"
 };
 
-class NetworkDelegate : public BaseEventDelegate
+class NetworkDelegate : public BaseEventDelegate, private WPEFramework::Utils::InterfaceCache::IObserver
 {
 public:
-    NetworkDelegate(PluginHost::IShell *shell)
-        : BaseEventDelegate(), mNetworkManager(nullptr), mShell(shell), mNotificationHandler(*this)
+    // interfaces, when given, reports NetworkManager going away so the interface,
+    // the notification registration and the snapshot are dropped with it
+    NetworkDelegate(PluginHost::IShell *shell, const std::shared_ptr<WPEFramework::Utils::InterfaceCache>& interfaces = nullptr)
+        : BaseEventDelegate(), mNetworkManager(nullptr), mShell(shell), mInterfaces(interfaces), mNotificationHandler(*this),
+          mSnapshotMutex(), mSnapshotGeneration(0), mConnectedValid(false), mConnectedSnapshot(),
+          mInternetStatusValid(false), mInternetStatusSnapshot()
     {
+        if (mInterfaces) {
+            mInterfaces->Watch(this);
+        }
     }
 
     ~NetworkDelegate()
     {
-        Core::SafeSyncType<Core::CriticalSection> lock(mNetworkManagerLock);
-        if (nullptr != mNetworkManager)
-        {
-            {
-                std::lock_guard<std::mutex> lock(mRegistrationMutex);
-                if (mNotificationHandler.GetRegistered())
-                {
-                    mNetworkManager->Unregister(&mNotificationHandler);
-                    mNotificationHandler.SetRegistered(false);
-                }
-            }
-            mNetworkManager->Release();
-            mNetworkManager = nullptr;
+        if (mInterfaces) {
+            mInterfaces->Unwatch(this);
+            mInterfaces.reset();
         }
-
-        
+        ReleaseNetworkManager();
     }
 
     bool HandleSubscription(Exchange::IAppNotificationHandler::IEmitter *cb, const string &event, const bool listen)
@@ -83,19 +81,8 @@ public:
             }
 
             AddNotification(event, cb);
-            {
-                std::lock_guard<std::mutex> lock(mRegistrationMutex);
-                if (!mNotificationHandler.GetRegistered())
-                {
-                    LOGINFO("Registering for NetworkManager notifications");
-                    networkManager->Register(&mNotificationHandler);
-                    mNotificationHandler.SetRegistered(true);
-                }
-                else
-                {
-                    LOGTRACE("Is NetworkManager registered = %s", mNotificationHandler.GetRegistered() ? "true" : "false");
-                }
-            }
+            EnsureRegistered(networkManager);
+            networkManager->Release();
             return true;
         }
         else
@@ -120,7 +107,8 @@ public:
         return false;
     }
 
-    // Common method to ensure mNetworkManager is available for all APIs
+    // Common method to ensure mNetworkManager is available for all APIs; the caller
+    // releases the returned interface, it may be dropped meanwhile if NetworkManager goes away
     Exchange::INetworkManager *GetNetworkManagerInterface()
     {
         Core::SafeSyncType<Core::CriticalSection> lock(mNetworkManagerLock);
@@ -133,6 +121,9 @@ public:
                 LOGINFO("NetworkManager COM interface acquired successfully");
             }
         }
+        if (nullptr != mNetworkManager) {
+            mNetworkManager->AddRef();
+        }
         return mNetworkManager;
     }
 
@@ -146,12 +137,31 @@ public:
             return Core::ERROR_UNAVAILABLE;
         }
 
+        // Served from the snapshot kept current by onActiveInterfaceChange
+        const bool registered = EnsureRegistered(networkManager);
+        uint64_t generation = 0;
+        {
+            std::lock_guard<std::mutex> lock(mSnapshotMutex);
+            if (registered && mConnectedValid) {
+                networkManager->Release();
+                result = mConnectedSnapshot;
+                return Core::ERROR_NONE;
+            }
+            generation = mSnapshotGeneration;
+        }
+
         string interface;
         Core::hresult rc = networkManager->GetPrimaryInterface(interface);
+        networkManager->Release();
         if (rc == Core::ERROR_NONE) {
             // Transform the response: return_or_error(.result, "couldn't get network connected status")
             // Return the boolean result directly as per transform specification
             result = interface.empty() ? "false" : "true";
+            std::lock_guard<std::mutex> lock(mSnapshotMutex);
+            if (registered && generation == mSnapshotGeneration) {
+                mConnectedSnapshot = result;
+                mConnectedValid = true;
+            }
             return Core::ERROR_NONE;
         } else {
             LOGERR("Failed to get primary interface on NetworkManager, error: %u", rc);
@@ -182,9 +192,23 @@ public:
             return Core::ERROR_UNAVAILABLE;
         }
 
+        // Served from the snapshot until an interface or internet status event invalidates it
+        const bool registered = EnsureRegistered(networkManager);
+        uint64_t generation = 0;
+        {
+            std::lock_guard<std::mutex> lock(mSnapshotMutex);
+            if (registered && mInternetStatusValid) {
+                networkManager->Release();
+                result = mInternetStatusSnapshot;
+                return Core::ERROR_NONE;
+            }
+            generation = mSnapshotGeneration;
+        }
+
         // Get available interfaces
         Exchange::INetworkManager::IInterfaceDetailsIterator *interfaces = nullptr;
         uint32_t rc = networkManager->GetAvailableInterfaces(interfaces);
+        networkManager->Release();
 
         if (rc != Core::ERROR_NONE)
         {
@@ -197,6 +221,7 @@ public:
         {
             LOGERR("GetAvailableInterfaces returned null iterator");
             result = "{}";
+            StoreInternetStatus(result, registered, generation);
             return Core::ERROR_NONE;
         }
 
@@ -244,10 +269,104 @@ public:
             LOGINFO("No connected interface found");
         }
 
+        StoreInternetStatus(result, registered, generation);
         return Core::ERROR_NONE;
     }
 
 private:
+    // NetworkManager was deactivated or crashed: its events stopped, so nothing the
+    // snapshot holds can be trusted and the next call starts from a fresh interface
+    void Revoked(const string &callsign) override
+    {
+        if (callsign == NETWORKMANAGER_CALLSIGN)
+        {
+            LOGINFO("NetworkManager went away, dropping its interface and the connectivity snapshot");
+            ReleaseNetworkManager();
+        }
+    }
+
+    void ReleaseNetworkManager()
+    {
+        {
+            Core::SafeSyncType<Core::CriticalSection> lock(mNetworkManagerLock);
+            if (nullptr != mNetworkManager)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mRegistrationMutex);
+                    if (mNotificationHandler.GetRegistered())
+                    {
+                        mNetworkManager->Unregister(&mNotificationHandler);
+                        mNotificationHandler.SetRegistered(false);
+                    }
+                }
+                mNetworkManager->Release();
+                mNetworkManager = nullptr;
+            }
+        }
+        InvalidateConnectivitySnapshot();
+    }
+
+    // Drops the connectivity snapshot; the next read goes back to NetworkManager
+    void InvalidateConnectivitySnapshot()
+    {
+        std::lock_guard<std::mutex> lock(mSnapshotMutex);
+        ++mSnapshotGeneration;
+        mConnectedValid = false;
+        mInternetStatusValid = false;
+    }
+
+    // The snapshot is only authoritative while notifications are flowing, so reads
+    // register the handler even when no app has subscribed to network events.
+    bool EnsureRegistered(Exchange::INetworkManager *networkManager)
+    {
+        Core::SafeSyncType<Core::CriticalSection> managerLock(mNetworkManagerLock);
+        if (networkManager != mNetworkManager)
+        {
+            // Dropped while this call was using it; events from it are not coming
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mRegistrationMutex);
+        if (!mNotificationHandler.GetRegistered())
+        {
+            LOGINFO("Registering for NetworkManager notifications");
+            if (networkManager->Register(&mNotificationHandler) != Core::ERROR_NONE)
+            {
+                LOGERR("Failed to register for NetworkManager notifications");
+                return false;
+            }
+            mNotificationHandler.SetRegistered(true);
+        }
+        return true;
+    }
+
+    void StoreInternetStatus(const string &result, const bool registered, const uint64_t generation)
+    {
+        std::lock_guard<std::mutex> lock(mSnapshotMutex);
+        // A change event that arrived while NetworkManager was queried wins
+        if (registered && generation == mSnapshotGeneration)
+        {
+            mInternetStatusSnapshot = result;
+            mInternetStatusValid = true;
+        }
+    }
+
+    void OnActiveInterfaceChanged(const bool connected)
+    {
+        std::lock_guard<std::mutex> lock(mSnapshotMutex);
+        ++mSnapshotGeneration;
+        mConnectedSnapshot = connected ? "true" : "false";
+        mConnectedValid = true;
+        // The interface type is not part of the event, rebuild on the next read
+        mInternetStatusValid = false;
+    }
+
+    void OnInterfaceStatusChanged()
+    {
+        std::lock_guard<std::mutex> lock(mSnapshotMutex);
+        ++mSnapshotGeneration;
+        mInternetStatusValid = false;
+    }
+
     class NetworkNotificationHandler : public Exchange::INetworkManager::INotification
     {
     public:
@@ -257,12 +376,14 @@ private:
         void onActiveInterfaceChange(const string prevActiveInterface, const string currentActiveInterface)
         {
             LOGDBG("onActiveInterfaceChange: prev=%s, current=%s", prevActiveInterface.c_str(), currentActiveInterface.c_str());
+            mParent.OnActiveInterfaceChanged(!currentActiveInterface.empty());
             mParent.Dispatch("Network.onConnectedChanged", ObjectUtils::CreateBooleanJsonString("value", currentActiveInterface.empty() ? false : true) );
         }
 
         void onInternetStatusChange(const Exchange::INetworkManager::InternetStatus prevState, const Exchange::INetworkManager::InternetStatus currState, const string interface)
         {
             LOGINFO("onInternetStatusChange: prevState=%d, currState=%d, interface=%s", prevState, currState, interface.c_str());
+            mParent.OnInterfaceStatusChanged();
 
             // Map internet status to readable strings
             auto statusToString = [](Exchange::INetworkManager::InternetStatus status) -> string {
@@ -281,6 +402,12 @@ private:
                       << "\",\"prevState\":\"" << statusToString(prevState) << "\"}}";
             mParent.Dispatch("device.onNetworkChanged", jsonStream.str());
         }
+
+        void onInterfaceStateChange(const Exchange::INetworkManager::InterfaceState state, const string interface)
+        {
+            LOGDBG("onInterfaceStateChange: state=%d, interface=%s", state, interface.c_str());
+            mParent.OnInterfaceStatusChanged();
+        }
         
         // Registration management methods
         void SetRegistered(bool state)
@@ -307,8 +434,17 @@ private:
     mutable Core::CriticalSection mNetworkManagerLock;
     Exchange::INetworkManager *mNetworkManager;
     PluginHost::IShell *mShell;
+    std::shared_ptr<WPEFramework::Utils::InterfaceCache> mInterfaces;
     Core::Sink<NetworkNotificationHandler> mNotificationHandler;
     mutable std::mutex mRegistrationMutex;
+
+    // Pre-serialized connectivity responses, maintained by NetworkManager events
+    mutable std::mutex mSnapshotMutex;
+    uint64_t mSnapshotGeneration;
+    bool mConnectedValid;
+    string mConnectedSnapshot;
+    bool mInternetStatusValid;
+    string mInternetStatusSnapshot;
 };
 
 #endif // __NETWORKDELEGATE_H__
@@ -25,6 +25,7 @@
 #include "NetworkDelegate.h"
 #include "LifecycleDelegate.h"
 #include "UtilsLogging.h"
+#include "UtilsInterfaceCache.h"
 #include "AppDelegate.h"
 #include "TTSDelegate.h"
 #include <interfaces/IAppNotifications.h>
@@ -34,7 +35,7 @@ using namespace WPEFramework;
 
 class SettingsDelegate {
     public:
-        SettingsDelegate(): userSettings(nullptr), systemDelegate(nullptr), networkDelegate(nullptr), lifecycleDelegate(nullptr), appDelegate(nullptr), ttsDelegate(nullptr) {}
+        SettingsDelegate(): interfaceCache(nullptr), userSettings(nullptr), systemDelegate(nullptr), networkDelegate(nullptr), lifecycleDelegate(nullptr), appDelegate(nullptr), ttsDelegate(nullptr) {}
 
         ~SettingsDelegate() {
             userSettings = nullptr;
@@ -43,6 +44,7 @@ class SettingsDelegate {
             lifecycleDelegate = nullptr;
             appDelegate = nullptr;
             ttsDelegate = nullptr;
+            interfaceCache = nullptr;
         }
 
         void HandleAppEventNotifier(Exchange::IAppNotificationHandler::IEmitter *cb, const string event,
@@ -80,16 +82,23 @@ class SettingsDelegate {
             ASSERT(shell != nullptr);
             LOGDBG("SettingsDelegate::setShell");
 
+            // Shared by the delegates; follows plugin state changes so cached
+            // interfaces are dropped when their plugin goes away
+            if (interfaceCache == nullptr) {
+                interfaceCache = std::make_shared<WPEFramework::Utils::InterfaceCache>();
+                interfaceCache->Open(shell);
+            }
+
             if (userSettings == nullptr) {
                 userSettings = std::make_shared<UserSettingsDelegate>(shell);
             }
 
             if (systemDelegate == nullptr) {
-                systemDelegate = std::make_shared<SystemDelegate>(shell);
+                systemDelegate = std::make_shared<SystemDelegate>(shell, interfaceCache);
             }
 
             if (networkDelegate == nullptr) {
-                networkDelegate = std::make_shared<NetworkDelegate>(shell);
+                networkDelegate = std::make_shared<NetworkDelegate>(shell, interfaceCache);
             }
 
             if (lifecycleDelegate == nullptr) {
@@ -112,6 +121,10 @@ class SettingsDelegate {
             lifecycleDelegate.reset();
             appDelegate.reset();
             ttsDelegate.reset();
+            if (interfaceCache != nullptr) {
+                interfaceCache->Close();
+                interfaceCache.reset();
+            }
         }
 
         std::shared_ptr<SystemDelegate> getSystemDelegate() const {
@@ -135,6 +148,7 @@ class SettingsDelegate {
         }
 
     private:
+        std::shared_ptr<WPEFramework::Utils::InterfaceCache> interfaceCache;
         std::shared_ptr<UserSettingsDelegate> userSettings;
         std::shared_ptr<SystemDelegate> systemDelegate;
         std::shared_ptr<NetworkDelegate> networkDelegate;
@@ -34,6 +34,9 @@
 #include "UtilsLogging.h"
 #include "UtilsJsonrpcDirectLink.h"
 #include "UtilsController.h"
+#include "UtilsInterfaceCache.h"
+#include "UtilsExtrapolatedCounter.h"
+#include "UtilsDisplayCapabilities.h"
 #include "BaseEventDelegate.h"
 #include <algorithm>
 #include "ContextUtils.h"
@@ -77,7 +80,14 @@ using namespace WPEFramework;
 #define SYSTEM_DELEGATE_SUBSCRIBE_TIMEOUT_MS 2000
 #endif
 
-class SystemDelegate: public BaseEventDelegate
+// Uptime and time since wakeup are sampled over COM-RPC and extrapolated locally;
+// this is how long (s) an extrapolation is trusted before it is checked against a
+// fresh sample.
+#ifndef SYSTEM_DELEGATE_COUNTER_RESYNC_SEC
+#define SYSTEM_DELEGATE_COUNTER_RESYNC_SEC 600
+#endif
+
+class SystemDelegate: public BaseEventDelegate, private WPEFramework::Utils::InterfaceCache::IObserver
 {
 public:
 
@@ -92,9 +102,12 @@ public:
     static constexpr const char* EVENT_ON_TIMEZONE_CHANGED    = "Localization.onTimeZoneChanged";
     static constexpr const char* EVENT_ON_COUNTRY_CHANGED     = "Localization.onCountryChanged";
 
-    SystemDelegate(PluginHost::IShell *shell)
+    // interfaces, when given, supplies the COM interfaces used on request paths and
+    // reports PowerManager going away; without it every call queries the shell
+    SystemDelegate(PluginHost::IShell *shell, const std::shared_ptr<WPEFramework::Utils::InterfaceCache>& interfaces = nullptr)
         : BaseEventDelegate()
         , _shell(shell)
+        , _interfaces(interfaces)
         , _subscriptions()
         , _displayRpc(nullptr)
         , _hdcpRpc(nullptr)
@@ -105,12 +118,23 @@ public:
         , _systemSubscribed(false)
         , _timezoneSubscribed(false)
         , _countrySubscribed(false)
-    {
+        , _uptime(CLOCK_BOOTTIME, SYSTEM_DELEGATE_COUNTER_RESYNC_SEC)
+        , _sinceWakeup(CLOCK_MONOTONIC, SYSTEM_DELEGATE_COUNTER_RESYNC_SEC)
+        , _powerModeSink(*this)
+        , _powerModeSource(nullptr)
+        , _display()
+    {
+            if (_interfaces) {
+                _interfaces->Watch(this);
+            }
             LOGINFO("SystemDelegate initialized");
     }
 
     ~SystemDelegate()
     {
+        if (_interfaces) {
+            _interfaces->Unwatch(this);
+        }
         // Cleanup subscriptions
         try {
             if (_displayRpc) {
@@ -141,6 +165,8 @@ public:
         _displayRpc.reset();
         _hdcpRpc.reset();
         _systemRpc.reset();
+        ReleasePowerModeSource();
+        _interfaces.reset();
         _shell = nullptr;
     }
 
@@ -560,6 +586,10 @@ public:
          */
         jsonObject = "{\"hdcp1.4\":false,\"hdcp2.2\":false}";
         LOGDBG("[AppGatewayCommon|GetHdcp] Invoked");
+        if (_display.Get(WPEFramework::Utils::DisplayCapabilities::HDCP, jsonObject)) {
+            return Core::ERROR_NONE;
+        }
+        const uint32_t displayGeneration = _display.Generation();
         auto link = AcquireLink(HDCPPROFILE_CALLSIGN);
         if (!link) {
             LOGERR("[AppGatewayCommon|GetHdcp] HdcpProfile link unavailable, returning default %s", jsonObject.c_str());
@@ -616,6 +646,7 @@ public:
                    + ",\"hdcp2.2\":" + (hdcp22 ? "true" : "false") + "}";
         LOGDBG("[AppGatewayCommon|GetHdcp] Computed HDCP flags: hdcp1.4=%s hdcp2.2=%s -> %s",
                hdcp14 ? "true" : "false", hdcp22 ? "true" : "false", jsonObject.c_str());
+        _display.Store(WPEFramework::Utils::DisplayCapabilities::HDCP, jsonObject, displayGeneration);
         return Core::ERROR_NONE;
     }
 
@@ -628,6 +659,10 @@ public:
          */
         jsonObject = "{\"hdr10\":false,\"dolbyVision\":false,\"hlg\":false,\"hdr10Plus\":false}";
         LOGDBG("[AppGatewayCommon|GetHdr] Invoked");
+        if (_display.Get(WPEFramework::Utils::DisplayCapabilities::HDR, jsonObject)) {
+            return Core::ERROR_NONE;
+        }
+        const uint32_t displayGeneration = _display.Generation();
         auto link = AcquireLink(DISPLAYSETTINGS_CALLSIGN);
         if (!link) {
             LOGERR("[AppGatewayCommon|GetHdr] DisplaySettings link unavailable, returning default %s", jsonObject.c_str());
@@ -689,6 +724,7 @@ public:
                hlg ? "true" : "false",
                hdr10plus ? "true" : "false",
                jsonObject.c_str());
+        _display.Store(WPEFramework::Utils::DisplayCapabilities::HDR, jsonObject, displayGeneration);
         return Core::ERROR_NONE;
     }
 
@@ -924,7 +960,7 @@ public:
         chipset.clear();
         if (nullptr == _shell) return Core::ERROR_UNAVAILABLE;
 
-        auto* di = _shell->QueryInterfaceByCallsign<Exchange::IDeviceInfo>(DEVICEINFO_CALLSIGN);
+        auto* di = AcquireInterface<Exchange::IDeviceInfo>(DEVICEINFO_CALLSIGN);
         if (nullptr == di)
         {
             LOGWARN("SystemDelegate: IDeviceInfo unavailable for ChipSet");
@@ -950,7 +986,7 @@ public:
         typeOut.clear();
         if (nullptr == _shell) return Core::ERROR_UNAVAILABLE;
 
-        auto* di = _shell->QueryInterfaceByCallsign<Exchange::IDeviceInfo>(DEVICEINFO_CALLSIGN);
+        auto* di = AcquireInterface<Exchange::IDeviceInfo>(DEVICEINFO_CALLSIGN);
         if (nullptr == di)
         {
             LOGWARN("SystemDelegate: IDeviceInfo unavailable for DeviceType");
@@ -976,7 +1012,15 @@ public:
         uptime.clear();
         if (nullptr == _shell) return Core::ERROR_UNAVAILABLE;
 
-        auto* di = _shell->QueryInterfaceByCallsign<Exchange::IDeviceInfo>(DEVICEINFO_CALLSIGN);
+        uint64_t seconds = 0;
+        if (_uptime.Read(seconds))
+        {
+            uptime = std::to_string(seconds);
+            return Core::ERROR_NONE;
+        }
+        const uint32_t generation = _uptime.Generation();
+
+        auto* di = AcquireInterface<Exchange::IDeviceInfo>(DEVICEINFO_CALLSIGN);
         if (nullptr == di)
         {
             LOGWARN("SystemDelegate: IDeviceInfo unavailable for SystemInfo");
@@ -992,7 +1036,9 @@ public:
             LOGERR("SystemDelegate: IDeviceInfo::SystemInfo failed rc=%u", rc);
             return Core::ERROR_GENERAL;
         }
-        uptime = std::to_string(static_cast<uint64_t>(sysInfo.uptime));
+        seconds = static_cast<uint64_t>(sysInfo.uptime);
+        AnchorCounter(_uptime, seconds, generation, "uptime");
+        uptime = std::to_string(seconds);
         return Core::ERROR_NONE;
     }
 
@@ -1002,13 +1048,24 @@ public:
         result.clear();
         if (nullptr == _shell) return Core::ERROR_UNAVAILABLE;
 
-        auto* pm = _shell->QueryInterfaceByCallsign<Exchange::IPowerManager>(POWERMANAGER_CALLSIGN);
+        uint64_t seconds = 0;
+        if (_sinceWakeup.Read(seconds))
+        {
+            result = std::to_string(seconds);
+            return Core::ERROR_NONE;
+        }
+        const uint32_t generation = _sinceWakeup.Generation();
+
+        auto* pm = AcquireInterface<Exchange::IPowerManager>(POWERMANAGER_CALLSIGN);
         if (nullptr == pm)
         {
             LOGWARN("SystemDelegate: IPowerManager unavailable for GetTimeSinceWakeup");
             return Core::ERROR_UNAVAILABLE;
         }
 
+        // The counter restarts on every power state transition; it is only
+        // extrapolated while those transitions are reported to us
+        const bool tracked = TrackPowerModeChanges(pm, generation);
         Exchange::IPowerManager::TimeSinceWakeup tsw{};
         const Core::hresult rc = pm->GetTimeSinceWakeup(tsw);
         pm->Release();
@@ -1018,7 +1075,12 @@ public:
             LOGERR("SystemDelegate: IPowerManager::GetTimeSinceWakeup failed rc=%u", rc);
             return Core::ERROR_GENERAL;
         }
-        result = std::to_string(static_cast<uint64_t>(tsw.secondsSinceWakeup));
+        seconds = static_cast<uint64_t>(tsw.secondsSinceWakeup);
+        if (tracked)
+        {
+            AnchorCounter(_sinceWakeup, seconds, generation, "time since wakeup");
+        }
+        result = std::to_string(seconds);
         return Core::ERROR_NONE;
     }
 
@@ -1111,6 +1173,7 @@ public:
     // Display.edid — reads raw EDID bytes from DisplayInfo via ComRPC (Exchange::IConnectionProperties::EDID),
     // then Base64-encodes them to produce the Firebolt string result.
     // Returns "" when no display is connected (STB/OTT) or the interface is unavailable.
+    // The encoded result is kept in the display capability record until the next hotplug.
     Core::hresult GetDisplayEdid(std::string &result)
     {
         result = "\"\"";
@@ -1121,7 +1184,13 @@ public:
             return Core::ERROR_UNAVAILABLE;
         }
 
-        auto* connProps = _shell->QueryInterfaceByCallsign<Exchange::IConnectionProperties>(DISPLAYINFO_CALLSIGN);
+        if (_display.Get(WPEFramework::Utils::DisplayCapabilities::EDID, result))
+        {
+            return Core::ERROR_NONE;
+        }
+        const uint32_t displayGeneration = _display.Generation();
+
+        auto* connProps = AcquireInterface<Exchange::IConnectionProperties>(DISPLAYINFO_CALLSIGN);
         if (nullptr == connProps)
         {
             LOGWARN("SystemDelegate: IConnectionProperties unavailable for EDID (no display or plugin absent)");
@@ -1135,6 +1204,7 @@ public:
         {
             LOGWARN("SystemDelegate: No display connected — returning empty EDID");
             connProps->Release();
+            _display.Store(WPEFramework::Utils::DisplayCapabilities::EDID, result, displayGeneration);
             return Core::ERROR_NONE;
         }
 
@@ -1155,6 +1225,7 @@ public:
         const std::string encoded = Base64Encode(edidBuf.data(), edidLen);
         LogEdidInfo(encoded);
         result = "\"" + encoded + "\"";
+        _display.Store(WPEFramework::Utils::DisplayCapabilities::EDID, result, displayGeneration);
         return Core::ERROR_NONE;
     }
 
@@ -1172,7 +1243,13 @@ public:
             return Core::ERROR_UNAVAILABLE;
         }
 
-        auto* connProps = _shell->QueryInterfaceByCallsign<Exchange::IConnectionProperties>(DISPLAYINFO_CALLSIGN);
+        if (_display.Get(WPEFramework::Utils::DisplayCapabilities::SIZE, result))
+        {
+            return Core::ERROR_NONE;
+        }
+        const uint32_t displayGeneration = _display.Generation();
+
+        auto* connProps = AcquireInterface<Exchange::IConnectionProperties>(DISPLAYINFO_CALLSIGN);
         if (nullptr == connProps)
         {
             LOGWARN("SystemDelegate: IConnectionProperties unavailable for size (no display or plugin absent)");
@@ -1197,6 +1274,7 @@ public:
         obj["width"]  = static_cast<int>(width);
         obj["height"] = static_cast<int>(height);
         obj.ToString(result);
+        _display.Store(WPEFramework::Utils::DisplayCapabilities::SIZE, result, displayGeneration);
         return Core::ERROR_NONE;
     }
 
@@ -1214,7 +1292,13 @@ public:
             return Core::ERROR_UNAVAILABLE;
         }
 
-        auto* connProps = _shell->QueryInterfaceByCallsign<Exchange::IConnectionProperties>(DISPLAYINFO_CALLSIGN);
+        if (_display.Get(WPEFramework::Utils::DisplayCapabilities::MAX_RESOLUTION, result))
+        {
+            return Core::ERROR_NONE;
+        }
+        const uint32_t displayGeneration = _display.Generation();
+
+        auto* connProps = AcquireInterface<Exchange::IConnectionProperties>(DISPLAYINFO_CALLSIGN);
         if (nullptr == connProps)
         {
             LOGWARN("SystemDelegate: IConnectionProperties unavailable for maxResolution (no display or plugin absent)");
@@ -1238,11 +1322,84 @@ public:
         obj["width"]  = static_cast<int>(width);
         obj["height"] = static_cast<int>(height);
         obj.ToString(result);
+        _display.Store(WPEFramework::Utils::DisplayCapabilities::MAX_RESOLUTION, result, displayGeneration);
         return Core::ERROR_NONE;
     }
 
 
 private:
+    static void AnchorCounter(WPEFramework::Utils::ExtrapolatedCounter& counter, const uint64_t seconds,
+                              const uint32_t generation, const char* name)
+    {
+        int64_t drift = 0;
+        if (counter.Anchor(seconds, generation, drift) && (drift > 1 || drift < -1))
+        {
+            LOGWARN("SystemDelegate: %s drifted %lld s from extrapolation, re-anchored", name, static_cast<long long>(drift));
+        }
+    }
+
+    // PowerManager was deactivated or crashed: mode changes are no longer reported,
+    // so time since wakeup must not be extrapolated from the old anchor
+    void Revoked(const string& callsign) override
+    {
+        if (callsign == POWERMANAGER_CALLSIGN)
+        {
+            ReleasePowerModeSource();
+        }
+    }
+
+    void ReleasePowerModeSource()
+    {
+        Core::SafeSyncType<Core::CriticalSection> lock(_powerModeLock);
+        if (_powerModeSource != nullptr)
+        {
+            _powerModeSource->Unregister(&_powerModeSink);
+            _powerModeSource->Release();
+            _powerModeSource = nullptr;
+        }
+        _sinceWakeup.Invalidate();
+    }
+
+    // Registers for power mode changes on pm (once per PowerManager instance);
+    // generation is the counter's, taken before pm was acquired
+    bool TrackPowerModeChanges(Exchange::IPowerManager* pm, const uint32_t generation)
+    {
+        Core::SafeSyncType<Core::CriticalSection> lock(_powerModeLock);
+        if (_powerModeSource == pm)
+        {
+            return true;
+        }
+        if (generation != _sinceWakeup.Generation())
+        {
+            // PowerManager may have gone away since pm was acquired; do not pin it
+            return false;
+        }
+        if (_powerModeSource != nullptr)
+        {
+            // PowerManager was restarted; move the registration to the new instance
+            ReleasePowerModeSource();
+        }
+        const Core::hresult rc = pm->Register(&_powerModeSink);
+        if (rc != Core::ERROR_NONE)
+        {
+            LOGWARN("SystemDelegate: IPowerManager mode change registration failed rc=%u, not extrapolating", rc);
+            return false;
+        }
+        pm->AddRef();
+        _powerModeSource = pm;
+        return true;
+    }
+
+    // Caller releases the returned interface, as with QueryInterfaceByCallsign
+    template <typename INTERFACE>
+    INTERFACE* AcquireInterface(const char* callsign)
+    {
+        if (_interfaces) {
+            return _interfaces->Acquire<INTERFACE>(callsign);
+        }
+        return _shell->QueryInterfaceByCallsign<INTERFACE>(callsign);
+    }
+
     // Encode raw bytes to a standard Base64 string (RFC 4648, with '=' padding).
     static std::string Base64Encode(const uint8_t* in, size_t inLen)
     {
@@ -1808,6 +1965,8 @@ private:
         (void)params;
         LOGINFO("[AppGatewayCommon|DisplaySettings.resolutionChanged] Incoming alias=%s.%s, invoking handlers...",
                 DISPLAYSETTINGS_CALLSIGN, "resolutionChanged");
+        // A resolution change may follow a display swap; forget its capabilities
+        _display.Invalidate();
         // Re-query state and dispatch debounced events
         const bool screenEmitted = EmitOnScreenResolutionChanged();
         const bool videoEmitted = EmitOnVideoResolutionChanged();
@@ -1820,6 +1979,8 @@ private:
         (void)params;
         LOGINFO("[AppGatewayCommon|HdcpProfile.onDisplayConnectionChanged] Incoming alias=%s.%s, invoking handlers...",
                 HDCPPROFILE_CALLSIGN, "onDisplayConnectionChanged");
+        // Hotplug: the capability record describes the previous display
+        _display.Invalidate();
         // Re-query state and dispatch debounced events
         const bool hdcpEmitted = EmitOnHdcpChanged();
         const bool hdrEmitted = EmitOnHdrChanged();
@@ -1903,6 +2064,8 @@ private:
     {
         Core::SafeSyncType<Core::CriticalSection> lock(_hdcpSubscriptionLock);
         _hdcpSubscribed = true;
+        // Hotplug is now observed, so display capabilities can be kept between calls
+        _display.Track(true);
     }
 
     bool isSystemSubscribed() const
@@ -1943,6 +2106,7 @@ private:
 
 private:
     PluginHost::IShell *_shell;
+    std::shared_ptr<WPEFramework::Utils::InterfaceCache> _interfaces;
     std::unordered_set<std::string> _subscriptions;
     mutable Core::CriticalSection mAdminLock;
     std::string mVersionResponse;
@@ -1966,5 +2130,39 @@ private:
 
     bool _countrySubscribed;
     mutable Core::CriticalSection _countrySubscriptionLock;
+
+    class PowerModeNotification : public Exchange::IPowerManager::IModeChangedNotification
+    {
+    public:
+        explicit PowerModeNotification(SystemDelegate& parent)
+            : _parent(parent)
+        {
+        }
+
+        void OnPowerModeChanged(const Exchange::IPowerManager::PowerState /*currentState*/,
+                                const Exchange::IPowerManager::PowerState /*newState*/) override
+        {
+            _parent._sinceWakeup.Invalidate();
+        }
+
+        BEGIN_INTERFACE_MAP(PowerModeNotification)
+        INTERFACE_ENTRY(Exchange::IPowerManager::IModeChangedNotification)
+        END_INTERFACE_MAP
+
+    private:
+        SystemDelegate& _parent;
+    };
+
+    // Uptime follows CLOCK_BOOTTIME (it keeps counting through suspend); time since
+    // wakeup follows CLOCK_MONOTONIC and is reset by power mode changes
+    WPEFramework::Utils::ExtrapolatedCounter _uptime;
+    WPEFramework::Utils::ExtrapolatedCounter _sinceWakeup;
+    Core::Sink<PowerModeNotification> _powerModeSink;
+    Exchange::IPowerManager* _powerModeSource;
+    mutable Core::CriticalSection _powerModeLock;
+
+    // Connected display's EDID, size, max resolution, HDR and HDCP results; used once
+    // HdcpProfile.onDisplayConnectionChanged is subscribed and dropped on each hotplug
+    WPEFramework::Utils::DisplayCapabilities _display;
 };
 
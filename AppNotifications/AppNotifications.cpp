@@ -72,6 +72,13 @@ namespace Plugin {
         mAppNotifications = service->Root<Exchange::IAppNotifications>(mConnectionId, 2000, _T("AppNotificationsImplementation"));
 
         if (mAppNotifications != nullptr) {
+            // A remote connection means every Subscribe/Emit crosses a COM-RPC boundary
+            RPC::IRemoteConnection* connection = service->RemoteConnection(mConnectionId);
+            SYSLOG(Logging::Startup, (_T("AppNotifications::Initialize: implementation running %s"),
+                (connection != nullptr) ? _T("out of process") : _T("co-located")));
+            if (connection != nullptr) {
+                connection->Release();
+            }
             auto configConnection = mAppNotifications->QueryInterface<Exchange::IConfiguration>();
             if (configConnection != nullptr) {
                 configConnection->Configure(service);
@@ -18,6 +18,9 @@
 #include "AppNotificationsImplementation.h"
 #include "UtilsLogging.h"
 #include "StringUtils.h"
+#include "UtilsAppGatewayTelemetry.h"
+
+AGW_DEFINE_TELEMETRY_CLIENT(AGW_PLUGIN_APPNOTIFICATIONS)
 
 namespace WPEFramework
 {
@@ -35,8 +38,13 @@ namespace WPEFramework
     {
         SERVICE_REGISTRATION(AppNotificationsImplementation, 1, 0);
 
+        constexpr uint32_t AppNotificationsImplementation::DefaultMaxSubscriptionsPerConnection;
+        constexpr size_t AppNotificationsImplementation::SubscriberMap::MaxCachedEventNames;
+
         AppNotificationsImplementation::AppNotificationsImplementation() : 
         mShell(nullptr),
+        mDuplicateSubscriptions(0),
+        mRejectedSubscriptions(0),
         mSubMap(*this),
         mThunderManager(*this),
         mEmitter(*this)
@@ -48,6 +56,7 @@ namespace WPEFramework
             // Cleanup resources if needed
             if (mShell != nullptr)
             {
+                AGW_TELEMETRY_DEINIT();
                 mShell->Release();
                 mShell = nullptr;
             }
@@ -61,11 +70,28 @@ namespace WPEFramework
                     context.requestId, context.appId.c_str(), context.connectionId,
                     listen ? "true" : "false", module.c_str(), event.c_str(), context.version.c_str());
             if (listen) {
-                if (!mSubMap.Exists(event)) {
+                const bool firstSubscriber = !mSubMap.Exists(event);
+                const Core::hresult addResult = mSubMap.Add(event, context);
+                if (Core::ERROR_INVALID_RANGE == addResult) {
+                    mRejectedSubscriptions++;
+                    LOGERR("Subscription limit reached [connectionId=%d origin=%s] event=%s rejected (total rejected=%u)",
+                        context.connectionId, context.origin.c_str(), event.c_str(), mRejectedSubscriptions.load());
+                    AGW_REPORT_METRIC(ContextUtils::ConvertNotificationToAppGatewayContext(context),
+                        AGW_MARKER_SUBSCRIPTIONS_REJECTED, 1.0, AGW_UNIT_COUNT);
+                    return Core::ERROR_INVALID_RANGE;
+                }
+
+                if (Core::ERROR_DUPLICATE_KEY == addResult) {
+                    // Already listening, the stored context was refreshed in place
+                    mDuplicateSubscriptions++;
+                    LOGTRACE("Duplicate subscription [connectionId=%d origin=%s] event=%s (total duplicates=%u)",
+                        context.connectionId, context.origin.c_str(), event.c_str(), mDuplicateSubscriptions.load());
+                    AGW_REPORT_METRIC(ContextUtils::ConvertNotificationToAppGatewayContext(context),
+                        AGW_MARKER_SUBSCRIPTIONS_DUPLICATE, 1.0, AGW_UNIT_COUNT);
+                } else if (firstSubscriber) {
                     // Thunder subscription
                     Core::IWorkerPool::Instance().Submit(SubscriberJob::Create(this, module, event, listen));
                 }
-                mSubMap.Add(event, context);
             } else {
                 mSubMap.Remove(event, context);
                 // If all elements are removed the entry is erased automatically
@@ -107,6 +133,7 @@ namespace WPEFramework
                     ++it;
                 }
             }
+            mConnectionSubscriptions.erase(ConnectionKey(connectionId, origin));
         }
 
         uint32_t AppNotificationsImplementation::Configure(PluginHost::IShell *shell)
@@ -116,13 +143,50 @@ namespace WPEFramework
             ASSERT(shell != nullptr);
             mShell = shell;
             mShell->AddRef();
+
+            Config config;
+            const string configLine = mShell->ConfigLine();
+            if (!configLine.empty()) {
+                Core::OptionalType<Core::JSON::Error> error;
+                if (config.FromString(configLine, error) == false) {
+                    LOGERR("Failed to parse config line, error: '%s', config line: '%s'.",
+                           (error.IsSet() ? error.Value().Message().c_str() : "Unknown"),
+                           configLine.c_str());
+                }
+            }
+            mSubMap.SetMaxSubscriptionsPerConnection(config.MaxSubscriptionsPerConnection.Value());
+            LOGINFO("Max subscriptions per connection: %u", config.MaxSubscriptionsPerConnection.Value());
+            if (config.EventRingSize.Value() != 0) {
+                mSubMap.OpenEventRing(config.EventRingSize.Value());
+            }
+
+            AGW_TELEMETRY_INIT(mShell);
             return result;
         }
 
-        void AppNotificationsImplementation::SubscriberMap::Add(const string& key, const Exchange::IAppNotifications::AppNotificationContext& context) {
+        Core::hresult AppNotificationsImplementation::SubscriberMap::Add(const string& key, const Exchange::IAppNotifications::AppNotificationContext& context) {
             string lowerKey = StringUtils::toLower(key);
             std::lock_guard<std::mutex> lock(mSubscriberMutex);
-            mSubscribers[lowerKey].push_back(context);
+            auto& vec = mSubscribers[lowerKey];
+            for (auto& existing : vec) {
+                if (IsSameSubscriber(existing, context)) {
+                    // Keep the latest request details so responses carry the most recent context
+                    existing = context;
+                    return Core::ERROR_DUPLICATE_KEY;
+                }
+            }
+
+            uint32_t& count = mConnectionSubscriptions[ConnectionKey(context.connectionId, context.origin)];
+            if ((mMaxSubscriptionsPerConnection != 0) && (count >= mMaxSubscriptionsPerConnection)) {
+                if (vec.empty()) {
+                    mSubscribers.erase(lowerKey);
+                }
+                return Core::ERROR_INVALID_RANGE;
+            }
+
+            vec.push_back(context);
+            count++;
+            return Core::ERROR_NONE;
         }
         
         void AppNotificationsImplementation::SubscriberMap::Remove(const string& key, const Exchange::IAppNotifications::AppNotificationContext& context) {
@@ -131,13 +195,41 @@ namespace WPEFramework
             auto it = mSubscribers.find(lowerKey);
             if (it != mSubscribers.end()) {
                 auto& vec = it->second;
-                vec.erase(std::remove(vec.begin(), vec.end(), context), vec.end());
+                const size_t before = vec.size();
+                vec.erase(std::remove_if(vec.begin(), vec.end(),
+                    [&](const Exchange::IAppNotifications::AppNotificationContext& existing) {
+                        return IsSameSubscriber(existing, context);
+                    }), vec.end());
+                ReleaseConnectionSubscriptions(ConnectionKey(context.connectionId, context.origin),
+                    static_cast<uint32_t>(before - vec.size()));
                 if (vec.empty()) {
                 mSubscribers.erase(it);
                 }
             }
         }
 
+        void AppNotificationsImplementation::SubscriberMap::ReleaseConnectionSubscriptions(const ConnectionKey& connection, const uint32_t count) {
+            auto it = mConnectionSubscriptions.find(connection);
+            if ((it != mConnectionSubscriptions.end()) && (count > 0)) {
+                if (it->second <= count) {
+                    mConnectionSubscriptions.erase(it);
+                } else {
+                    it->second -= count;
+                }
+            }
+        }
+
+        void AppNotificationsImplementation::SubscriberMap::SetMaxSubscriptionsPerConnection(const uint32_t maxSubscriptions) {
+            std::lock_guard<std::mutex> lock(mSubscriberMutex);
+            mMaxSubscriptionsPerConnection = maxSubscriptions;
+        }
+
+        uint32_t AppNotificationsImplementation::SubscriberMap::SubscriptionCount(const uint32_t connectionId, const string& origin) const {
+            std::lock_guard<std::mutex> lock(mSubscriberMutex);
+            auto it = mConnectionSubscriptions.find(ConnectionKey(connectionId, origin));
+            return (it != mConnectionSubscriptions.end()) ? it->second : 0;
+        }
+
         std::vector<Exchange::IAppNotifications::AppNotificationContext> AppNotificationsImplementation::SubscriberMap::Get(const string& key) const {
             std::lock_guard<std::mutex> lock(mSubscriberMutex);
             string lowerKey = StringUtils::toLower(key);
@@ -157,30 +249,46 @@ namespace WPEFramework
 
         void AppNotificationsImplementation::SubscriberMap::EventUpdate(const string& key, const string& payloadStr, const string& appId ) {                
 
-            std::lock_guard<std::mutex> lock(mSubscriberMutex);
-            string lowerKey = StringUtils::toLower(key);
-            // Remove version information from the event key to match subscription keys
-            string clearKey = ContextUtils::GetBaseEventNameFromVersionedEvent(key);
-            auto it = mSubscribers.find(lowerKey);
-            if (it != mSubscribers.end()) {
-                for (const auto& context : it->second) {
-                    // check if app id is not empty if not empty check if context.appId matches appId
-                    if (!appId.empty()) {
-
-                        if(context.appId == appId) {
-                            // Dispatch the event to the subscriber
-                            Dispatch(clearKey, context, payloadStr);
-                        }
-                        
-                    } else {
-                        // Dispatch the event to the subscriber
-                        Dispatch(clearKey, context, payloadStr);
+            // Dispatched after the lock is released, so a slow responder does not hold up
+            // Subscribe, Unsubscribe or other events
+            std::vector<Exchange::IAppNotifications::AppNotificationContext> targets;
+            string clearKey;
+            {
+                std::lock_guard<std::mutex> lock(mSubscriberMutex);
+                const EventNames& names = ResolveEventNames(key);
+                clearKey = names.dispatchName;
+                auto it = mSubscribers.find(names.lowerKey);
+                if (it == mSubscribers.end()) {
+                    // using LOGWARN print a warning that there are no active listeners for this event
+                    LOGWARN("No active listeners for event: %s trace=%s", key.c_str(), Utils::TraceId::ToString(Utils::TraceId::Current()).c_str());
+                    return;
+                }
+                targets.reserve(it->second.size());
+                for (const auto& subscriber : it->second) {
+                    // check if app id is not empty if not empty check if subscriber.appId matches appId
+                    if (appId.empty() || (subscriber.appId == appId)) {
+                        targets.push_back(subscriber);
                     }
                 }
-            } else {
-                // using LOGWARN print a warning that there are no active listeners for this event
-                LOGWARN("No active listeners for event: %s", key.c_str());
             }
+            for (const auto& context : targets) {
+                Dispatch(clearKey, context, payloadStr);
+            }
+        }
+
+        const AppNotificationsImplementation::SubscriberMap::EventNames& AppNotificationsImplementation::SubscriberMap::ResolveEventNames(const string& key) {
+            auto it = mEventNames.find(key);
+            if (it == mEventNames.end()) {
+                if (mEventNames.size() >= MaxCachedEventNames) {
+                    mEventNames.clear();
+                }
+                EventNames names;
+                names.lowerKey = StringUtils::toLower(key);
+                // Remove version information from the event key to match subscription keys
+                names.dispatchName = ContextUtils::GetBaseEventNameFromVersionedEvent(key);
+                it = mEventNames.emplace(key, std::move(names)).first;
+            }
+            return it->second;
         }
 
         void AppNotificationsImplementation::SubscriberMap::Dispatch(const string& key, const Exchange::IAppNotifications::AppNotificationContext& context, const string& payload) {
@@ -200,12 +308,56 @@ namespace WPEFramework
                     return;
                 } else {
                     LOGINFO("AppGateway Responder interface acquired successfully");
+                    // This consumer may not know about frames queued before it came up
+                    mEventRingDoorbellPending = true;
                 }
             }
             Exchange::GatewayContext gatewayContext = ContextUtils::ConvertNotificationToAppGatewayContext(context);
+            if (mEventRing.IsOpen()) {
+                if (mEventRingBypass && mEventRing.IsEmpty()) {
+                    LOGINFO("Event ring drained, gateway events use it again");
+                    mEventRingBypass = false;
+                }
+                if (!mEventRingBypass) {
+                    bool wasEmpty = false;
+                    const bool queued = mEventRing.Push(gatewayContext.connectionId, gatewayContext.requestId, key, payload, wasEmpty);
+                    if (wasEmpty || mEventRingDoorbellPending || !queued) {
+                        RingEventDoorbell();
+                    }
+                    if (queued) {
+                        return;
+                    }
+                    // Full ring or oversized event: waiting for the gateway here would hold up
+                    // every other dispatch, so this event goes out directly and may overtake
+                    // the frames still queued. The ones after it follow it directly.
+                    if (!mEventRing.IsEmpty()) {
+                        LOGWARN("Event ring full, gateway events go out directly until it is drained");
+                        mEventRingBypass = true;
+                    }
+                }
+            }
             mAppGateway->Emit(gatewayContext, key, payload);
         }
 
+        void AppNotificationsImplementation::SubscriberMap::RingEventDoorbell() {
+            // Ring again after a failed doorbell so queued frames are not stranded
+            Exchange::GatewayContext doorbell = {};
+            mEventRingDoorbellPending = (mAppGateway->Emit(doorbell, APP_GATEWAY_EVENT_RING_DOORBELL, mEventRing.DoorbellPayload()) != Core::ERROR_NONE);
+        }
+
+        bool AppNotificationsImplementation::SubscriberMap::OpenEventRing(const uint32_t size) {
+            Core::SafeSyncType<Core::CriticalSection> lock(mAppGatewayLock);
+            const string name = APP_GATEWAY_EVENT_RING_PREFIX + std::to_string(::getpid());
+            if (!mEventRing.Create(name, size)) {
+                LOGERR("Failed to create event ring %s, events go to the gateway one by one", name.c_str());
+                return false;
+            }
+            mEventRingDoorbellPending = false;
+            mEventRingBypass = false;
+            LOGINFO("Event ring %s with %u bytes", name.c_str(), mEventRing.Capacity());
+            return true;
+        }
+
         void AppNotificationsImplementation::SubscriberMap::DispatchToLaunchDelegate(const string& key, const Exchange::IAppNotifications::AppNotificationContext& context, const string& payload) {
             Core::SafeSyncType<Core::CriticalSection> lock(mInternalGatewayNotifierLock);
             if (nullptr == mInternalGatewayNotifier) {
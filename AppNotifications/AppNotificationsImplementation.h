@@ -23,27 +23,63 @@
 #include <interfaces/IConfiguration.h>
 #include <mutex>
 #include <map>
+#include <unordered_map>
+#include <atomic>
 #include "UtilsLogging.h"
 #include "UtilsController.h"
 #include "ContextUtils.h"
 #include "UtilsCallsign.h"
+#include "UtilsJobPool.h"
+#include "UtilsTraceId.h"
+#include "UtilsSharedEventRing.h"
 
 namespace WPEFramework {
 namespace Plugin {
     class AppNotificationsImplementation : public Exchange::IAppNotifications, public Exchange::IConfiguration {
     private:
+        // Default cap on subscriptions held by a single (connectionId, origin); 0 disables the cap
+        static constexpr uint32_t DefaultMaxSubscriptionsPerConnection = 256;
+
+        class Config : public Core::JSON::Container {
+        private:
+            Config(const Config&) = delete;
+            Config& operator=(const Config&) = delete;
+
+        public:
+            Config()
+                : Core::JSON::Container()
+                , MaxSubscriptionsPerConnection(DefaultMaxSubscriptionsPerConnection)
+                , EventRingSize(0)
+            {
+                Add(_T("maxsubscriptionsperconnection"), &MaxSubscriptionsPerConnection);
+                Add(_T("eventringsize"), &EventRingSize);
+            }
+
+        public:
+            Core::JSON::DecUInt32 MaxSubscriptionsPerConnection;
+            // Bytes of shared memory for events to the gateway; 0 sends each one over COM-RPC
+            Core::JSON::DecUInt32 EventRingSize;
+        };
+
         class SubscriberMap {
         public:
             SubscriberMap(AppNotificationsImplementation& parent) : mParent(parent),
             mSubscriberMutex(),
             mSubscribers(),
+            mConnectionSubscriptions(),
+            mEventNames(),
+            mMaxSubscriptionsPerConnection(DefaultMaxSubscriptionsPerConnection),
             mAppGateway(nullptr),
-            mInternalGatewayNotifier(nullptr){}
+            mInternalGatewayNotifier(nullptr),
+            mEventRing(),
+            mEventRingDoorbellPending(false),
+            mEventRingBypass(false){}
 
             ~SubscriberMap() {
                 // cleanup mutex and map
                 std::lock_guard<std::mutex> lock(mSubscriberMutex);
                 mSubscribers.clear();
+                mConnectionSubscriptions.clear();
                 if (mAppGateway != nullptr) {
                     mAppGateway->Release();
                     mAppGateway = nullptr;
@@ -55,7 +91,10 @@ namespace Plugin {
                 }
             }
 
-            void Add(const string& key, const Exchange::IAppNotifications::AppNotificationContext& context);
+            // A subscriber is identified by (event, connectionId, origin). Returns ERROR_NONE when added,
+            // ERROR_DUPLICATE_KEY when an existing subscription was refreshed in place and
+            // ERROR_INVALID_RANGE when the connection already holds the maximum number of subscriptions.
+            Core::hresult Add(const string& key, const Exchange::IAppNotifications::AppNotificationContext& context);
 
             void Remove(const string& key, const Exchange::IAppNotifications::AppNotificationContext& context);
 
@@ -75,14 +114,57 @@ namespace Plugin {
 
             void DispatchToLaunchDelegate(const string& key, const Exchange::IAppNotifications::AppNotificationContext& context, const string& payload);
             void CleanupNotifications(const uint32_t &connectionId, const string& origin);
+
+            void SetMaxSubscriptionsPerConnection(const uint32_t maxSubscriptions);
+
+            // Hands gateway events over through a SharedEventRing of the given size
+            // instead of one Emit() each; the gateway is rung when the ring turns non-empty
+            // and on the first event after the gateway interface is acquired
+            bool OpenEventRing(const uint32_t size);
+
+            uint32_t SubscriptionCount(const uint32_t connectionId, const string& origin) const;
         private:
+            typedef std::pair<uint32_t, string> ConnectionKey;
+
+            // Lookup key and dispatch name derived once per distinct emitted event name
+            struct EventNames {
+                string lowerKey;
+                string dispatchName;
+            };
+
+            // Bounds mEventNames against arbitrary Emit() names
+            static constexpr size_t MaxCachedEventNames = 512;
+
+            // Caller must hold mAppGatewayLock
+            void RingEventDoorbell();
+
+            // Caller must hold mSubscriberMutex
+            const EventNames& ResolveEventNames(const string& key);
+
+            static bool IsSameSubscriber(const Exchange::IAppNotifications::AppNotificationContext& lhs,
+                                         const Exchange::IAppNotifications::AppNotificationContext& rhs) {
+                return (lhs.connectionId == rhs.connectionId) && (lhs.origin == rhs.origin);
+            }
+
+            // Caller must hold mSubscriberMutex
+            void ReleaseConnectionSubscriptions(const ConnectionKey& connection, const uint32_t count);
+
             AppNotificationsImplementation& mParent;
             mutable std::mutex mSubscriberMutex;
             mutable Core::CriticalSection mAppGatewayLock;
             mutable Core::CriticalSection mInternalGatewayNotifierLock;
             std::map<string, std::vector<Exchange::IAppNotifications::AppNotificationContext>> mSubscribers;
+            std::map<ConnectionKey, uint32_t> mConnectionSubscriptions;
+            std::unordered_map<string, EventNames> mEventNames;
+            uint32_t mMaxSubscriptionsPerConnection;
             Exchange::IAppGatewayResponder *mAppGateway;
             Exchange::IAppGatewayResponder *mInternalGatewayNotifier;
+            // Guarded by mAppGatewayLock, which makes this the ring's single producer
+            Utils::SharedEventRing mEventRing;
+            bool mEventRingDoorbellPending;
+            // Set once an event went out directly while frames were still queued; later
+            // events follow it directly until the gateway has emptied the ring
+            bool mEventRingBypass;
         };
 
         // Class to accept the module and event and subscribe to Thunder and use a handler
@@ -158,10 +240,9 @@ namespace Plugin {
         class EXTERNAL SubscriberJob : public Core::IDispatch 
         {
             public:
-                SubscriberJob(AppNotificationsImplementation* delegate, const string& module, const string& event, const bool subscribe)
-                    : mParent(*delegate), mEvent(event), mModule(module), mSubscribe(subscribe) {}
+                SubscriberJob()
+                    : mParent(nullptr), mEvent(), mModule(), mSubscribe(false) {}
 
-                SubscriberJob() = delete;
                 SubscriberJob(const SubscriberJob &) = delete;
                 SubscriberJob &operator=(const SubscriberJob &) = delete;
                 ~SubscriberJob()
@@ -171,20 +252,33 @@ namespace Plugin {
                 static Core::ProxyType<Core::IDispatch> Create(AppNotificationsImplementation *parent,
                 const string& module, const string& event, const bool subscribe)
                 {
-                    return (Core::ProxyType<Core::IDispatch>(Core::ProxyType<SubscriberJob>::Create(parent, module, event, subscribe)));
+                    Core::ProxyType<SubscriberJob> job = Utils::JobPool<SubscriberJob>::Element();
+                    job->mParent = parent;
+                    job->mModule = module;
+                    job->mEvent = event;
+                    job->mSubscribe = subscribe;
+                    return (Core::ProxyType<Core::IDispatch>(job));
                 }
                 
                 virtual void Dispatch()
                 {
                     if (mSubscribe) {
-                        mParent.mThunderManager.Subscribe(mModule, mEvent);
+                        mParent->mThunderManager.Subscribe(mModule, mEvent);
                     } else {
-                        mParent.mThunderManager.Unsubscribe(mModule, mEvent);
+                        mParent->mThunderManager.Unsubscribe(mModule, mEvent);
                     }
                 }
 
+                // Invoked by the job pool on recycle
+                void Clear()
+                {
+                    mParent = nullptr;
+                    mEvent.clear();
+                    mModule.clear();
+                }
+
             private:
-                AppNotificationsImplementation &mParent;
+                AppNotificationsImplementation *mParent;
                 string mEvent;
                 string mModule;
                 bool mSubscribe;
@@ -193,10 +287,9 @@ namespace Plugin {
         class EXTERNAL EmitJob : public Core::IDispatch 
         {
             public:
-                EmitJob(AppNotificationsImplementation* delegate, const string& event, const string& payload, const string& appId)
-                    : mParent(*delegate), mEvent(event), mPayload(payload), mAppId(appId) {}
+                EmitJob()
+                    : mParent(nullptr), mEvent(), mPayload(), mAppId(), mTraceId(0) {}
 
-                EmitJob() = delete;
                 EmitJob(const EmitJob &) = delete;
                 EmitJob &operator=(const EmitJob &) = delete;
                 ~EmitJob()
@@ -206,19 +299,37 @@ namespace Plugin {
                 static Core::ProxyType<Core::IDispatch> Create(AppNotificationsImplementation *parent,
                 const string& event, const string& payload, const string& appId)
                 {
-                    return (Core::ProxyType<Core::IDispatch>(Core::ProxyType<EmitJob>::Create(parent, event, payload, appId)));
+                    Core::ProxyType<EmitJob> job = Utils::JobPool<EmitJob>::Element();
+                    job->mParent = parent;
+                    job->mEvent = event;
+                    job->mPayload = payload;
+                    job->mAppId = appId;
+                    // An emitted event starts its own trace unless it was raised while handling a request
+                    job->mTraceId = Utils::TraceId::CurrentOrNext();
+                    return (Core::ProxyType<Core::IDispatch>(job));
                 }
                 
                 virtual void Dispatch()
                 {
-                    mParent.mSubMap.EventUpdate(mEvent, mPayload, mAppId);
+                    Utils::TraceId::Scope trace(mTraceId);
+                    mParent->mSubMap.EventUpdate(mEvent, mPayload, mAppId);
+                }
+
+                // Invoked by the job pool on recycle
+                void Clear()
+                {
+                    mParent = nullptr;
+                    mEvent.clear();
+                    mPayload.clear();
+                    mAppId.clear();
                 }
 
             private:
-                AppNotificationsImplementation &mParent;
+                AppNotificationsImplementation *mParent;
                 string mEvent;
                 string mPayload;
                 string mAppId;
+                uint64_t mTraceId;
         };
 
         class Emitter: public Exchange::IAppNotificationHandler::IEmitter {
@@ -247,6 +358,8 @@ namespace Plugin {
 
     private:
         PluginHost::IShell* mShell;
+        std::atomic<uint32_t> mDuplicateSubscriptions;
+        std::atomic<uint32_t> mRejectedSubscriptions;
         SubscriberMap mSubMap;
         ThunderSubscriptionManager mThunderManager;
         Core::Sink<Emitter> mEmitter;
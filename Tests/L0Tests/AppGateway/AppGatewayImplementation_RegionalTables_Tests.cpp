@@ -0,0 +1,241 @@
+/**
+ * L0 tests for the per-country resolution tables of AppGatewayImplementation.
+ *
+ *  - Every region of /etc/app-gateway/resolutions.json is compiled once at start-up;
+ *    regions listing the same paths share a table
+ *  - A territory change swaps the active table without reading any file again,
+ *    by Thunder territory (alpha-3) or by the code the region lists
+ *  - Unlisted territories fall back to the default country's table
+ *  - Configure(paths) overrides reach every table, so they survive a switch
+ *
+ * InitializeResolver() and the territory handlers are private; the same
+ * #define private public technique as AppGatewayTelemetry_DirectAccess_Tests.cpp
+ * reaches them without starting the System plugin subscription.
+ */
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include <core/core.h>
+#include <interfaces/IConfiguration.h>
+
+#define private public
+#include <AppGatewayImplementation.h>
+#undef private
+
+#include "ServiceMock.h"
+
+using WPEFramework::Core::ERROR_NONE;
+using WPEFramework::Plugin::AppGatewayImplementation;
+
+namespace {
+
+struct TestResult {
+    uint32_t failures { 0 };
+};
+
+static void ExpectTrue(TestResult& tr, const bool condition, const std::string& what)
+{
+    if (!condition) {
+        tr.failures++;
+        std::cerr << "FAIL: " << what << std::endl;
+    }
+}
+
+static bool WriteTextFile(const std::string& path, const std::string& content)
+{
+    std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+    if (!ofs.is_open()) {
+        return false;
+    }
+    ofs << content;
+    return true;
+}
+
+static std::string BaseResolutionsPath()
+{
+    const char* env = std::getenv("APPGATEWAY_RESOLUTIONS_PATH");
+    if (env != nullptr && *env != '\0') {
+        const std::string path = env;
+        struct stat st;
+        if (stat(path.c_str(), &st) == 0) {
+            return S_ISDIR(st.st_mode) ? (path + "/resolution.base.json") : path;
+        }
+    }
+    const std::string f = __FILE__;
+    const auto pos = f.rfind("/Tests/L0Tests/AppGateway/");
+    return ((pos != std::string::npos) ? f.substr(0, pos) : std::string(".")) + "/AppGateway/resolutions/resolution.base.json";
+}
+
+// Backs up a file for the duration of a test and restores (or removes) it afterwards
+struct FileGuard {
+    explicit FileGuard(const std::string& p)
+        : path(p)
+        , existed(false)
+    {
+        std::ifstream f(p);
+        if (f.is_open()) {
+            saved.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+            existed = true;
+        }
+    }
+    ~FileGuard()
+    {
+        if (existed) {
+            WriteTextFile(path, saved);
+        } else {
+            ::unlink(path.c_str());
+        }
+    }
+    FileGuard(const FileGuard&) = delete;
+    FileGuard& operator=(const FileGuard&) = delete;
+
+    std::string path;
+    std::string saved;
+    bool existed;
+};
+
+// Minimal IStringIterator for Configure(paths)
+class PathIterator : public WPEFramework::Exchange::IAppGatewayResolver::IStringIterator {
+public:
+    explicit PathIterator(const std::vector<std::string>& items)
+        : _items(items)
+        , _index(0)
+        , _refCount(1)
+    {
+    }
+
+    void AddRef() const override { _refCount.fetch_add(1); }
+    uint32_t Release() const override
+    {
+        if (_refCount.fetch_sub(1) == 1) {
+            delete this;
+            return WPEFramework::Core::ERROR_DESTRUCTION_SUCCEEDED;
+        }
+        return WPEFramework::Core::ERROR_NONE;
+    }
+    void* QueryInterface(const uint32_t) override { return nullptr; }
+
+    bool Next(std::string& out) override
+    {
+        if (_index < _items.size()) {
+            out = _items[_index++];
+            return true;
+        }
+        return false;
+    }
+    bool Previous(std::string&) override { return false; }
+    void Reset(const uint32_t) override { _index = 0; }
+    bool IsValid() const override { return (_index > 0) && (_index <= _items.size()); }
+    uint32_t Count() const override { return static_cast<uint32_t>(_items.size()); }
+    std::string Current() const override { return IsValid() ? _items[_index - 1] : std::string(); }
+
+private:
+    std::vector<std::string> _items;
+    uint32_t _index;
+    mutable std::atomic<uint32_t> _refCount;
+};
+
+static void Territory(AppGatewayImplementation& impl, const char* territory)
+{
+    WPEFramework::Core::JSON::VariantContainer params;
+    params[_T("newTerritory")] = territory;
+    impl.OnTerritoryChanged(params);
+}
+
+} // namespace
+
+uint32_t Test_AppGatewayImplementation_RegionalTables_SwitchOnTerritory()
+{
+    TestResult tr;
+
+    const std::string regionalPath = "/etc/app-gateway/resolutions.json";
+    FileGuard guard(regionalPath);
+
+    const std::string tmp = std::string(std::getenv("TMPDIR") ? std::getenv("TMPDIR") : "/tmp");
+    const std::string gbOverride = tmp + "/appgw_l0test_region_gb.json";
+    const std::string lateOverride = tmp + "/appgw_l0test_region_late.json";
+    ExpectTrue(tr, WriteTextFile(gbOverride,
+                   "{\"resolutions\":{\"device.name\":{\"alias\":\"org.rdk.RegionGB.getName\",\"useComRpc\":false}}}"),
+               "write GB overlay");
+    ExpectTrue(tr, WriteTextFile(lateOverride,
+                   "{\"resolutions\":{\"device.make\":{\"alias\":\"org.rdk.Late.getMake\",\"useComRpc\":false}}}"),
+               "write late override");
+
+    const std::string base = BaseResolutionsPath();
+    const std::string regional =
+        "{"
+        "  \"defaultCountryCode\": \"US\","
+        "  \"regions\": ["
+        "    { \"countryCodes\": [\"US\", \"CA\"], \"paths\": [\"" + base + "\"] },"
+        "    { \"countryCodes\": [\"GB\", \"IE\"], \"paths\": [\"" + base + "\", \"" + gbOverride + "\"] },"
+        "    { \"countryCodes\": [\"AU\"], \"paths\": [\"" + base + "\"] }"
+        "  ]"
+        "}";
+    if (!WriteTextFile(regionalPath, regional)) {
+        std::cerr << "NOTE: Skipping Test_AppGatewayImplementation_RegionalTables_SwitchOnTerritory "
+                     "(cannot write to " << regionalPath << ")" << std::endl;
+        return tr.failures;
+    }
+    // Cold load, so the tables really come from the files above
+    ::unlink("/tmp/resolutions.region0.snapshot");
+    ::unlink("/tmp/resolutions.region1.snapshot");
+
+    auto* resolver = WPEFramework::Core::Service<AppGatewayImplementation>::Create<WPEFramework::Exchange::IAppGatewayResolver>();
+    ExpectTrue(tr, resolver != nullptr, "Create AppGatewayImplementation instance");
+    if (resolver == nullptr) {
+        return tr.failures;
+    }
+    AppGatewayImplementation& impl = *static_cast<AppGatewayImplementation*>(resolver);
+
+    L0Test::ServiceMock::Config cfg;
+    auto* service = new L0Test::ServiceMock(cfg, true);
+    service->AddRef();
+    impl.mService = service;
+
+    ExpectTrue(tr, impl.InitializeResolver() == ERROR_NONE, "regional tables compiled");
+    ExpectTrue(tr, impl.mResolvers.size() == 2, "regions with the same paths share a table");
+    ExpectTrue(tr, impl.mRegionalResolvers.size() == 5, "every listed country is indexed");
+
+    const auto us = impl.ActiveResolver();
+    ExpectTrue(tr, (us != nullptr) && (us == impl.mFallbackResolver), "start-up country is the default, US");
+    const std::string baseAlias = (us != nullptr) ? us->ResolveAlias("device.name") : std::string();
+    ExpectTrue(tr, !baseAlias.empty() && (baseAlias != "org.rdk.RegionGB.getName"), "US table has the base alias");
+
+    // A territory change only swaps tables: removing the overlay must not matter
+    ::unlink(gbOverride.c_str());
+    Territory(impl, "GBR");
+    ExpectTrue(tr, impl.ActiveResolver()->ResolveAlias("device.name") == "org.rdk.RegionGB.getName", "GBR switches to the GB table");
+    Territory(impl, "IE");
+    ExpectTrue(tr, impl.ActiveResolver() == impl.mRegionalResolvers["gb"], "a listed code works as is");
+    Territory(impl, "AUS");
+    ExpectTrue(tr, impl.ActiveResolver() == us, "AU shares the US table");
+    Territory(impl, "GBR");
+    Territory(impl, "FRA");
+    ExpectTrue(tr, impl.ActiveResolver() == us, "unlisted territory falls back to the default country");
+
+    WPEFramework::Core::JSON::VariantContainer missing;
+    Territory(impl, "GBR");
+    impl.OnTerritoryChanged(missing);
+    ExpectTrue(tr, impl.ActiveResolver() == impl.mRegionalResolvers["gb"], "event without a territory is ignored");
+
+    PathIterator* paths = new PathIterator({ lateOverride });
+    ExpectTrue(tr, impl.Configure(paths) == ERROR_NONE, "late override loaded");
+    paths->Release();
+    ExpectTrue(tr, impl.ActiveResolver()->ResolveAlias("device.make") == "org.rdk.Late.getMake", "override on the GB table");
+    Territory(impl, "USA");
+    ExpectTrue(tr, impl.ActiveResolver()->ResolveAlias("device.make") == "org.rdk.Late.getMake", "and on the US table");
+
+    resolver->Release();
+    service->Release();
+    ::unlink(lateOverride.c_str());
+    ::unlink("/tmp/resolutions.region0.snapshot");
+    ::unlink("/tmp/resolutions.region1.snapshot");
+
+    return tr.failures;
+}
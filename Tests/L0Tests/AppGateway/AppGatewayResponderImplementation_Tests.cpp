@@ -313,3 +313,60 @@ uint32_t Test_AppGatewayResponderImplementation_Configure_And_Public_Methods_NoC
 
     return tr.failures;
 }
+
+// PUBLIC_INTERFACE
+uint32_t Test_AppGatewayResponderImplementation_Drain_IdleCompletesInTime()
+{
+    // Goal: the plugin finds the drain interface, and a gateway with nothing in flight
+    // drains well within the deadline.
+    TestResult tr;
+
+    L0Test::ServiceMock::Config cfg = MakeResponderServiceConfig();
+    L0Test::ServiceMock service(cfg);
+
+    WPEFramework::Core::Sink<WPEFramework::Plugin::AppGatewayResponderImplementation> responder;
+    ExpectEqU32(tr, responder.Configure(&service), ERROR_NONE, "Configure() returns ERROR_NONE");
+
+    WPEFramework::Plugin::IAppGatewayDrain* drain = responder.QueryInterface<WPEFramework::Plugin::IAppGatewayDrain>();
+    ExpectTrue(tr, drain != nullptr, "responder exposes IAppGatewayDrain");
+    if (drain != nullptr) {
+        const auto start = std::chrono::steady_clock::now();
+        ExpectEqU32(tr, drain->Drain(2000), ERROR_NONE, "Drain() with nothing in flight returns ERROR_NONE");
+        const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        ExpectTrue(tr, elapsedMs < 1000, "Drain() with nothing in flight does not wait for the deadline");
+        drain->Release();
+    }
+
+    return tr.failures;
+}
+
+// PUBLIC_INTERFACE
+uint32_t Test_AppGatewayResponderImplementation_EventRingDoorbell_NeedsKey()
+{
+    // Goal: the reserved doorbell method is only honoured with the key of the ring it
+    // names; a caller without it neither attaches a ring nor displaces the one in use.
+    TestResult tr;
+
+    WPEFramework::Core::Sink<WPEFramework::Plugin::AppGatewayResponderImplementation> responder;
+    const GatewayContext none = MakeContext(0, 0, "");
+
+    WPEFramework::Utils::SharedEventRing producer;
+    const std::string name = std::string(APP_GATEWAY_EVENT_RING_PREFIX) + "l0-doorbell-" + std::to_string(::getpid());
+    ExpectTrue(tr, producer.Create(name, WPEFramework::Utils::SharedEventRing::MinimumCapacity), "ring created");
+
+    std::string forged = producer.DoorbellPayload();
+    const size_t key = forged.find("\"key\":\"") + 7;
+    forged[key] = (forged[key] == '0') ? '1' : '0';
+
+    ExpectEqU32(tr, responder.Emit(none, APP_GATEWAY_EVENT_RING_DOORBELL, "{\"ring\":\"" + name + "\"}"),
+                WPEFramework::Core::ERROR_BAD_REQUEST, "doorbell without a key is refused");
+    ExpectEqU32(tr, responder.Emit(none, APP_GATEWAY_EVENT_RING_DOORBELL, forged),
+                WPEFramework::Core::ERROR_UNAVAILABLE, "doorbell with the wrong key does not attach");
+    ExpectEqU32(tr, responder.Emit(none, APP_GATEWAY_EVENT_RING_DOORBELL, producer.DoorbellPayload()),
+                ERROR_NONE, "doorbell with the ring's key attaches");
+    ExpectEqU32(tr, responder.Emit(none, APP_GATEWAY_EVENT_RING_DOORBELL, forged),
+                WPEFramework::Core::ERROR_PRIVILIGED_REQUEST, "attached ring does not answer the wrong key");
+
+    DrainAsyncResponderJobs();
+    return tr.failures;
+}
@@ -29,6 +29,7 @@
 #include <core/core.h>
 
 #include "AppGatewayTelemetry.h"
+#include "AppGatewayTelemetryCodec.h"
 #include "ServiceMock.h"
 #include "AppGatewayTelemetryMarkers.h"
 
@@ -37,6 +38,9 @@ using WPEFramework::Core::ERROR_UNAVAILABLE;
 using WPEFramework::Exchange::GatewayContext;
 using WPEFramework::Plugin::AppGatewayTelemetry;
 using WPEFramework::Plugin::TelemetryFormat;
+using WPEFramework::Plugin::TelemetryBatchCodec;
+using WPEFramework::Plugin::TelemetryBatchDecoder;
+using WPEFramework::Plugin::TelemetryBatchEncoder;
 
 namespace {
 
@@ -745,3 +749,113 @@ uint32_t Test_Telemetry_Compact_ArrayPayload()
 
     return tr.failures;
 }
+
+// ---------------------------------------------------------------------------
+// Test 23: Binary flush batch round trip - chunks decode (in any order) to the
+//          same marker/payload pairs the JSON path sends, keys are shared
+// ---------------------------------------------------------------------------
+uint32_t Test_Telemetry_BinaryBatch_RoundTrip()
+{
+    TestResult tr;
+
+    TelemetryBatchEncoder encoder(3600);
+    encoder.AddHealth(2, 10, 9, 8, 1);
+    encoder.AddMethodStats(TelemetryBatchCodec::KindApiMethod, "FlushPlugin", "device.name",
+                           3, 1.5, 4.25, 2.5, 0, 0.0, 0.0, 0.0);
+    encoder.AddMethodStats(TelemetryBatchCodec::KindServiceMethod, "FlushPlugin", "permSvc",
+                           0, 0.0, 0.0, 0.0, 2, 3.0, 5.0, 4.0);
+    encoder.AddLatencyStats(TelemetryBatchCodec::KindApiLatency, "FlushPlugin", "device.name", 4, 2.5, 1.0, 5.0);
+    encoder.AddErrorCount(TelemetryBatchCodec::KindServiceError, "Quoted\"Svc", 7);
+    encoder.AddMetric("ENTS_INFO_AppGwCustomMetric", AGW_UNIT_COUNT, 2, 42.0, 99.0, 70.5);
+    ExpectEqU32(tr, encoder.RecordCount(), 6, "six records encoded");
+
+    std::vector<std::string> chunks;
+    encoder.Finish(9, 48, chunks);
+    ExpectTrue(tr, chunks.size() > 1, "small chunk size splits the batch");
+    ExpectTrue(tr, chunks.front().compare(0, 4, "9.1/") == 0, "chunk carries sequence and part");
+
+    std::vector<std::string> reversed(chunks.rbegin(), chunks.rend());
+    std::vector<TelemetryBatchDecoder::Event> events;
+    std::string error;
+    ExpectTrue(tr, TelemetryBatchDecoder::DecodeChunks(reversed, events, error), "batch decodes: " + error);
+    ExpectEqU32(tr, static_cast<uint32_t>(events.size()), 6, "one event per record");
+
+    if (events.size() == 6) {
+        ExpectTrue(tr, events[0].first == AGW_MARKER_HEALTH_STATS, "health marker");
+        ExpectTrue(tr, events[0].second == "{\"reporting_interval_sec\":3600,\"websocket_connections\":2,\"total_calls\":10,"
+                                           "\"total_responses\":9,\"successful_calls\":8,\"failed_calls\":1,\"unit\":\"count\"}",
+                   "health payload: " + events[0].second);
+        ExpectTrue(tr, events[1].first == AGW_MARKER_API_METHOD_STAT, "api method marker");
+        ExpectTrue(tr, events[1].second == "{\"plugin_name\":\"FlushPlugin\",\"method_name\":\"device.name\",\"reporting_interval_sec\":3600,"
+                                           "\"success_count\":3,\"success_latency_min_ms\":1.5,\"success_latency_max_ms\":4.25,"
+                                           "\"success_latency_avg_ms\":2.5,\"error_count\":0,\"total_count\":3}",
+                   "api method payload: " + events[1].second);
+        ExpectTrue(tr, events[2].first == AGW_MARKER_SERVICE_METHOD_STAT, "service method marker");
+        ExpectTrue(tr, events[2].second == "{\"plugin_name\":\"FlushPlugin\",\"service_name\":\"permSvc\",\"reporting_interval_sec\":3600,"
+                                           "\"success_count\":0,\"error_count\":2,\"error_latency_min_ms\":3,"
+                                           "\"error_latency_max_ms\":5,\"error_latency_avg_ms\":4}",
+                   "service method payload: " + events[2].second);
+        ExpectTrue(tr, events[3].first == AGW_MARKER_API_LATENCY, "api latency marker");
+        ExpectTrue(tr, events[4].first == AGW_MARKER_EXT_SERVICE_ERROR_COUNT, "ext service error marker");
+        ExpectTrue(tr, events[4].second == "{\"reporting_interval_sec\":3600,\"ServiceName\":\"Quoted\\\"Svc\",\"count\":7,\"unit\":\"count\"}",
+                   "ext service error payload: " + events[4].second);
+        ExpectTrue(tr, events[5].first == "ENTS_INFO_AppGwCustomMetric", "generic metric uses its own marker");
+        ExpectTrue(tr, events[5].second == "{\"min\":42,\"max\":99,\"count\":2,\"avg\":70.5,\"unit\":\"count\",\"reporting_interval_sec\":3600}",
+                   "generic metric payload: " + events[5].second);
+    }
+
+    // A missing chunk is reported rather than decoded
+    std::vector<std::string> partial(chunks.begin() + 1, chunks.end());
+    partial.push_back(chunks.back());
+    events.clear();
+    ExpectTrue(tr, !TelemetryBatchDecoder::DecodeChunks(partial, events, error), "incomplete batch rejected");
+
+    // Names past the u16 key space collapse to the reserved empty key
+    TelemetryBatchEncoder crowded(60);
+    for (uint32_t index = 0; index < 0x10008; ++index) {
+        crowded.AddErrorCount(TelemetryBatchCodec::KindApiError, "api" + std::to_string(index), 1);
+    }
+    chunks.clear();
+    crowded.Finish(10, 0, chunks);
+    events.clear();
+    ExpectTrue(tr, TelemetryBatchDecoder::DecodeChunks(chunks, events, error), "crowded batch decodes: " + error);
+    ExpectEqU32(tr, static_cast<uint32_t>(events.size()), 0x10008, "every crowded record decodes");
+    if (events.size() == 0x10008) {
+        ExpectTrue(tr, events.front().second.find("\"api0\"") != std::string::npos, "first name keeps its key");
+        ExpectTrue(tr, events.back().second.find("\"api65543\"") == std::string::npos, "overflowing name collapses");
+    }
+
+    return tr.failures;
+}
+
+// ---------------------------------------------------------------------------
+// Test 24: Flush in BINARY format → TelemetrySnapshot::SendBinaryBatch; immediate
+//          events keep their JSON payloads
+// ---------------------------------------------------------------------------
+uint32_t Test_Telemetry_Flush_BinaryFormat()
+{
+    TestResult tr;
+    TelemetryGuard guard;
+
+    auto& t = AppGatewayTelemetry::getInstance();
+    const auto ctx = MakeCtx(200, 200, "com.test.binary");
+
+    t.SetTelemetryFormat(TelemetryFormat::BINARY);
+    ExpectTrue(tr, t.GetTelemetryFormat() == TelemetryFormat::BINARY, "format is BINARY");
+
+    t.IncrementTotalCalls(ctx);
+    const std::string apiSuccessMetric =
+        std::string(AGW_INTERNAL_PLUGIN_PREFIX) + "BinaryPlugin_MethodName_binaryMethod_Success_split";
+    t.RecordTelemetryMetric(ctx, apiSuccessMetric, 12.0, AGW_UNIT_MILLISECONDS);
+    t.RecordApiError(ctx, "BinaryApi");
+    t.RecordTelemetryMetric(ctx, "ENTS_INFO_AppGwBinaryTest", 3.0, AGW_UNIT_COUNT);
+
+    t.FlushTelemetryData();
+
+    // Nothing left to report → empty batch is not sent
+    t.FlushTelemetryData();
+
+    t.SetTelemetryFormat(TelemetryFormat::JSON);
+
+    return tr.failures;
+}
@@ -76,6 +76,8 @@ extern uint32_t Test_AppGatewayResponderImplementation_Register_Unregister_And_C
 extern uint32_t Test_AppGatewayResponderImplementation_GetGatewayConnectionContext_EnvInjection_And_EmptyKey();
 extern uint32_t Test_AppGatewayResponderImplementation_RecordGatewayConnectionContext_DebugOps();
 extern uint32_t Test_AppGatewayResponderImplementation_Configure_And_Public_Methods_NoCrash();
+extern uint32_t Test_AppGatewayResponderImplementation_Drain_IdleCompletesInTime();
+extern uint32_t Test_AppGatewayResponderImplementation_EventRingDoorbell_NeedsKey();
 
 // AppGatewayTelemetry coverage tests
 extern uint32_t Test_Telemetry_SettersAndConfig();
@@ -101,6 +103,30 @@ extern uint32_t Test_Telemetry_ResponsePayloadTracking_ErrorResponse();
 extern uint32_t Test_Telemetry_SendT2Event_NonJsonPayload();
 extern uint32_t Test_Telemetry_Compact_FloatAndBoolean();
 extern uint32_t Test_Telemetry_Compact_ArrayPayload();
+extern uint32_t Test_Telemetry_BinaryBatch_RoundTrip();
+extern uint32_t Test_Telemetry_Flush_BinaryFormat();
+// WebSocket inbound payload kernels and frame tracking
+extern uint32_t Test_WebSocketPayload_KernelsMatchReference();
+extern uint32_t Test_WebSocketPayload_Utf8Validator();
+extern uint32_t Test_WebSocketPayload_InboundFramesUnmask();
+extern uint32_t Test_WebSocketPayload_InboundFramesRejectInvalidText();
+extern uint32_t Test_WebSocketPayload_CloseFrame();
+// Drain accounting
+extern uint32_t Test_DrainTracker_RequestsAndConnections();
+extern uint32_t Test_DrainTracker_DrainWaitsForInFlightWork();
+// Shared memory event ring
+extern uint32_t Test_SharedEventRing_PushDrainInOrder();
+extern uint32_t Test_SharedEventRing_FullAndCorrupt();
+extern uint32_t Test_SharedEventRing_ConcurrentDoorbell();
+extern uint32_t Test_SharedEventRing_DoorbellKey();
+extern uint32_t Test_TelemetryQueue_SlowSenderDropsOldest();
+extern uint32_t Test_TelemetryQueue_BatchAndStop();
+extern uint32_t Test_TelemetryQueue_LargeBatchKept();
+// WsManager streamed outbound messages
+extern uint32_t Test_WsManager_Envelopes_MatchMessageSerialization();
+extern uint32_t Test_WsManager_PreformattedMessage_CopiesInPieces();
+extern uint32_t Test_WsManager_PreformattedMessage_ExactFillEndsMessage();
+extern uint32_t Test_WsManager_ConstantEnvelopes_MatchMessageSerialization();
 // New AppGatewayImplementation coverage tests
 extern uint32_t Test_AppGatewayImplementation_Event_MissingListenParam();
 extern uint32_t Test_AppGatewayImplementation_UpdateContext_NonJsonParams();
@@ -108,6 +134,7 @@ extern uint32_t Test_AppGatewayImplementation_ComRpc_AdditionalContext_NotObject
 extern uint32_t Test_AppGatewayImplementation_Resolve_BeforeShellConfigure();
 extern uint32_t Test_AppGatewayImplementation_Resolve_NotConfigured();
 extern uint32_t Test_AppGatewayImplementation_RegionalConfig();
+extern uint32_t Test_AppGatewayImplementation_RegionalTables_SwitchOnTerritory();
 
 // Direct-access coverage tests (use #define private public to reach private Send* and FlushJob methods)
 extern uint32_t Test_Telemetry_DirectAccess_AlreadyInitialized();
@@ -493,6 +520,8 @@ int main()
         { "AppGatewayResponderImplementation_GetGatewayConnectionContext_EnvInjection_And_EmptyKey", Test_AppGatewayResponderImplementation_GetGatewayConnectionContext_EnvInjection_And_EmptyKey },
         { "AppGatewayResponderImplementation_RecordGatewayConnectionContext_DebugOps", Test_AppGatewayResponderImplementation_RecordGatewayConnectionContext_DebugOps },
         { "AppGatewayResponderImplementation_Configure_And_Public_Methods_NoCrash", Test_AppGatewayResponderImplementation_Configure_And_Public_Methods_NoCrash },
+        { "AppGatewayResponderImplementation_Drain_IdleCompletesInTime", Test_AppGatewayResponderImplementation_Drain_IdleCompletesInTime },
+        { "AppGatewayResponderImplementation_EventRingDoorbell_NeedsKey", Test_AppGatewayResponderImplementation_EventRingDoorbell_NeedsKey },
 
         // AppGatewayTelemetry coverage tests
         { "Telemetry_SettersAndConfig", Test_Telemetry_SettersAndConfig },
@@ -518,6 +547,30 @@ int main()
         { "Telemetry_SendT2Event_NonJsonPayload", Test_Telemetry_SendT2Event_NonJsonPayload },
         { "Telemetry_Compact_FloatAndBoolean", Test_Telemetry_Compact_FloatAndBoolean },
         { "Telemetry_Compact_ArrayPayload", Test_Telemetry_Compact_ArrayPayload },
+        { "Telemetry_BinaryBatch_RoundTrip", Test_Telemetry_BinaryBatch_RoundTrip },
+        { "Telemetry_Flush_BinaryFormat", Test_Telemetry_Flush_BinaryFormat },
+        // WebSocket inbound payload kernels and frame tracking
+        { "WebSocketPayload_KernelsMatchReference", Test_WebSocketPayload_KernelsMatchReference },
+        { "WebSocketPayload_Utf8Validator", Test_WebSocketPayload_Utf8Validator },
+        { "WebSocketPayload_InboundFramesUnmask", Test_WebSocketPayload_InboundFramesUnmask },
+        { "WebSocketPayload_InboundFramesRejectInvalidText", Test_WebSocketPayload_InboundFramesRejectInvalidText },
+        { "WebSocketPayload_CloseFrame", Test_WebSocketPayload_CloseFrame },
+        // Drain accounting
+        { "DrainTracker_RequestsAndConnections", Test_DrainTracker_RequestsAndConnections },
+        { "DrainTracker_DrainWaitsForInFlightWork", Test_DrainTracker_DrainWaitsForInFlightWork },
+        // Shared memory event ring
+        { "SharedEventRing_PushDrainInOrder", Test_SharedEventRing_PushDrainInOrder },
+        { "SharedEventRing_FullAndCorrupt", Test_SharedEventRing_FullAndCorrupt },
+        { "SharedEventRing_ConcurrentDoorbell", Test_SharedEventRing_ConcurrentDoorbell },
+        { "SharedEventRing_DoorbellKey", Test_SharedEventRing_DoorbellKey },
+        { "TelemetryQueue_SlowSenderDropsOldest", Test_TelemetryQueue_SlowSenderDropsOldest },
+        { "TelemetryQueue_BatchAndStop", Test_TelemetryQueue_BatchAndStop },
+        { "TelemetryQueue_LargeBatchKept", Test_TelemetryQueue_LargeBatchKept },
+        // WsManager streamed outbound messages
+        { "WsManager_Envelopes_MatchMessageSerialization", Test_WsManager_Envelopes_MatchMessageSerialization },
+        { "WsManager_PreformattedMessage_CopiesInPieces", Test_WsManager_PreformattedMessage_CopiesInPieces },
+        { "WsManager_PreformattedMessage_ExactFillEndsMessage", Test_WsManager_PreformattedMessage_ExactFillEndsMessage },
+        { "WsManager_ConstantEnvelopes_MatchMessageSerialization", Test_WsManager_ConstantEnvelopes_MatchMessageSerialization },
         // New AppGatewayImplementation coverage tests
         { "AppGatewayImplementation_Event_MissingListenParam", Test_AppGatewayImplementation_Event_MissingListenParam },
         { "AppGatewayImplementation_UpdateContext_NonJsonParams", Test_AppGatewayImplementation_UpdateContext_NonJsonParams },
@@ -525,6 +578,7 @@ int main()
         { "AppGatewayImplementation_Resolve_BeforeShellConfigure", Test_AppGatewayImplementation_Resolve_BeforeShellConfigure },
         { "AppGatewayImplementation_Resolve_NotConfigured", Test_AppGatewayImplementation_Resolve_NotConfigured },
         { "AppGatewayImplementation_RegionalConfig", Test_AppGatewayImplementation_RegionalConfig },
+        { "AppGatewayImplementation_RegionalTables_SwitchOnTerritory", Test_AppGatewayImplementation_RegionalTables_SwitchOnTerritory },
 
         // Direct-access coverage tests (private Send* and FlushJob methods)
         { "Telemetry_DirectAccess_AlreadyInitialized", Test_Telemetry_DirectAccess_AlreadyInitialized },
@@ -0,0 +1,99 @@
+/**
+ * L0 tests for helpers/UtilsDrainTracker.h
+ *
+ *  - Requests are tracked per connection and request ID until completed, or
+ *    until their connection goes away
+ *  - Draining refuses new requests and admitted jobs but still counts
+ *    follow-on jobs; Wait() returns as soon as the last one is done, or
+ *    reports a timeout with what was left
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "UtilsDrainTracker.h"
+
+using WPEFramework::Utils::DrainTracker;
+
+namespace {
+
+struct TestResult {
+    uint32_t failures { 0 };
+};
+
+static void ExpectTrue(TestResult& tr, const bool condition, const std::string& what)
+{
+    if (!condition) {
+        tr.failures++;
+        std::cerr << "FAIL: " << what << std::endl;
+    }
+}
+
+} // namespace
+
+uint32_t Test_DrainTracker_RequestsAndConnections()
+{
+    TestResult tr;
+    DrainTracker tracker;
+
+    ExpectTrue(tr, tracker.Wait(0), "idle tracker is drained at once");
+    ExpectTrue(tr, tracker.Accept(1, 10) && tracker.Accept(1, 11) && tracker.Accept(2, 10), "requests accepted");
+    ExpectTrue(tr, tracker.Accept(1, 10), "a reused request ID is counted again");
+    ExpectTrue(tr, tracker.Requests() == 4, "four requests in flight");
+
+    tracker.Complete(1, 10);
+    ExpectTrue(tr, tracker.Requests() == 3, "one of the reused IDs completed");
+    tracker.Complete(3, 10);
+    tracker.Complete(2, 99);
+    ExpectTrue(tr, tracker.Requests() == 3, "unknown requests are ignored");
+
+    tracker.CompleteConnection(1);
+    ExpectTrue(tr, tracker.Requests() == 1, "connection 1 going away ends its requests");
+    tracker.Complete(2, 10);
+    ExpectTrue(tr, (tracker.Requests() == 0) && tracker.Wait(0), "drained after the last request");
+
+    return tr.failures;
+}
+
+uint32_t Test_DrainTracker_DrainWaitsForInFlightWork()
+{
+    TestResult tr;
+    DrainTracker tracker;
+
+    ExpectTrue(tr, tracker.Accept(5, 1), "request accepted before draining");
+    ExpectTrue(tr, tracker.AdmitJob(), "job admitted before draining");
+
+    tracker.Begin();
+    ExpectTrue(tr, tracker.IsDraining(), "draining");
+    ExpectTrue(tr, !tracker.Accept(5, 2), "new requests refused while draining");
+    ExpectTrue(tr, !tracker.AdmitJob(), "new jobs refused while draining");
+    tracker.AddJob();
+    ExpectTrue(tr, tracker.Jobs() == 2, "follow-on job counted while draining");
+
+    ExpectTrue(tr, !tracker.Wait(20), "times out while work is in flight");
+    ExpectTrue(tr, (tracker.Requests() == 1) && (tracker.Jobs() == 2), "reports what is left");
+
+    std::thread worker([&tracker]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        tracker.JobDone();
+        tracker.Complete(5, 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        tracker.JobDone();
+    });
+    const auto start = std::chrono::steady_clock::now();
+    const bool drained = tracker.Wait(5000);
+    const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    worker.join();
+    ExpectTrue(tr, drained, "drained once the work finished");
+    ExpectTrue(tr, elapsedMs < 2000, "Wait() returns when the last job is done, not at the deadline");
+
+    tracker.JobDone();
+    ExpectTrue(tr, tracker.Jobs() == 0, "surplus JobDone() does not underflow");
+
+    tracker.Resume();
+    ExpectTrue(tr, !tracker.IsDraining() && tracker.Accept(5, 3), "accepts again after Resume()");
+
+    return tr.failures;
+}
@@ -0,0 +1,242 @@
+/**
+ * L0 tests for helpers/UtilsSharedEventRing.h
+ *
+ *  - A consumer attached by name and key drains the producer's frames in order,
+ *    across the wrap of the ring, and the producer only asks for a doorbell
+ *    when the ring turns non-empty
+ *  - A full ring or an oversized frame is refused rather than overwritten;
+ *    a corrupt record drops the rest of the ring instead of being followed
+ *  - Frames pushed while another thread drains are all delivered once
+ *  - The doorbell payload round-trips; a wrong key or a ring open to other
+ *    users is not attached, and the ring attached before stays in use
+ */
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "UtilsSharedEventRing.h"
+
+using WPEFramework::Utils::SharedEventRing;
+
+namespace {
+
+struct TestResult {
+    uint32_t failures { 0 };
+};
+
+static void ExpectTrue(TestResult& tr, const bool condition, const std::string& what)
+{
+    if (!condition) {
+        tr.failures++;
+        std::cerr << "FAIL: " << what << std::endl;
+    }
+}
+
+static std::string RingName(const char* test)
+{
+    return std::string(APP_GATEWAY_EVENT_RING_PREFIX) + "l0-" + test + "-" + std::to_string(::getpid());
+}
+
+} // namespace
+
+uint32_t Test_SharedEventRing_PushDrainInOrder()
+{
+    TestResult tr;
+    const std::string name = RingName("order");
+    SharedEventRing producer;
+    SharedEventRing consumer;
+
+    ExpectTrue(tr, !consumer.Attach(name, 1), "nothing to attach to before Create()");
+    ExpectTrue(tr, producer.Create(name, 100), "ring created");
+    ExpectTrue(tr, producer.Capacity() == SharedEventRing::MinimumCapacity, "small sizes are raised to the minimum");
+    ExpectTrue(tr, producer.Key() != 0, "ring has a key");
+    ExpectTrue(tr, consumer.Attach(name, producer.Key()) && (consumer.Capacity() == producer.Capacity()), "consumer attached by name and key");
+
+    bool wasEmpty = false;
+    ExpectTrue(tr, producer.Push(1, 10, "Lifecycle.onStateChanged", "{\"state\":\"active\"}", wasEmpty) && wasEmpty,
+               "first frame asks for the doorbell");
+    ExpectTrue(tr, producer.Push(2, 20, "Device.onNameChanged", "\"Living Room\"", wasEmpty) && !wasEmpty,
+               "second frame does not");
+    ExpectTrue(tr, producer.Push(3, 0, "Empty.onPayload", "", wasEmpty) && !wasEmpty, "empty payload queued");
+
+    std::vector<SharedEventRing::Frame> frames;
+    uint32_t corrupt = 0;
+    const uint32_t delivered = consumer.Drain([&frames](const SharedEventRing::Frame& frame) { frames.push_back(frame); }, corrupt);
+    ExpectTrue(tr, (delivered == 3) && (frames.size() == 3) && (corrupt == 0), "three frames delivered");
+    if (frames.size() == 3) {
+        ExpectTrue(tr, (frames[0].connectionId == 1) && (frames[0].requestId == 10) && (frames[0].method == "Lifecycle.onStateChanged")
+                       && (frames[0].payload == "{\"state\":\"active\"}"), "first frame intact");
+        ExpectTrue(tr, (frames[1].connectionId == 2) && (frames[1].method == "Device.onNameChanged") && (frames[1].payload == "\"Living Room\""),
+                   "second frame intact");
+        ExpectTrue(tr, (frames[2].connectionId == 3) && frames[2].payload.empty(), "third frame intact");
+    }
+    ExpectTrue(tr, producer.Push(1, 11, "Lifecycle.onStateChanged", "{}", wasEmpty) && wasEmpty, "drained ring asks for the doorbell again");
+
+    // Frames of about a fifth of the ring wrap many times over
+    const std::string payload(SharedEventRing::MinimumCapacity / 5, 'x');
+    uint32_t pushed = 1;
+    uint32_t received = 0;
+    bool ordered = true;
+    for (uint32_t round = 0; round < 50; ++round) {
+        while (producer.Push(9, pushed, "Bulk.onEvent", payload, wasEmpty)) {
+            ++pushed;
+        }
+        consumer.Drain([&](const SharedEventRing::Frame& frame) {
+            ordered = ordered && (frame.requestId == ((received == 0) ? 11 : received)) && ((received == 0) || (frame.payload == payload));
+            ++received;
+        }, corrupt);
+    }
+    ExpectTrue(tr, ordered && (received == pushed) && (corrupt == 0), "frames stay in order across the wrap");
+
+    producer.Close();
+    SharedEventRing late;
+    ExpectTrue(tr, !late.Attach(name, consumer.Key()), "the producer removes the ring on Close()");
+
+    return tr.failures;
+}
+
+uint32_t Test_SharedEventRing_FullAndCorrupt()
+{
+    TestResult tr;
+    const std::string name = RingName("bounds");
+    SharedEventRing producer;
+    SharedEventRing consumer;
+    ExpectTrue(tr, producer.Create(name, SharedEventRing::MinimumCapacity) && consumer.Attach(name, producer.Key()), "ring created and attached");
+
+    bool wasEmpty = false;
+    const std::string oversized(SharedEventRing::MinimumCapacity, 'o');
+    ExpectTrue(tr, !producer.Push(1, 1, "Big.onEvent", oversized, wasEmpty) && !wasEmpty, "frame larger than the ring refused");
+
+    const std::string payload(1000, 'p');
+    uint32_t queued = 0;
+    while (producer.Push(1, queued, "Fill.onEvent", payload, wasEmpty)) {
+        ++queued;
+    }
+    ExpectTrue(tr, queued == 3, "ring holds what fits");
+    ExpectTrue(tr, !producer.Push(1, 99, "Fill.onEvent", payload, wasEmpty), "full ring refuses instead of overwriting");
+
+    uint32_t corrupt = 0;
+    uint32_t delivered = consumer.Drain([](const SharedEventRing::Frame&) {}, corrupt);
+    ExpectTrue(tr, (delivered == queued) && (corrupt == 0), "full ring drained");
+
+    // Damage the length of the next record from outside, as a misbehaving peer could
+    ExpectTrue(tr, producer.Push(2, 1, "Next.onEvent", "{}", wasEmpty), "frame queued");
+    const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    struct stat info;
+    ExpectTrue(tr, (fd >= 0) && (::fstat(fd, &info) == 0), "ring opened from outside");
+    if (fd >= 0) {
+        uint8_t* base = static_cast<uint8_t*>(::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+        ::close(fd);
+        if (base != MAP_FAILED) {
+            uint8_t* data = base + (static_cast<size_t>(info.st_size) - producer.Capacity());
+            const uint32_t offset = (queued * ((24 + 12 + 1000 + 7) & ~7u)) % producer.Capacity();
+            const uint32_t bogus = 0xFFFFFFF0;
+            ::memcpy(data + offset + 4 * sizeof(uint32_t), &bogus, sizeof(bogus));
+            ::munmap(base, static_cast<size_t>(info.st_size));
+        }
+    }
+    delivered = consumer.Drain([](const SharedEventRing::Frame&) {}, corrupt);
+    ExpectTrue(tr, (delivered == 0) && (corrupt == 1), "corrupt record dropped, not followed");
+    ExpectTrue(tr, producer.Push(2, 2, "After.onEvent", "{}", wasEmpty) && wasEmpty, "ring usable after the corrupt record");
+    delivered = consumer.Drain([](const SharedEventRing::Frame&) {}, corrupt);
+    ExpectTrue(tr, (delivered == 1) && (corrupt == 0), "later frames delivered");
+
+    return tr.failures;
+}
+
+uint32_t Test_SharedEventRing_ConcurrentDoorbell()
+{
+    TestResult tr;
+    const std::string name = RingName("doorbell");
+    SharedEventRing producer;
+    SharedEventRing consumer;
+    ExpectTrue(tr, producer.Create(name, SharedEventRing::MinimumCapacity) && consumer.Attach(name, producer.Key()), "ring created and attached");
+
+    // The consumer only drains when rung, as the gateway does
+    static constexpr uint32_t Frames = 20000;
+    std::atomic<uint32_t> doorbells { 0 };
+    std::atomic<bool> done { false };
+    uint32_t received = 0;
+    bool ordered = true;
+    std::thread worker([&]() {
+        uint32_t handled = 0;
+        uint32_t corrupt = 0;
+        while (!done || (handled != doorbells)) {
+            if (handled == doorbells) {
+                std::this_thread::yield();
+                continue;
+            }
+            ++handled;
+            consumer.Drain([&](const SharedEventRing::Frame& frame) {
+                ordered = ordered && (frame.requestId == received);
+                ++received;
+            }, corrupt);
+        }
+    });
+
+    for (uint32_t index = 0; index < Frames;) {
+        bool wasEmpty = false;
+        if (producer.Push(1, index, "Stress.onEvent", std::to_string(index), wasEmpty)) {
+            ++index;
+            if (wasEmpty) {
+                ++doorbells;
+            }
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    done = true;
+    worker.join();
+
+    ExpectTrue(tr, ordered && (received == Frames), "every frame delivered once, in order, by doorbells alone");
+
+    return tr.failures;
+}
+
+uint32_t Test_SharedEventRing_DoorbellKey()
+{
+    TestResult tr;
+    const std::string name = RingName("key");
+    SharedEventRing producer;
+    SharedEventRing consumer;
+    ExpectTrue(tr, producer.Create(name, SharedEventRing::MinimumCapacity), "ring created");
+
+    std::string parsedName;
+    uint64_t parsedKey = 0;
+    ExpectTrue(tr, SharedEventRing::ParseDoorbellPayload(producer.DoorbellPayload(), parsedName, parsedKey)
+                   && (parsedName == name) && (parsedKey == producer.Key()), "doorbell names the ring and carries its key");
+    ExpectTrue(tr, !SharedEventRing::ParseDoorbellPayload("{\"ring\":\"" + name + "\"}", parsedName, parsedKey), "doorbell without a key refused");
+    ExpectTrue(tr, !SharedEventRing::ParseDoorbellPayload("{\"ring\":\"" + name + "\",\"key\":\"00000000000000zz\"}", parsedName, parsedKey),
+               "doorbell with a malformed key refused");
+
+    ExpectTrue(tr, !consumer.Attach(name, producer.Key() ^ 1), "wrong key not attached");
+    ExpectTrue(tr, consumer.Attach(name, producer.Key()), "right key attached");
+
+    // A ring others could write to is not taken, and does not displace the one in use
+    const std::string open = RingName("open");
+    SharedEventRing other;
+    ExpectTrue(tr, other.Create(open, SharedEventRing::MinimumCapacity), "second ring created");
+    const int fd = ::shm_open(open.c_str(), O_RDWR, 0);
+    ExpectTrue(tr, (fd >= 0) && (::fchmod(fd, 0666) == 0), "second ring opened up to other users");
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    ExpectTrue(tr, !consumer.Attach(open, other.Key()), "ring open to other users not attached");
+    ExpectTrue(tr, consumer.Name() == name, "ring attached before stays in use");
+
+    bool wasEmpty = false;
+    uint32_t corrupt = 0;
+    ExpectTrue(tr, producer.Push(1, 1, "Key.onEvent", "{}", wasEmpty), "frame queued");
+    ExpectTrue(tr, consumer.Drain([](const SharedEventRing::Frame&) {}, corrupt) == 1, "frame delivered through the ring in use");
+
+    return tr.failures;
+}
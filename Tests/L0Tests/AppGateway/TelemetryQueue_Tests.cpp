@@ -0,0 +1,223 @@
+/**
+ * L0 tests for helpers/UtilsTelemetryQueue.h
+ *
+ *  - Post() returns while the sender is stuck; a full queue drops its oldest
+ *    markers, counts them once for reporting, and keeps the newest
+ *  - A Batch keeps the sender asleep until the whole flush is queued, and
+ *    Stop() delivers what is left (or drops it after the timeout)
+ *  - A flush larger than the queue loses nothing: the sender starts on it
+ *    before the batch ends, and markers of an open batch are never dropped
+ *  - Without a running sender, markers are sent on the caller's thread
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "UtilsTelemetryQueue.h"
+
+using WPEFramework::Utils::TelemetryQueue;
+
+namespace {
+
+struct TestResult {
+    uint32_t failures { 0 };
+};
+
+static void ExpectTrue(TestResult& tr, const bool condition, const std::string& what)
+{
+    if (!condition) {
+        tr.failures++;
+        std::cerr << "FAIL: " << what << std::endl;
+    }
+}
+
+// Sender standing in for t2_event_s(): records markers, can be held up like a slow daemon
+struct RecordingSender {
+    std::mutex lock;
+    std::condition_variable changed;
+    std::vector<std::string> payloads;
+    std::vector<std::thread::id> threads;
+    bool blocked { false };
+    uint32_t calls { 0 };
+
+    TelemetryQueue::Sender Bind()
+    {
+        return [this](const std::string&, const std::string& payload) {
+            std::unique_lock<std::mutex> guard(lock);
+            ++calls;
+            changed.notify_all();
+            changed.wait(guard, [this] { return !blocked; });
+            payloads.push_back(payload);
+            threads.push_back(std::this_thread::get_id());
+            changed.notify_all();
+        };
+    }
+
+    void Block(const bool block)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        blocked = block;
+        changed.notify_all();
+    }
+
+    bool WaitFor(const size_t count)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        return changed.wait_for(guard, std::chrono::seconds(5), [this, count] { return payloads.size() >= count; });
+    }
+
+    bool WaitForCalls(const uint32_t count)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        return changed.wait_for(guard, std::chrono::seconds(5), [this, count] { return calls >= count; });
+    }
+};
+
+} // namespace
+
+uint32_t Test_TelemetryQueue_SlowSenderDropsOldest()
+{
+    TestResult tr;
+    RecordingSender sender;
+    TelemetryQueue queue(sender.Bind(), 4);
+    ExpectTrue(tr, queue.Start() && !queue.Start(), "sender started once");
+
+    // The first marker gets stuck in the daemon
+    sender.Block(true);
+    queue.Post("ENTS_INFO_Test", "stuck");
+    ExpectTrue(tr, sender.WaitForCalls(1), "sender picked up the first marker");
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t index = 0; index < 10; ++index) {
+        queue.Post("ENTS_INFO_Test", std::to_string(index));
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    ExpectTrue(tr, elapsed < std::chrono::seconds(1), "posting does not wait for the daemon");
+    ExpectTrue(tr, (queue.Pending() == 4) && (queue.Dropped() == 6), "full queue keeps its capacity and counts the rest");
+    ExpectTrue(tr, (queue.TakeDropped() == 6) && (queue.TakeDropped() == 0), "drops are reported once");
+
+    sender.Block(false);
+    ExpectTrue(tr, sender.WaitFor(5), "queued markers delivered once the daemon recovers");
+    {
+        std::lock_guard<std::mutex> guard(sender.lock);
+        const std::vector<std::string> expected = { "stuck", "6", "7", "8", "9" };
+        ExpectTrue(tr, sender.payloads == expected, "the oldest were dropped, the newest kept in order");
+        bool offThread = true;
+        for (const auto& id : sender.threads) {
+            offThread = offThread && (id != std::this_thread::get_id());
+        }
+        ExpectTrue(tr, offThread, "every marker sent from the sender thread");
+    }
+
+    queue.SetCapacity(2);
+    ExpectTrue(tr, queue.Capacity() == 2, "capacity changed");
+    ExpectTrue(tr, queue.Stop(1000) && (queue.Sent() == 5), "idle queue stops cleanly");
+
+    return tr.failures;
+}
+
+uint32_t Test_TelemetryQueue_BatchAndStop()
+{
+    TestResult tr;
+    RecordingSender sender;
+    TelemetryQueue queue(sender.Bind(), 64);
+
+    // Not started yet: sent right away on this thread
+    queue.Post("ENTS_INFO_Test", "inline");
+    {
+        std::lock_guard<std::mutex> guard(sender.lock);
+        ExpectTrue(tr, (sender.payloads.size() == 1) && (sender.threads[0] == std::this_thread::get_id()),
+                   "marker sent inline without a sender thread");
+    }
+
+    ExpectTrue(tr, queue.Start(), "sender started");
+    {
+        TelemetryQueue::Batch batch(queue);
+        for (uint32_t index = 0; index < 8; ++index) {
+            queue.Post("ENTS_INFO_Test", "batch" + std::to_string(index));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ExpectTrue(tr, queue.Pending() == 8, "sender sleeps while the flush is queued");
+    }
+    ExpectTrue(tr, sender.WaitFor(9) && (queue.Pending() == 0), "whole batch delivered once the flush is in");
+
+    // An open batch does not keep Stop() from delivering
+    {
+        TelemetryQueue::Batch batch(queue);
+        queue.Post("ENTS_INFO_Test", "last");
+        ExpectTrue(tr, queue.Stop(1000), "Stop() delivered the open batch");
+    }
+    {
+        std::lock_guard<std::mutex> guard(sender.lock);
+        ExpectTrue(tr, (sender.payloads.size() == 10) && (sender.payloads.back() == "last"), "final marker sent");
+    }
+
+    // A daemon that does not come back is cut off after the timeout
+    ExpectTrue(tr, queue.Start(), "sender restarted");
+    sender.Block(true);
+    queue.Post("ENTS_INFO_Test", "stuck");
+    ExpectTrue(tr, sender.WaitForCalls(11), "sender stuck on a marker");
+    queue.Post("ENTS_INFO_Test", "lost1");
+    queue.Post("ENTS_INFO_Test", "lost2");
+    std::thread release([&sender]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        sender.Block(false);
+    });
+    ExpectTrue(tr, !queue.Stop(50), "Stop() reports the timeout");
+    release.join();
+    ExpectTrue(tr, queue.Dropped() == 2, "markers left behind are counted as dropped");
+    {
+        std::lock_guard<std::mutex> guard(sender.lock);
+        ExpectTrue(tr, (sender.payloads.size() == 11) && (sender.payloads.back() == "stuck"),
+                   "the marker in flight finished, nothing after it was sent");
+    }
+
+    return tr.failures;
+}
+
+uint32_t Test_TelemetryQueue_LargeBatchKept()
+{
+    TestResult tr;
+    RecordingSender sender;
+    TelemetryQueue queue(sender.Bind(), 8);
+    ExpectTrue(tr, queue.Start(), "sender started");
+
+    // Healthy daemon: the sender starts before the flush is all in
+    {
+        TelemetryQueue::Batch batch(queue);
+        for (uint32_t index = 0; index < 4; ++index) {
+            queue.Post("ENTS_INFO_Test", "early" + std::to_string(index));
+        }
+        ExpectTrue(tr, sender.WaitFor(4), "half a queue wakes the sender inside the batch");
+    }
+
+    // Stuck daemon: the flush outgrows the queue without losing a marker
+    sender.Block(true);
+    {
+        TelemetryQueue::Batch batch(queue);
+        for (uint32_t index = 0; index < 40; ++index) {
+            queue.Post("ENTS_INFO_Test", std::to_string(index));
+        }
+        ExpectTrue(tr, queue.Dropped() == 0, "nothing dropped while the batch is open");
+    }
+    sender.Block(false);
+    ExpectTrue(tr, sender.WaitFor(44), "whole flush delivered");
+    ExpectTrue(tr, queue.Dropped() == 0, "nothing dropped once the batch is sent");
+    {
+        std::lock_guard<std::mutex> guard(sender.lock);
+        bool ordered = (sender.payloads.size() == 44);
+        for (uint32_t index = 0; ordered && (index < 40); ++index) {
+            ordered = (sender.payloads[4 + index] == std::to_string(index));
+        }
+        ExpectTrue(tr, ordered, "flush delivered in order");
+    }
+    ExpectTrue(tr, queue.Stop(1000), "idle queue stops cleanly");
+
+    return tr.failures;
+}
@@ -0,0 +1,325 @@
+/**
+ * L0 tests for helpers/UtilsWebSocketPayload.h
+ *
+ *  - Every unmask / ASCII-scan kernel available on this CPU against a
+ *    byte-at-a-time reference, for all lengths around the vector widths and
+ *    all key phases
+ *  - Utf8Validator accept/reject cases, fed whole and split at every byte
+ *  - WebSocketInboundFrames: masked frames are rewritten unmasked with the
+ *    payload decoded in place, across reads and fragments; invalid UTF-8 in a
+ *    text message fails the stream, binary messages are not validated
+ *  - WebSocketCloseFrame: status code and reason, reason cut to a control
+ *    frame without splitting a UTF-8 character
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "UtilsWebSocketPayload.h"
+
+using WPEFramework::Utils::Utf8Validator;
+using WPEFramework::Utils::WebSocketCloseFrame;
+using WPEFramework::Utils::WebSocketInboundFrames;
+using WPEFramework::Utils::WebSocketPayload;
+
+namespace {
+
+struct TestResult {
+    uint32_t failures { 0 };
+};
+
+static void ExpectTrue(TestResult& tr, const bool condition, const std::string& what)
+{
+    if (!condition) {
+        tr.failures++;
+        std::cerr << "FAIL: " << what << std::endl;
+    }
+}
+
+static const uint8_t kKey[4] = { 0x37, 0xFA, 0x21, 0x3D };
+
+static std::vector<uint8_t> Pattern(const size_t length)
+{
+    std::vector<uint8_t> data(length);
+    uint32_t seed = 0x12345678;
+    for (size_t index = 0; index < length; ++index) {
+        seed = seed * 1103515245 + 12345;
+        data[index] = static_cast<uint8_t>(seed >> 16);
+    }
+    return data;
+}
+
+// Client-to-server frame as a browser would send it
+static std::vector<uint8_t> MaskedFrame(const uint8_t opcode, const bool final, const std::string& payload)
+{
+    std::vector<uint8_t> frame;
+    frame.push_back(static_cast<uint8_t>((final ? 0x80 : 0x00) | opcode));
+    if (payload.size() < 126) {
+        frame.push_back(static_cast<uint8_t>(0x80 | payload.size()));
+    } else {
+        frame.push_back(0x80 | 126);
+        frame.push_back(static_cast<uint8_t>(payload.size() >> 8));
+        frame.push_back(static_cast<uint8_t>(payload.size() & 0xFF));
+    }
+    frame.insert(frame.end(), kKey, kKey + 4);
+    for (size_t index = 0; index < payload.size(); ++index) {
+        frame.push_back(static_cast<uint8_t>(payload[index]) ^ kKey[index & 0x03]);
+    }
+    return frame;
+}
+
+// Feeds stream through the tracker the way HandlerType::ReceiveData walks a read:
+// one call per frame start or continuation, then the decoder takes header + payload.
+// Like the socket, bytes of an incomplete header are presented again with the next
+// read. Returns the frames as the decoder sees them.
+static bool Follow(WebSocketInboundFrames& frames, std::vector<uint8_t> stream, const size_t readSize, std::vector<uint8_t>& decoded)
+{
+    size_t start = 0;
+    size_t end = 0;
+    uint64_t pending = 0;
+    while (end < stream.size()) {
+        end = std::min(stream.size(), end + readSize);
+        size_t offset = start;
+        while (offset < end) {
+            uint16_t skip = 0;
+            if (frames.Prepare(&stream[offset], end - offset, skip) == false) {
+                return false;
+            }
+            offset += skip;
+            size_t consumed = 0;
+            if (pending == 0) {
+                // Minimal decoder; a header left masked was incomplete
+                const size_t available = end - offset;
+                if ((available < 2) || ((stream[offset + 1] & 0x80) != 0)
+                    || (((stream[offset + 1] & 0x7F) == 126) && (available < 4))) {
+                    break;
+                }
+                pending = stream[offset + 1] & 0x7F;
+                consumed = 2;
+                if (pending == 126) {
+                    pending = (static_cast<uint64_t>(stream[offset + 2]) << 8) | stream[offset + 3];
+                    consumed = 4;
+                }
+                decoded.insert(decoded.end(), stream.begin() + offset, stream.begin() + offset + consumed);
+            }
+            const size_t chunk = std::min<size_t>(pending, end - offset - consumed);
+            decoded.insert(decoded.end(), stream.begin() + offset + consumed, stream.begin() + offset + consumed + chunk);
+            pending -= chunk;
+            offset += consumed + chunk;
+        }
+        start = offset;
+    }
+    return true;
+}
+
+static std::vector<uint8_t> PlainFrame(const uint8_t opcode, const bool final, const std::string& payload)
+{
+    std::vector<uint8_t> frame;
+    frame.push_back(static_cast<uint8_t>((final ? 0x80 : 0x00) | opcode));
+    if (payload.size() < 126) {
+        frame.push_back(static_cast<uint8_t>(payload.size()));
+    } else {
+        frame.push_back(126);
+        frame.push_back(static_cast<uint8_t>(payload.size() >> 8));
+        frame.push_back(static_cast<uint8_t>(payload.size() & 0xFF));
+    }
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    return frame;
+}
+
+} // namespace
+
+// Every kernel set matches the byte-at-a-time definition.
+uint32_t Test_WebSocketPayload_KernelsMatchReference()
+{
+    TestResult tr;
+
+    const WebSocketPayload::Kernels* kernels[3];
+    const uint8_t count = WebSocketPayload::Available(kernels, 3);
+    ExpectTrue(tr, count >= 1, "scalar kernels always available");
+
+    for (uint8_t k = 0; k < count; ++k) {
+        const std::string name = kernels[k]->name;
+        bool unmaskOk = true;
+        bool asciiOk = true;
+        for (size_t length = 0; length <= 100; ++length) {
+            const std::vector<uint8_t> source = Pattern(length);
+            for (uint8_t phase = 0; phase < 4; ++phase) {
+                std::vector<uint8_t> data(source);
+                kernels[k]->unmask(data.data(), data.size(), kKey, phase);
+                for (size_t index = 0; index < length; ++index) {
+                    unmaskOk = unmaskOk && (data[index] == (source[index] ^ kKey[(phase + index) & 0x03]));
+                }
+            }
+
+            std::vector<uint8_t> text(length, 'a');
+            asciiOk = asciiOk && (kernels[k]->ascii(text.data(), length) == length);
+            for (size_t high = 0; high < length; ++high) {
+                text[high] = 0xC3;
+                asciiOk = asciiOk && (kernels[k]->ascii(text.data(), length) == high);
+                text[high] = 'a';
+            }
+        }
+        ExpectTrue(tr, unmaskOk, name + " unmask matches reference");
+        ExpectTrue(tr, asciiOk, name + " ASCII scan matches reference");
+    }
+
+    ExpectTrue(tr, WebSocketPayload::Select("scalar"), "scalar selectable");
+    ExpectTrue(tr, std::string(WebSocketPayload::Active().name) == "scalar", "selection takes effect");
+    ExpectTrue(tr, !WebSocketPayload::Select("no-such-isa"), "unknown kernel set refused");
+    ExpectTrue(tr, WebSocketPayload::Select(kernels[count - 1]->name), "best kernel set restored");
+
+    return tr.failures;
+}
+
+// Accepts well-formed UTF-8 and rejects malformed input, also when split anywhere.
+uint32_t Test_WebSocketPayload_Utf8Validator()
+{
+    TestResult tr;
+
+    const std::vector<std::string> valid = {
+        "",
+        "{\"jsonrpc\":\"2.0\",\"method\":\"metrics.ready\",\"id\":1}",
+        "caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80 \xED\x9F\xBF \xF4\x8F\xBF\xBF",
+        std::string(70, 'x') + "\xE4\xB8\xAD" + std::string(40, 'y'),
+    };
+    const std::vector<std::string> invalid = {
+        "\x80",                  // lone continuation
+        "\xC0\xAF",              // overlong '/'
+        "\xE0\x80\xAF",          // overlong 3-byte
+        "\xED\xA0\x80",          // surrogate
+        "\xF4\x90\x80\x80",      // above U+10FFFF
+        "\xF5\x80\x80\x80",      // invalid lead
+        "abc\xE2\x82",           // truncated
+        std::string(40, 'x') + "\xFF",
+    };
+
+    for (const std::string& text : valid) {
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(text.data());
+        ExpectTrue(tr, Utf8Validator::IsValid(data, text.size()), "valid: " + text);
+        for (size_t split = 0; split <= text.size(); ++split) {
+            Utf8Validator validator;
+            const bool ok = validator.Update(data, split) && validator.Update(data + split, text.size() - split) && validator.Complete();
+            ExpectTrue(tr, ok, "valid when split at " + std::to_string(split));
+        }
+    }
+    for (const std::string& text : invalid) {
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(text.data());
+        ExpectTrue(tr, !Utf8Validator::IsValid(data, text.size()), "invalid sequence rejected");
+        for (size_t split = 0; split <= text.size(); ++split) {
+            Utf8Validator validator;
+            const bool ok = validator.Update(data, split) && validator.Update(data + split, text.size() - split) && validator.Complete();
+            ExpectTrue(tr, !ok, "invalid when split at " + std::to_string(split));
+        }
+    }
+
+    return tr.failures;
+}
+
+// Masked frames reach the decoder unmasked, whatever the read boundaries are.
+uint32_t Test_WebSocketPayload_InboundFramesUnmask()
+{
+    TestResult tr;
+
+    const std::string request = "{\"jsonrpc\":\"2.0\",\"method\":\"metrics.report\",\"params\":{\"v\":\"\xE2\x82\xAC\"},\"id\":7}";
+    const std::string large(300, 'p');
+    const std::string head = "{\"x\":\"\xF0\x9F";
+    const std::string tail = "\x98\x80\"}";
+
+    std::vector<uint8_t> stream;
+    std::vector<uint8_t> expected;
+    auto add = [&](const uint8_t opcode, const bool final, const std::string& payload) {
+        const std::vector<uint8_t> masked = MaskedFrame(opcode, final, payload);
+        const std::vector<uint8_t> plain = PlainFrame(opcode, final, payload);
+        stream.insert(stream.end(), masked.begin(), masked.end());
+        expected.insert(expected.end(), plain.begin(), plain.end());
+    };
+    add(0x01, true, request);
+    add(0x09, true, "ping");
+    add(0x01, true, large);
+    add(0x01, false, head);     // a character split across fragments
+    add(0x00, true, tail);
+    add(0x02, true, "\xFF\xFE");   // binary is not UTF-8 checked
+
+    for (const size_t readSize : { static_cast<size_t>(4096), static_cast<size_t>(64), static_cast<size_t>(7), static_cast<size_t>(1) }) {
+        WebSocketInboundFrames frames;
+        std::vector<uint8_t> decoded;
+        const bool ok = Follow(frames, stream, readSize, decoded);
+        ExpectTrue(tr, ok, "stream accepted with reads of " + std::to_string(readSize));
+        ExpectTrue(tr, decoded == expected, "decoder sees unmasked frames with reads of " + std::to_string(readSize));
+        ExpectTrue(tr, !frames.Failed(), "no failure latched");
+    }
+
+    return tr.failures;
+}
+
+// Invalid UTF-8 in a text message fails the stream and stays failed.
+uint32_t Test_WebSocketPayload_InboundFramesRejectInvalidText()
+{
+    TestResult tr;
+
+    {
+        WebSocketInboundFrames frames;
+        std::vector<uint8_t> decoded;
+        ExpectTrue(tr, !Follow(frames, MaskedFrame(0x01, true, "{\"a\":\"\xC0\xAF\"}"), 4096, decoded), "overlong in text rejected");
+        ExpectTrue(tr, frames.Failed(), "failure latched");
+        uint8_t more[] = { 0x81, 0x00 };
+        uint16_t skip = 0;
+        ExpectTrue(tr, !frames.Prepare(more, sizeof(more), skip), "later input refused");
+        frames.Reset();
+        ExpectTrue(tr, frames.Prepare(more, sizeof(more), skip), "Reset clears the failure");
+    }
+    {
+        // Message ends in the middle of a character
+        std::vector<uint8_t> stream = MaskedFrame(0x01, false, "ok \xE2\x82");
+        const std::vector<uint8_t> last = MaskedFrame(0x00, true, "");
+        stream.insert(stream.end(), last.begin(), last.end());
+        WebSocketInboundFrames frames;
+        std::vector<uint8_t> decoded;
+        ExpectTrue(tr, !Follow(frames, stream, 4096, decoded), "truncated character at end of message rejected");
+    }
+    {
+        // A control frame between fragments does not end the text message
+        std::vector<uint8_t> stream = MaskedFrame(0x01, false, "\xE2\x82");
+        const std::vector<uint8_t> ping = MaskedFrame(0x09, true, "");
+        const std::vector<uint8_t> last = MaskedFrame(0x00, true, "\xAC");
+        stream.insert(stream.end(), ping.begin(), ping.end());
+        stream.insert(stream.end(), last.begin(), last.end());
+        WebSocketInboundFrames frames;
+        std::vector<uint8_t> decoded;
+        ExpectTrue(tr, Follow(frames, stream, 4096, decoded), "interleaved ping keeps the message intact");
+    }
+
+    return tr.failures;
+}
+
+uint32_t Test_WebSocketPayload_CloseFrame()
+{
+    TestResult tr;
+
+    {
+        const std::string frame = WebSocketCloseFrame::Build(WebSocketCloseFrame::ServiceRestart, "retry-after=2");
+        const std::string expected = std::string("\x88\x0F\x03\xF4", 4) + "retry-after=2";
+        ExpectTrue(tr, frame == expected, "1012 with reason");
+    }
+    {
+        const std::string frame = WebSocketCloseFrame::Build(1000, "");
+        ExpectTrue(tr, frame == std::string("\x88\x02\x03\xE8", 4), "code only");
+    }
+    {
+        // 122 ASCII bytes then a 3 byte character across the 123 byte limit
+        const std::string reason = std::string(122, 'r') + "\xE2\x82\xAC" + "tail";
+        const std::string frame = WebSocketCloseFrame::Build(1012, reason);
+        ExpectTrue(tr, frame.size() == 4 + 122, "reason cut before the split character");
+        ExpectTrue(tr, static_cast<uint8_t>(frame[1]) == 2 + 122, "length covers code and cut reason");
+        ExpectTrue(tr, Utf8Validator::IsValid(reinterpret_cast<const uint8_t*>(frame.data()) + 4, frame.size() - 4), "cut reason is valid UTF-8");
+    }
+    {
+        const std::string frame = WebSocketCloseFrame::Build(1012, std::string(300, 'x'));
+        ExpectTrue(tr, (frame.size() == 4 + WebSocketCloseFrame::MaxReason) && (static_cast<uint8_t>(frame[1]) == 125), "long reason fits a control frame");
+    }
+
+    return tr.failures;
+}
@@ -0,0 +1,243 @@
+/**
+ * L0 tests for the preformatted (streamed) outbound path of WsManager.h
+ *
+ *  - Envelopes built for large responses, notifications and requests are the
+ *    same text Core::JSONRPC::Message serializes for those fields
+ *  - PreformattedMessage hands the text out in send buffer sized pieces across
+ *    envelope/payload boundaries
+ *  - Constant results and the fixed Firebolt errors go out from prerendered
+ *    envelope tails with the same text
+ *  - A queued message whose last piece fills the link's buffer exactly ends
+ *    with an empty fill, so the next message starts a frame of its own
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <core/core.h>
+
+#include "WsManager.h"
+
+using WPEFramework::Core::PreformattedMessage;
+using WPEFramework::Core::StreamJSONOneShotType;
+
+namespace {
+
+struct TestResult {
+    uint32_t failures { 0 };
+};
+
+static void ExpectTrue(TestResult& tr, const bool condition, const std::string& what)
+{
+    if (!condition) {
+        tr.failures++;
+        std::cerr << "FAIL: " << what << std::endl;
+    }
+}
+
+static std::string LargePayload()
+{
+    std::string payload = "{\"items\":[";
+    for (int index = 0; payload.size() < 3 * WEBSOCKET_SEND_BUFFER_SIZE; ++index) {
+        payload += (index == 0 ? "" : ",");
+        payload += "{\"id\":" + std::to_string(index) + ",\"name\":\"entry \\\"" + std::to_string(index) + "\\\"\"}";
+    }
+    payload += "]}";
+    return payload;
+}
+
+// Stands in for the WebSocket link: the stream's handler overrides SendData(),
+// which the link calls with the room left in its send buffer
+class FillLink {
+public:
+    FillLink() = default;
+    virtual ~FillLink() = default;
+
+    virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
+    virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+    virtual void StateChange() = 0;
+    virtual bool IsIdle() const = 0;
+
+    bool IsOpen() const { return true; }
+    void Trigger() {}
+    uint32_t Close(const uint32_t) { return WPEFramework::Core::ERROR_NONE; }
+};
+
+struct MessageFactory {
+    explicit MessageFactory(const uint8_t) {}
+    WPEFramework::Core::ProxyType<WPEFramework::Core::JSON::IElement> Element(const std::string&)
+    {
+        return WPEFramework::Core::ProxyType<WPEFramework::Core::JSON::IElement>(
+            WPEFramework::Core::ProxyType<WPEFramework::Core::JSONRPC::Message>::Create());
+    }
+};
+
+class FillStream : public StreamJSONOneShotType<FillLink, MessageFactory, WPEFramework::Core::JSON::IElement> {
+public:
+    typedef StreamJSONOneShotType<FillLink, MessageFactory, WPEFramework::Core::JSON::IElement> BaseClass;
+
+    FillStream()
+        : BaseClass(1)
+    {
+    }
+
+    void Received(WPEFramework::Core::ProxyType<WPEFramework::Core::JSON::IElement>&) override {}
+    void Send(WPEFramework::Core::ProxyType<WPEFramework::Core::JSON::IElement>&) override {}
+    void StateChange() override {}
+};
+
+} // namespace
+
+// Streamed envelopes are byte-identical to the serialized JSON-RPC message.
+uint32_t Test_WsManager_Envelopes_MatchMessageSerialization()
+{
+    TestResult tr;
+    const std::string payload = LargePayload();
+
+    {
+        WPEFramework::Core::JSONRPC::Message message;
+        message.JSONRPC = WPEFramework::Core::JSONRPC::Message::DefaultVersion;
+        message.Id = 42;
+        message.Result = payload;
+        std::string expected;
+        message.ToString(expected);
+        ExpectTrue(tr, WebSocketConnectionManager::ResponseEnvelope(42, payload)->ToString() == expected, "response envelope");
+    }
+    {
+        WPEFramework::Core::JSONRPC::Message message;
+        message.JSONRPC = WPEFramework::Core::JSONRPC::Message::DefaultVersion;
+        message.Designator = "Lifecycle.on\"Quoted\"Event";
+        message.Parameters = payload;
+        std::string expected;
+        message.ToString(expected);
+        ExpectTrue(tr, WebSocketConnectionManager::NotificationEnvelope("Lifecycle.on\"Quoted\"Event", payload)->ToString() == expected,
+                   "notification envelope, designator escaped");
+    }
+    {
+        WPEFramework::Core::JSONRPC::Message message;
+        message.JSONRPC = WPEFramework::Core::JSONRPC::Message::DefaultVersion;
+        message.Id = 7;
+        message.Designator = "Discovery.onPullEntityInfo";
+        message.Parameters = payload;
+        std::string expected;
+        message.ToString(expected);
+        ExpectTrue(tr, WebSocketConnectionManager::RequestEnvelope("Discovery.onPullEntityInfo", 7, payload)->ToString() == expected,
+                   "request envelope");
+    }
+
+    return tr.failures;
+}
+
+// Pieces of any size reassemble to the whole message.
+uint32_t Test_WsManager_PreformattedMessage_CopiesInPieces()
+{
+    TestResult tr;
+    const auto message = std::make_shared<const PreformattedMessage>(
+        std::string("{\"a\":"), std::make_shared<const std::string>(LargePayload()), std::string("}"));
+    const std::string whole = message->ToString();
+    ExpectTrue(tr, message->Length() == whole.size(), "length covers envelope and payload");
+
+    for (const uint16_t piece : { static_cast<uint16_t>(1), static_cast<uint16_t>(3), static_cast<uint16_t>(5),
+                                  static_cast<uint16_t>(WEBSOCKET_SEND_BUFFER_SIZE - 4) }) {
+        std::string streamed;
+        std::vector<uint8_t> buffer(piece);
+        uint32_t offset = 0;
+        uint32_t calls = 0;
+        while (offset < message->Length()) {
+            const uint16_t loaded = message->Copy(buffer.data(), piece, offset);
+            if (loaded == 0) {
+                break;
+            }
+            streamed.append(reinterpret_cast<const char*>(buffer.data()), loaded);
+            offset += loaded;
+            ++calls;
+        }
+        ExpectTrue(tr, streamed == whole, "pieces of " + std::to_string(piece) + " reassemble the message");
+        ExpectTrue(tr, calls == (whole.size() + piece - 1) / piece, "every piece but the last fills the buffer");
+    }
+
+    uint8_t tail[16];
+    ExpectTrue(tr, message->Copy(tail, sizeof(tail), message->Length()) == 0, "nothing left past the end");
+
+    return tr.failures;
+}
+
+// A message that ends exactly on a full buffer is closed by an empty fill.
+uint32_t Test_WsManager_PreformattedMessage_ExactFillEndsMessage()
+{
+    TestResult tr;
+    const uint16_t fill = 64;
+    // {"a":"xx..x"} and {"b":"yy..y"}, three and two fills long
+    const auto first = std::make_shared<const PreformattedMessage>(
+        std::string("{\"a\":"), std::make_shared<const std::string>("\"" + std::string(3 * fill - 8, 'x') + "\""), std::string("}"));
+    const auto second = std::make_shared<const PreformattedMessage>(
+        std::string("{\"b\":"), std::make_shared<const std::string>("\"" + std::string(2 * fill - 8, 'y') + "\""), std::string("}"));
+    ExpectTrue(tr, (first->Length() == 3u * fill) && (second->Length() == 2u * fill), "messages are whole fills long");
+
+    FillStream stream;
+    stream.Submit(first);
+    stream.Submit(second);
+
+    std::vector<uint16_t> fills;
+    std::vector<std::string> messages(1);
+    uint8_t buffer[fill];
+    for (uint32_t call = 0; call < 8; ++call) {
+        const uint16_t loaded = stream.Link().SendData(buffer, fill);
+        fills.push_back(loaded);
+        messages.back().append(reinterpret_cast<const char*>(buffer), loaded);
+        if (loaded != fill) {
+            // What the link sends as the last piece of a message
+            messages.emplace_back();
+        }
+    }
+
+    const std::vector<uint16_t> expected = { fill, fill, fill, 0, fill, fill, 0, 0 };
+    ExpectTrue(tr, fills == expected, "each message ends with an empty fill, nothing is left after them");
+    ExpectTrue(tr, (messages.size() > 2) && (messages[0] == first->ToString()) && (messages[1] == second->ToString()),
+               "messages do not run into each other");
+
+    return tr.failures;
+}
+
+// Constant outcomes skip the message build but go out as the same text.
+uint32_t Test_WsManager_ConstantEnvelopes_MatchMessageSerialization()
+{
+    TestResult tr;
+
+    for (const char* body : { "null", "true", "false" }) {
+        WPEFramework::Core::JSONRPC::Message message;
+        message.JSONRPC = WPEFramework::Core::JSONRPC::Message::DefaultVersion;
+        message.Id = 1001;
+        message.Result = body;
+        std::string expected;
+        message.ToString(expected);
+        const auto envelope = WebSocketConnectionManager::ConstantEnvelope(1001, body);
+        ExpectTrue(tr, (envelope != nullptr) && (envelope->ToString() == expected), std::string("constant result ") + body);
+    }
+
+    for (const FireboltError error : { FireboltError::NOT_SUPPORTED, FireboltError::NOT_AVAILABLE, FireboltError::NOT_PERMITTED }) {
+        const std::string body = ErrorUtils::GetFireboltError(error);
+        WPEFramework::Core::JSONRPC::Message::Info info;
+        ExpectTrue(tr, info.FromString(body) && info.Code.IsSet() && info.Text.IsSet(), "Firebolt error parses as an error: " + body);
+
+        WPEFramework::Core::JSONRPC::Message message;
+        message.JSONRPC = WPEFramework::Core::JSONRPC::Message::DefaultVersion;
+        message.Id = 77;
+        message.Error = info;
+        std::string expected;
+        message.ToString(expected);
+        const auto envelope = WebSocketConnectionManager::ConstantEnvelope(77, body);
+        ExpectTrue(tr, (envelope != nullptr) && (envelope->ToString() == expected), "constant error " + body);
+    }
+
+    std::string resolution;
+    ErrorUtils::NotPermitted(resolution);
+    ExpectTrue(tr, resolution == ErrorUtils::GetFireboltError(FireboltError::NOT_PERMITTED), "cached error text is stable");
+
+    for (const char* body : { "nul", "\"null\"", "{}", "true ", "" }) {
+        ExpectTrue(tr, WebSocketConnectionManager::ConstantEnvelope(1, body) == nullptr, std::string("not a constant: '") + body + "'");
+    }
+
+    return tr.failures;
+}
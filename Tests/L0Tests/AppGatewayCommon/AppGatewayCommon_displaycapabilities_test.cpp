@@ -0,0 +1,62 @@
+#include "AppGatewayCommon_common_test.h"
+
+#include "UtilsDisplayCapabilities.h"
+
+using WPEFramework::Utils::DisplayCapabilities;
+
+// TEST_ID: AGC_L0_102
+// Nothing is kept until hotplug is tracked; stored fields are then served until
+// the next hotplug drops the whole record.
+uint32_t Test_DisplayCapabilities_TrackAndInvalidate()
+{
+    TestResult tr;
+    DisplayCapabilities display;
+    std::string value;
+
+    ExpectTrue(tr, !display.Store(DisplayCapabilities::HDCP, "{}", display.Generation()), "untracked record refuses values");
+    ExpectTrue(tr, !display.Get(DisplayCapabilities::HDCP, value), "untracked record serves nothing");
+
+    display.Track(true);
+    ExpectTrue(tr, !display.Get(DisplayCapabilities::EDID, value), "empty record misses");
+    ExpectTrue(tr, display.Store(DisplayCapabilities::EDID, "\"AP8=\"", display.Generation()), "EDID stored");
+    ExpectTrue(tr, display.Store(DisplayCapabilities::SIZE, "{\"width\":121,\"height\":68}", display.Generation()), "size stored");
+    ExpectTrue(tr, display.Get(DisplayCapabilities::EDID, value) && value == "\"AP8=\"", "EDID served from the record");
+    ExpectTrue(tr, display.Get(DisplayCapabilities::SIZE, value) && value == "{\"width\":121,\"height\":68}", "size served from the record");
+    ExpectTrue(tr, !display.Get(DisplayCapabilities::HDR, value), "unfilled field still misses");
+
+    display.Invalidate();
+    ExpectTrue(tr, !display.Get(DisplayCapabilities::EDID, value), "hotplug drops EDID");
+    ExpectTrue(tr, !display.Get(DisplayCapabilities::SIZE, value), "hotplug drops size");
+
+    display.Store(DisplayCapabilities::HDR, "{\"hdr10\":true}", display.Generation());
+    display.Track(false);
+    ExpectTrue(tr, !display.Get(DisplayCapabilities::HDR, value), "losing hotplug events drops the record");
+    display.Track(true);
+    ExpectTrue(tr, !display.Get(DisplayCapabilities::HDR, value), "re-tracking starts empty");
+
+    return tr.failures;
+}
+
+// TEST_ID: AGC_L0_103
+// A value fetched while a hotplug was delivered describes the old display and
+// must not be stored.
+uint32_t Test_DisplayCapabilities_RefusesStaleFetch()
+{
+    TestResult tr;
+    DisplayCapabilities display;
+    std::string value;
+    display.Track(true);
+
+    const uint32_t generation = display.Generation();
+    display.Invalidate();
+    ExpectTrue(tr, !display.Store(DisplayCapabilities::MAX_RESOLUTION, "{\"width\":1920,\"height\":1080}", generation),
+               "fetch across a hotplug is refused");
+    ExpectTrue(tr, !display.Get(DisplayCapabilities::MAX_RESOLUTION, value), "refused value is not served");
+
+    ExpectTrue(tr, display.Store(DisplayCapabilities::MAX_RESOLUTION, "{\"width\":3840,\"height\":2160}", display.Generation()),
+               "fresh fetch stored");
+    ExpectTrue(tr, display.Get(DisplayCapabilities::MAX_RESOLUTION, value) && value == "{\"width\":3840,\"height\":2160}",
+               "fresh value served");
+
+    return tr.failures;
+}
@@ -0,0 +1,54 @@
+#include "AppGatewayCommon_common_test.h"
+
+#include "UtilsExtrapolatedCounter.h"
+
+using WPEFramework::Utils::ExtrapolatedCounter;
+
+// TEST_ID: AGC_L0_100
+// A sampled counter is answered locally until invalidated; a sample taken
+// across an invalidation is refused and drift is reported on re-anchor.
+uint32_t Test_ExtrapolatedCounter_AnchorReadInvalidate()
+{
+    TestResult tr;
+    ExtrapolatedCounter counter(CLOCK_MONOTONIC, 600);
+
+    uint64_t seconds = 0;
+    ExpectTrue(tr, !counter.Read(seconds), "no value before the first sample");
+
+    int64_t drift = 0;
+    uint32_t generation = counter.Generation();
+    ExpectTrue(tr, counter.Anchor(1000, generation, drift), "first sample anchors");
+    ExpectTrue(tr, drift == 0, "no drift without a previous anchor");
+    ExpectTrue(tr, counter.Read(seconds), "anchored counter is answered locally");
+    ExpectTrue(tr, seconds >= 1000 && seconds <= 1001, "extrapolated value starts at the sample");
+
+    ExpectTrue(tr, counter.Anchor(1100, counter.Generation(), drift), "re-anchor accepted");
+    ExpectTrue(tr, drift >= 99 && drift <= 100, "drift against the extrapolation reported");
+
+    generation = counter.Generation();
+    counter.Invalidate();
+    ExpectTrue(tr, !counter.Read(seconds), "invalidated counter is sampled again");
+    ExpectTrue(tr, !counter.Anchor(5, generation, drift), "sample taken across an invalidation is refused");
+    ExpectTrue(tr, !counter.Read(seconds), "refused sample does not anchor");
+
+    ExpectTrue(tr, counter.Anchor(5, counter.Generation(), drift), "fresh sample anchors");
+    ExpectTrue(tr, counter.Read(seconds) && seconds == 5, "counter restarts from the new sample");
+
+    return tr.failures;
+}
+
+// TEST_ID: AGC_L0_101
+// Once the resync period has passed the counter stops answering so the owner
+// is asked again.
+uint32_t Test_ExtrapolatedCounter_ResyncPeriod()
+{
+    TestResult tr;
+    ExtrapolatedCounter counter(CLOCK_BOOTTIME, 0);
+
+    int64_t drift = 0;
+    uint64_t seconds = 0;
+    ExpectTrue(tr, counter.Anchor(42, counter.Generation(), drift), "sample anchors");
+    ExpectTrue(tr, !counter.Read(seconds), "expired anchor is not extrapolated");
+
+    return tr.failures;
+}
@@ -0,0 +1,188 @@
+#include "AppGatewayCommon_common_test.h"
+
+#include "UtilsInterfaceCache.h"
+
+namespace {
+
+    struct IFakeService : virtual public WPEFramework::Core::IUnknown {
+        enum { ID = 0x0F0F0001 };
+        virtual uint32_t Ping() = 0;
+    };
+
+    // Counts references so tests can see what the cache holds and releases
+    class FakeService : public IFakeService {
+    public:
+        FakeService() : refs(0) {}
+
+        void AddRef() const override { refs.fetch_add(1); }
+        uint32_t Release() const override
+        {
+            refs.fetch_sub(1);
+            return ERROR_NONE;
+        }
+        void* QueryInterface(const uint32_t id) override
+        {
+            if (id == IFakeService::ID) {
+                AddRef();
+                return static_cast<IFakeService*>(this);
+            }
+            return nullptr;
+        }
+        uint32_t Ping() override { return 42; }
+
+        mutable std::atomic<int32_t> refs;
+    };
+
+    struct FakeShell {
+        FakeService service;
+        std::atomic<uint32_t> queries { 0 };
+        bool available { true };
+        L0Test::ServiceMock* shell { nullptr };
+
+        FakeShell()
+        {
+            L0Test::ServiceMock::Config cfg;
+            cfg.queryInterface = [this](const uint32_t id, const std::string& name) -> void* {
+                queries++;
+                if (!available || name != "org.rdk.Fake") {
+                    return nullptr;
+                }
+                return service.QueryInterface(id);
+            };
+            shell = new L0Test::ServiceMock(cfg, /*selfDelete=*/true);
+        }
+
+        ~FakeShell() { shell->Release(); }
+    };
+
+} // namespace
+
+// TEST_ID: AGC_L0_098
+// Repeated Acquire is served from the cache; the caller's reference is its own
+// and the cache keeps exactly one.
+uint32_t Test_InterfaceCache_ReusesHandle()
+{
+    TestResult tr;
+    FakeShell fake;
+    WPEFramework::Utils::InterfaceCache cache;
+    cache.Open(fake.shell);
+    ExpectTrue(tr, fake.shell->PluginSink() != nullptr, "Open registers for plugin state changes");
+
+    for (int i = 0; i < 3; ++i) {
+        IFakeService* service = cache.Acquire<IFakeService>("org.rdk.Fake");
+        ExpectTrue(tr, service != nullptr, "Acquire returns the interface");
+        if (service != nullptr) {
+            ExpectEqU32(tr, service->Ping(), 42, "interface is usable");
+            service->Release();
+        }
+    }
+    ExpectEqU32(tr, fake.queries.load(), 1, "shell queried once for three Acquires");
+    ExpectEqU32(tr, static_cast<uint32_t>(fake.service.refs.load()), 1, "cache holds one reference");
+
+    // Misses are not cached: a plugin activated later is found on the next call
+    fake.available = false;
+    ExpectTrue(tr, cache.Acquire<IFakeService>("org.rdk.Other") == nullptr, "unknown callsign yields nullptr");
+    ExpectTrue(tr, cache.Acquire<IFakeService>("org.rdk.Other") == nullptr, "unknown callsign yields nullptr again");
+    ExpectEqU32(tr, fake.queries.load(), 3, "misses query the shell every time");
+
+    cache.Close();
+    ExpectTrue(tr, fake.shell->PluginSink() == nullptr, "Close unregisters");
+    ExpectEqU32(tr, static_cast<uint32_t>(fake.service.refs.load()), 0, "Close releases cached interfaces");
+    ExpectTrue(tr, cache.Acquire<IFakeService>("org.rdk.Fake") == nullptr, "closed cache hands out nothing");
+
+    return tr.failures;
+}
+
+// TEST_ID: AGC_L0_099
+// Deactivation or unavailability of the owning plugin drops its handles only.
+uint32_t Test_InterfaceCache_InvalidatedOnPluginStateChange()
+{
+    TestResult tr;
+    FakeShell fake;
+    WPEFramework::Utils::InterfaceCache cache;
+    cache.Open(fake.shell);
+
+    IFakeService* service = cache.Acquire<IFakeService>("org.rdk.Fake");
+    if (service != nullptr) {
+        service->Release();
+    }
+    ExpectEqU32(tr, static_cast<uint32_t>(cache.Size()), 1, "handle cached");
+
+    WPEFramework::PluginHost::IPlugin::INotification* sink = fake.shell->PluginSink();
+    ExpectTrue(tr, sink != nullptr, "sink registered");
+    if (sink == nullptr) {
+        return tr.failures;
+    }
+
+    sink->Deactivated("org.rdk.Unrelated", nullptr);
+    ExpectEqU32(tr, static_cast<uint32_t>(cache.Size()), 1, "other plugin's deactivation keeps the handle");
+
+    sink->Deactivated("org.rdk.Fake", nullptr);
+    ExpectEqU32(tr, static_cast<uint32_t>(cache.Size()), 0, "deactivation drops the handle");
+    ExpectEqU32(tr, static_cast<uint32_t>(fake.service.refs.load()), 0, "dropped handle is released");
+
+    service = cache.Acquire<IFakeService>("org.rdk.Fake");
+    if (service != nullptr) {
+        service->Release();
+    }
+    ExpectEqU32(tr, fake.queries.load(), 2, "next Acquire queries the shell again");
+
+    sink->Unavailable("org.rdk.Fake", nullptr);
+    ExpectEqU32(tr, static_cast<uint32_t>(cache.Size()), 0, "unavailability (crash) drops the handle");
+
+    cache.Close();
+    return tr.failures;
+}
+
+namespace {
+
+    struct RecordingObserver : public WPEFramework::Utils::InterfaceCache::IObserver {
+        void Revoked(const std::string& callsign) override { revoked.push_back(callsign); }
+        std::vector<std::string> revoked;
+    };
+
+} // namespace
+
+// TEST_ID: AGC_L0_104
+// Watchers hear about every plugin that goes away, after its handles were
+// dropped, and nothing once they stop watching.
+uint32_t Test_InterfaceCache_ObserversToldOfRevokedPlugins()
+{
+    TestResult tr;
+    FakeShell fake;
+    WPEFramework::Utils::InterfaceCache cache;
+    cache.Open(fake.shell);
+
+    RecordingObserver observer;
+    cache.Watch(&observer);
+    cache.Watch(&observer);
+
+    IFakeService* service = cache.Acquire<IFakeService>("org.rdk.Fake");
+    if (service != nullptr) {
+        service->Release();
+    }
+
+    WPEFramework::PluginHost::IPlugin::INotification* sink = fake.shell->PluginSink();
+    ExpectTrue(tr, sink != nullptr, "sink registered");
+    if (sink == nullptr) {
+        return tr.failures;
+    }
+
+    sink->Activated("org.rdk.Fake", nullptr);
+    ExpectEqU32(tr, static_cast<uint32_t>(observer.revoked.size()), 0, "activation is not a revocation");
+
+    sink->Deactivated("org.rdk.Fake", nullptr);
+    ExpectEqU32(tr, static_cast<uint32_t>(observer.revoked.size()), 1, "watching twice still reports once");
+    ExpectTrue(tr, !observer.revoked.empty() && observer.revoked[0] == "org.rdk.Fake", "deactivated callsign reported");
+    ExpectEqU32(tr, static_cast<uint32_t>(fake.service.refs.load()), 0, "handle dropped before the observer is told");
+
+    sink->Unavailable("org.rdk.Other", nullptr);
+    ExpectEqU32(tr, static_cast<uint32_t>(observer.revoked.size()), 2, "unavailable plugin reported too");
+
+    cache.Unwatch(&observer);
+    sink->Deactivated("org.rdk.Fake", nullptr);
+    ExpectEqU32(tr, static_cast<uint32_t>(observer.revoked.size()), 2, "no reports after Unwatch");
+
+    cache.Close();
+    return tr.failures;
+}
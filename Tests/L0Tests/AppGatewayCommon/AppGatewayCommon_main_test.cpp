@@ -116,6 +116,19 @@ extern uint32_t Test_HandleAppEventNotifier_TTSEvent_ListenTrue();
 extern uint32_t Test_HandleAppEventNotifier_SystemDeviceEvent();
 extern uint32_t Test_HandleAppEventNotifier_NetworkEvent_UnsubscribeOnly();
 
+// AppGatewayCommon_interfacecache_test.cpp
+extern uint32_t Test_InterfaceCache_ReusesHandle();
+extern uint32_t Test_InterfaceCache_InvalidatedOnPluginStateChange();
+extern uint32_t Test_InterfaceCache_ObserversToldOfRevokedPlugins();
+
+// AppGatewayCommon_extrapolatedcounter_test.cpp
+extern uint32_t Test_ExtrapolatedCounter_AnchorReadInvalidate();
+extern uint32_t Test_ExtrapolatedCounter_ResyncPeriod();
+
+// AppGatewayCommon_displaycapabilities_test.cpp
+extern uint32_t Test_DisplayCapabilities_TrackAndInvalidate();
+extern uint32_t Test_DisplayCapabilities_RefusesStaleFetch();
+
 int main()
 {
     // Test-only bootstrap for WorkerPool.
@@ -229,6 +242,16 @@ int main()
         { "EventNotifier_TTSEvent_ListenTrue",            Test_HandleAppEventNotifier_TTSEvent_ListenTrue },
         { "EventNotifier_SystemDeviceEvent",              Test_HandleAppEventNotifier_SystemDeviceEvent },
         { "EventNotifier_NetworkEvent_UnsubscribeOnly",   Test_HandleAppEventNotifier_NetworkEvent_UnsubscribeOnly },
+        // --- Interface cache tests (AGC_L0_098–AGC_L0_099, AGC_L0_104) ---
+        { "InterfaceCache_ReusesHandle",                  Test_InterfaceCache_ReusesHandle },
+        { "InterfaceCache_InvalidatedOnStateChange",      Test_InterfaceCache_InvalidatedOnPluginStateChange },
+        { "InterfaceCache_ObserversToldOfRevokedPlugins", Test_InterfaceCache_ObserversToldOfRevokedPlugins },
+        // --- Extrapolated counter tests (AGC_L0_100–AGC_L0_101) ---
+        { "ExtrapolatedCounter_AnchorReadInvalidate",     Test_ExtrapolatedCounter_AnchorReadInvalidate },
+        { "ExtrapolatedCounter_ResyncPeriod",             Test_ExtrapolatedCounter_ResyncPeriod },
+        // --- Display capability record tests (AGC_L0_102–AGC_L0_103) ---
+        { "DisplayCapabilities_TrackAndInvalidate",       Test_DisplayCapabilities_TrackAndInvalidate },
+        { "DisplayCapabilities_RefusesStaleFetch",        Test_DisplayCapabilities_RefusesStaleFetch },
     };
 
     uint32_t failures = 0;
@@ -26,7 +26,8 @@
  * This mock is intentionally minimal:
  *  - No sockets/network
  *  - No dependency on other real Thunder plugins
- *  - QueryInterfaceByCallsign returns nullptr (delegates handle this gracefully)
+ *  - QueryInterfaceByCallsign returns nullptr (delegates handle this gracefully),
+ *    unless Config::queryInterface provides the interfaces for a test
  *
  * IMPORTANT:
  * - By default, Release() does NOT delete 'this' to allow stack-allocated/scoped usage.
@@ -35,6 +36,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <functional>
 #include <string>
 
 #include <core/core.h>
@@ -49,13 +51,15 @@ namespace L0Test {
     public:
         struct Config {
             string configLineOverride;
-            explicit Config() : configLineOverride() {}
+            std::function<void*(const uint32_t, const string&)> queryInterface;
+            explicit Config() : configLineOverride(), queryInterface() {}
         };
 
         explicit ServiceMock(Config cfg = Config(), const bool selfDelete = false)
             : _refCount(1)
             , _cfg(cfg)
             , _selfDelete(selfDelete)
+            , _pluginSink(nullptr)
         {
         }
 
@@ -142,13 +146,24 @@ namespace L0Test {
 
         void Notify(const string& /*message*/) override {}
 
-        void Register(WPEFramework::PluginHost::IPlugin::INotification* /*sink*/) override {}
-        void Unregister(WPEFramework::PluginHost::IPlugin::INotification* /*sink*/) override {}
+        void Register(WPEFramework::PluginHost::IPlugin::INotification* sink) override { _pluginSink = sink; }
+        void Unregister(WPEFramework::PluginHost::IPlugin::INotification* sink) override
+        {
+            if (_pluginSink == sink) {
+                _pluginSink = nullptr;
+            }
+        }
+
+        // Last registered plugin state sink, so tests can deliver Deactivated/Unavailable
+        WPEFramework::PluginHost::IPlugin::INotification* PluginSink() const { return _pluginSink; }
 
         state State() const override { return state::ACTIVATED; }
 
-        void* QueryInterfaceByCallsign(const uint32_t /*id*/, const string& /*name*/) override
+        void* QueryInterfaceByCallsign(const uint32_t id, const string& name) override
         {
+            if (_cfg.queryInterface) {
+                return _cfg.queryInterface(id, name);
+            }
             // In L0 tests, no external plugins are available.
             // AppGatewayCommon delegates handle nullptr gracefully.
             return nullptr;
@@ -192,6 +207,7 @@ namespace L0Test {
         mutable std::atomic<uint32_t> _refCount;
         Config _cfg;
         const bool _selfDelete;
+        WPEFramework::PluginHost::IPlugin::INotification* _pluginSink;
     };
 
 } 
@@ -16,6 +16,7 @@
 #include <string>
 #include <mutex>
 #include <algorithm>
+#include <vector>
 
 #include <Module.h>
 #include <core/core.h>
@@ -92,6 +93,8 @@ public:
         lastEmitMethod  = method;
         lastEmitPayload = payload;
         lastEmitContext = ctx;
+        emitMethods.push_back(method);
+        emitPayloads.push_back(payload);
         return WPEFramework::Core::ERROR_NONE;
     }
 
@@ -141,6 +144,9 @@ public:
     string lastRequestParams;
     string lastRespondPayload;
     WPEFramework::Exchange::GatewayContext lastEmitContext{};
+    // Every Emit() in call order
+    std::vector<string> emitMethods;
+    std::vector<string> emitPayloads;
 
     mutable std::mutex _mutex;
 
@@ -347,6 +353,8 @@ public:
         bool handlerStatusResult;
         // Handler return code
         uint32_t handlerReturnCode;
+        // Plugin config line returned by ConfigLine()
+        string configLine;
 
         explicit Config(bool impl           = true,
                         bool gw             = true,
@@ -361,6 +369,7 @@ public:
             , provideNotificationHandler(handler)
             , handlerStatusResult(handlerStatus)
             , handlerReturnCode(handlerRc)
+            , configLine()
         {
         }
     };
@@ -476,7 +485,7 @@ public:
 
     string HashKey() const override { return "hash"; }
 
-    string ConfigLine() const override { return ""; }
+    string ConfigLine() const override { return _cfg.configLine; }
     WPEFramework::Core::hresult ConfigLine(const string& /*config*/) override
     {
         return WPEFramework::Core::ERROR_NONE;
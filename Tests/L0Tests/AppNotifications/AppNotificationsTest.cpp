@@ -67,6 +67,11 @@ extern uint32_t Test_AN_SubscriberMap_Get_NonExistent();
 extern uint32_t Test_AN_SubscriberMap_Exists_True();
 extern uint32_t Test_AN_SubscriberMap_Exists_False();
 extern uint32_t Test_AN_SubscriberMap_Exists_CaseInsensitive();
+extern uint32_t Test_AN_SubscriberMap_Add_Duplicate_DispatchedOnce();
+extern uint32_t Test_AN_SubscriberMap_Add_OverQuota_Rejected();
+extern uint32_t Test_AN_SubscriberMap_Remove_NewRequestId();
+extern uint32_t Test_AN_SubscriberMap_AppIdRefresh_AndChurn();
+extern uint32_t Test_AN_SubscriberMap_EventRingFull_KeepsOrder();
 extern uint32_t Test_AN_EventUpdate_DispatchToAll_EmptyAppId();
 extern uint32_t Test_AN_EventUpdate_FilterByAppId();
 extern uint32_t Test_AN_EventUpdate_NoListeners_LogWarning();
@@ -184,6 +189,11 @@ int main()
         { "AN_SubscriberMap_Exists_True",                    Test_AN_SubscriberMap_Exists_True                     },
         { "AN_SubscriberMap_Exists_False",                   Test_AN_SubscriberMap_Exists_False                    },
         { "AN_SubscriberMap_Exists_CaseInsensitive",         Test_AN_SubscriberMap_Exists_CaseInsensitive          },
+        { "AN_SubscriberMap_Add_Duplicate_DispatchedOnce",   Test_AN_SubscriberMap_Add_Duplicate_DispatchedOnce    },
+        { "AN_SubscriberMap_Add_OverQuota_Rejected",         Test_AN_SubscriberMap_Add_OverQuota_Rejected          },
+        { "AN_SubscriberMap_Remove_NewRequestId",            Test_AN_SubscriberMap_Remove_NewRequestId             },
+        { "AN_SubscriberMap_AppIdRefresh_AndChurn",          Test_AN_SubscriberMap_AppIdRefresh_AndChurn           },
+        { "AN_SubscriberMap_EventRingFull_KeepsOrder",       Test_AN_SubscriberMap_EventRingFull_KeepsOrder        },
         { "AN_EventUpdate_DispatchToAll_EmptyAppId",         Test_AN_EventUpdate_DispatchToAll_EmptyAppId          },
         { "AN_EventUpdate_FilterByAppId",                    Test_AN_EventUpdate_FilterByAppId                     },
         { "AN_EventUpdate_NoListeners_LogWarning",           Test_AN_EventUpdate_NoListeners_LogWarning            },
@@ -3,7 +3,7 @@
  *
  * L0 tests for SubscriberMap internals: Add, Remove, Get, Exists,
  * EventUpdate, Dispatch, DispatchToGateway, DispatchToLaunchDelegate.
- * Tests AN-L0-027 to AN-L0-048.
+ * Tests AN-L0-027 to AN-L0-048 and AN-L0-100 to AN-L0-104.
  *
  * Strategy:
  *   - Instantiate AppNotificationsImplementation and call Configure()
@@ -16,10 +16,14 @@
  *   Subscribe() / Emit() / Cleanup() API.  We test them indirectly.
  */
 
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <chrono>
 #include <thread>
+#include <vector>
+
+#include <unistd.h>
 
 #include <core/core.h>
 #include <plugins/IShell.h>
@@ -28,6 +32,7 @@
 #include <interfaces/IConfiguration.h>
 #include "AppNotificationsServiceMock.h"
 #include "AppNotificationsTestHelpers.h"
+#include "UtilsSharedEventRing.h"
 #include "L0Expect.hpp"
 #include "L0TestTypes.hpp"
 
@@ -1003,3 +1008,288 @@ uint32_t Test_AN_Emit_SpecificAppId_MatchesOne()
     impl->Release();
     return tr.failures;
 }
+
+// ---------------------------------------------------------------------------
+// AN-L0-100: SubscriberMap::Add — duplicate listen is stored once
+// ---------------------------------------------------------------------------
+uint32_t Test_AN_SubscriberMap_Add_Duplicate_DispatchedOnce()
+{
+    /** Listening twice on the same (event, connection, origin) must not double the fan-out. */
+    L0Test::TestResult tr;
+
+    L0Test::AppNotificationsServiceMock shell(MakeSafeConfig());
+    auto* impl = CreateConfiguredImpl(&shell);
+    L0Test::ExpectTrue(tr, impl != nullptr,
+        "SubscriberMap_Add_Duplicate_DispatchedOnce: impl creation");
+    if (impl == nullptr) { return tr.failures; }
+
+    auto ctx1 = MakeContext(30, 3001, "com.app.dup", APP_GATEWAY_CALLSIGN);
+    auto ctx2 = MakeContext(30, 3002, "com.app.dup", APP_GATEWAY_CALLSIGN);
+
+    L0Test::ExpectEqU32(tr, impl->Subscribe(ctx1, true, FB_SETTINGS_CALLSIGN, "onDupEvent"),
+        static_cast<uint32_t>(ERROR_NONE),
+        "SubscriberMap_Add_Duplicate_DispatchedOnce: first listen returns ERROR_NONE");
+    L0Test::ExpectEqU32(tr, impl->Subscribe(ctx2, true, FB_SETTINGS_CALLSIGN, "onDupEvent"),
+        static_cast<uint32_t>(ERROR_NONE),
+        "SubscriberMap_Add_Duplicate_DispatchedOnce: duplicate listen returns ERROR_NONE");
+    YieldToWorkerPool();
+
+    impl->Emit("onDupEvent", "{}", "");
+    YieldToWorkerPool();
+
+    L0Test::ANResponderFake* gw = shell.GetAppGatewayFake();
+    L0Test::ExpectTrue(tr, gw != nullptr,
+        "SubscriberMap_Add_Duplicate_DispatchedOnce: gw acquired");
+    if (gw != nullptr) {
+        L0Test::ExpectEqU32(tr, gw->emitCount, 1u,
+            "SubscriberMap_Add_Duplicate_DispatchedOnce: event dispatched once");
+    }
+
+    impl->Release();
+    return tr.failures;
+}
+
+// ---------------------------------------------------------------------------
+// AN-L0-101: SubscriberMap::Add — per-connection quota from config line
+// ---------------------------------------------------------------------------
+uint32_t Test_AN_SubscriberMap_Add_OverQuota_Rejected()
+{
+    /** Subscriptions beyond maxsubscriptionsperconnection return ERROR_INVALID_RANGE. */
+    L0Test::TestResult tr;
+
+    auto cfg = MakeSafeConfig();
+    cfg.configLine = R"({"maxsubscriptionsperconnection":2})";
+    L0Test::AppNotificationsServiceMock shell(cfg);
+    auto* impl = CreateConfiguredImpl(&shell);
+    L0Test::ExpectTrue(tr, impl != nullptr,
+        "SubscriberMap_Add_OverQuota_Rejected: impl creation");
+    if (impl == nullptr) { return tr.failures; }
+
+    auto ctx = MakeContext(31, 3101, "com.app.quota", APP_GATEWAY_CALLSIGN);
+    auto other = MakeContext(32, 3201, "com.app.other", APP_GATEWAY_CALLSIGN);
+
+    L0Test::ExpectEqU32(tr, impl->Subscribe(ctx, true, FB_SETTINGS_CALLSIGN, "onQuotaA"),
+        static_cast<uint32_t>(ERROR_NONE), "SubscriberMap_Add_OverQuota_Rejected: first within quota");
+    L0Test::ExpectEqU32(tr, impl->Subscribe(ctx, true, FB_SETTINGS_CALLSIGN, "onQuotaB"),
+        static_cast<uint32_t>(ERROR_NONE), "SubscriberMap_Add_OverQuota_Rejected: second within quota");
+    L0Test::ExpectEqU32(tr, impl->Subscribe(ctx, true, FB_SETTINGS_CALLSIGN, "onQuotaC"),
+        static_cast<uint32_t>(WPEFramework::Core::ERROR_INVALID_RANGE),
+        "SubscriberMap_Add_OverQuota_Rejected: third rejected");
+    L0Test::ExpectEqU32(tr, impl->Subscribe(other, true, FB_SETTINGS_CALLSIGN, "onQuotaC"),
+        static_cast<uint32_t>(ERROR_NONE), "SubscriberMap_Add_OverQuota_Rejected: other connection unaffected");
+    YieldToWorkerPool();
+
+    // Only the other connection is listening on onQuotaC
+    impl->Emit("onQuotaC", "{}", "");
+    YieldToWorkerPool();
+
+    L0Test::ANResponderFake* gw = shell.GetAppGatewayFake();
+    if (gw != nullptr) {
+        L0Test::ExpectEqU32(tr, gw->emitCount, 1u,
+            "SubscriberMap_Add_OverQuota_Rejected: rejected subscription receives nothing");
+    }
+
+    // Cleanup frees the quota for the connection
+    impl->Cleanup(31, APP_GATEWAY_CALLSIGN);
+    L0Test::ExpectEqU32(tr, impl->Subscribe(ctx, true, FB_SETTINGS_CALLSIGN, "onQuotaC"),
+        static_cast<uint32_t>(ERROR_NONE), "SubscriberMap_Add_OverQuota_Rejected: accepted after cleanup");
+    YieldToWorkerPool();
+
+    impl->Release();
+    return tr.failures;
+}
+
+// ---------------------------------------------------------------------------
+// AN-L0-102: SubscriberMap::Remove — unlisten with a new requestId
+// ---------------------------------------------------------------------------
+uint32_t Test_AN_SubscriberMap_Remove_NewRequestId()
+{
+    /** listen:false carries its own requestId; it must still remove the subscription. */
+    L0Test::TestResult tr;
+
+    L0Test::AppNotificationsServiceMock shell(MakeSafeConfig());
+    auto* impl = CreateConfiguredImpl(&shell);
+    L0Test::ExpectTrue(tr, impl != nullptr,
+        "SubscriberMap_Remove_NewRequestId: impl creation");
+    if (impl == nullptr) { return tr.failures; }
+
+    auto listen = MakeContext(33, 3301, "com.app.unlisten", APP_GATEWAY_CALLSIGN);
+    auto unlisten = MakeContext(33, 3302, "com.app.unlisten", APP_GATEWAY_CALLSIGN);
+
+    impl->Subscribe(listen, true, FB_SETTINGS_CALLSIGN, "onUnlistenEvent");
+    impl->Subscribe(unlisten, false, FB_SETTINGS_CALLSIGN, "onUnlistenEvent");
+    YieldToWorkerPool();
+
+    impl->Emit("onUnlistenEvent", "{}", "");
+    YieldToWorkerPool();
+
+    L0Test::ANResponderFake* gw = shell.GetAppGatewayFake();
+    const uint32_t emitCount = (gw != nullptr) ? gw->emitCount : 0u;
+    L0Test::ExpectEqU32(tr, emitCount, 0u,
+        "SubscriberMap_Remove_NewRequestId: no dispatch after unlisten");
+
+    impl->Release();
+    return tr.failures;
+}
+
+// ---------------------------------------------------------------------------
+// AN-L0-103: SubscriberMap — appId matching follows refreshes and churn
+// ---------------------------------------------------------------------------
+uint32_t Test_AN_SubscriberMap_AppIdRefresh_AndChurn()
+{
+    /** A duplicate listen with a new appId retargets app-scoped events, and appIds
+     *  released by earlier subscribers never match a later one. */
+    L0Test::TestResult tr;
+
+    L0Test::AppNotificationsServiceMock shell(MakeSafeConfig());
+    auto* impl = CreateConfiguredImpl(&shell);
+    L0Test::ExpectTrue(tr, impl != nullptr,
+        "SubscriberMap_AppIdRefresh_AndChurn: impl creation");
+    if (impl == nullptr) { return tr.failures; }
+
+    // Subscribe and drop many short-lived apps, as app-controlled churn would
+    for (uint32_t index = 0; index < 50; ++index) {
+        auto ctx = MakeContext(100 + index, 1, "com.app.churn" + std::to_string(index), APP_GATEWAY_CALLSIGN);
+        impl->Subscribe(ctx, true, FB_SETTINGS_CALLSIGN, "onChurnEvent");
+        impl->Cleanup(100 + index, APP_GATEWAY_CALLSIGN);
+    }
+
+    auto first = MakeContext(34, 3401, "com.app.before", APP_GATEWAY_CALLSIGN, "1");
+    auto refreshed = MakeContext(34, 3402, "com.app.after", APP_GATEWAY_CALLSIGN, "8");
+    impl->Subscribe(first, true, FB_SETTINGS_CALLSIGN, "onChurnEvent");
+    impl->Subscribe(refreshed, true, FB_SETTINGS_CALLSIGN, "onChurnEvent");
+    YieldToWorkerPool();
+
+    impl->Emit("onChurnEvent", "{}", "com.app.before");
+    impl->Emit("onChurnEvent", "{}", "com.app.churn7");
+    YieldToWorkerPool();
+
+    L0Test::ANResponderFake* gw = shell.GetAppGatewayFake();
+    const uint32_t staleCount = (gw != nullptr) ? gw->emitCount : 0u;
+    L0Test::ExpectEqU32(tr, staleCount, 0u,
+        "SubscriberMap_AppIdRefresh_AndChurn: replaced and released appIds match nothing");
+
+    impl->Emit("onChurnEvent", "{}", "com.app.after");
+    YieldToWorkerPool();
+
+    gw = shell.GetAppGatewayFake();
+    L0Test::ExpectTrue(tr, gw != nullptr,
+        "SubscriberMap_AppIdRefresh_AndChurn: gw acquired");
+    if (gw != nullptr) {
+        L0Test::ExpectEqU32(tr, gw->emitCount, 1u,
+            "SubscriberMap_AppIdRefresh_AndChurn: refreshed appId receives the event");
+        L0Test::ExpectEqU32(tr, gw->lastEmitContext.requestId, 3402u,
+            "SubscriberMap_AppIdRefresh_AndChurn: latest context dispatched");
+        L0Test::ExpectTrue(tr, gw->lastEmitContext.appId == "com.app.after",
+            "SubscriberMap_AppIdRefresh_AndChurn: latest appId dispatched");
+    }
+
+    impl->Release();
+    return tr.failures;
+}
+
+// ---------------------------------------------------------------------------
+// AN-L0-104: SubscriberMap::DispatchToGateway — full event ring keeps order
+// ---------------------------------------------------------------------------
+uint32_t Test_AN_SubscriberMap_EventRingFull_KeepsOrder()
+{
+    /** An event that finds the ring full goes out directly at once, and smaller
+     *  events that would still fit follow it directly; the ring is used again once
+     *  drained. */
+    L0Test::TestResult tr;
+
+    auto cfg = MakeSafeConfig();
+    cfg.configLine = R"({"eventringsize":4096})";
+    L0Test::AppNotificationsServiceMock shell(cfg);
+    auto* impl = CreateConfiguredImpl(&shell);
+    L0Test::ExpectTrue(tr, impl != nullptr,
+        "SubscriberMap_EventRingFull_KeepsOrder: impl creation");
+    if (impl == nullptr) { return tr.failures; }
+
+    auto ctx = MakeContext(35, 3501, "com.app.ring", APP_GATEWAY_CALLSIGN);
+    impl->Subscribe(ctx, true, FB_SETTINGS_CALLSIGN, "onRingEvent");
+    YieldToWorkerPool();
+
+    // Two large events fill most of the ring, the third does not fit; the small
+    // ones after it would, but must not overtake it
+    const std::string pad(1500, 'x');
+    const uint32_t sizes[] = { 1500, 1500, 1500, 10, 10 };
+    for (uint32_t seq = 0; seq < 5; ++seq) {
+        impl->Emit("onRingEvent", "{\"seq\":" + std::to_string(seq) + ",\"pad\":\"" + pad.substr(0, sizes[seq]) + "\"}", "");
+        YieldToWorkerPool(40);
+    }
+
+    L0Test::ANResponderFake* gw = shell.GetAppGatewayFake();
+    L0Test::ExpectTrue(tr, gw != nullptr, "SubscriberMap_EventRingFull_KeepsOrder: gw acquired");
+    if (gw == nullptr) {
+        impl->Release();
+        return tr.failures;
+    }
+
+    // Nothing drained the ring meanwhile: read it the way the gateway would, with
+    // the name and key from the doorbell
+    std::string doorbell;
+    {
+        std::lock_guard<std::mutex> lock(gw->_mutex);
+        for (size_t index = 0; (index < gw->emitMethods.size()) && doorbell.empty(); ++index) {
+            if (gw->emitMethods[index] == APP_GATEWAY_EVENT_RING_DOORBELL) {
+                doorbell = gw->emitPayloads[index];
+            }
+        }
+    }
+    std::string name;
+    uint64_t key = 0;
+    WPEFramework::Utils::SharedEventRing consumer;
+    L0Test::ExpectTrue(tr, WPEFramework::Utils::SharedEventRing::ParseDoorbellPayload(doorbell, name, key)
+            && (name == std::string(APP_GATEWAY_EVENT_RING_PREFIX) + std::to_string(::getpid())),
+        "SubscriberMap_EventRingFull_KeepsOrder: doorbell names the ring");
+    L0Test::ExpectTrue(tr, consumer.Attach(name, key), "SubscriberMap_EventRingFull_KeepsOrder: ring attached");
+
+    auto sequenceOf = [](const std::string& payload) -> int {
+        const size_t at = payload.find("\"seq\":");
+        return (at == std::string::npos) ? -1 : std::atoi(payload.c_str() + at + 6);
+    };
+    std::vector<int> order;
+    uint32_t corrupt = 0;
+    consumer.Drain([&order, &sequenceOf](const WPEFramework::Utils::SharedEventRing::Frame& frame) {
+        order.push_back(sequenceOf(frame.payload));
+    }, corrupt);
+    const size_t queued = order.size();
+
+    size_t directBefore = 0;
+    {
+        std::lock_guard<std::mutex> lock(gw->_mutex);
+        for (size_t index = 0; index < gw->emitMethods.size(); ++index) {
+            if (gw->emitMethods[index] != APP_GATEWAY_EVENT_RING_DOORBELL) {
+                order.push_back(sequenceOf(gw->emitPayloads[index]));
+                ++directBefore;
+            }
+        }
+    }
+    L0Test::ExpectEqU32(tr, static_cast<uint32_t>(queued), 2u,
+        "SubscriberMap_EventRingFull_KeepsOrder: events up to the full ring queued");
+    L0Test::ExpectTrue(tr, order == std::vector<int>({ 0, 1, 2, 3, 4 }),
+        "SubscriberMap_EventRingFull_KeepsOrder: ring and direct events delivered in order");
+
+    // Drained: the next event goes through the ring again
+    impl->Emit("onRingEvent", "{\"seq\":5}", "");
+    YieldToWorkerPool();
+    std::vector<int> later;
+    consumer.Drain([&later, &sequenceOf](const WPEFramework::Utils::SharedEventRing::Frame& frame) {
+        later.push_back(sequenceOf(frame.payload));
+    }, corrupt);
+    L0Test::ExpectTrue(tr, later == std::vector<int>({ 5 }),
+        "SubscriberMap_EventRingFull_KeepsOrder: ring used again once drained");
+    size_t directAfter = 0;
+    {
+        std::lock_guard<std::mutex> lock(gw->_mutex);
+        for (const auto& method : gw->emitMethods) {
+            directAfter += (method != APP_GATEWAY_EVENT_RING_DOORBELL) ? 1 : 0;
+        }
+    }
+    L0Test::ExpectEqU32(tr, static_cast<uint32_t>(directAfter), static_cast<uint32_t>(directBefore),
+        "SubscriberMap_EventRingFull_KeepsOrder: no direct emit once drained");
+
+    impl->Release();
+    return tr.failures;
+}
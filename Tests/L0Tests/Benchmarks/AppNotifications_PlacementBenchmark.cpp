@@ -0,0 +1,336 @@
+/*
+ * AppNotifications_PlacementBenchmark.cpp
+ *
+ * Per-call and per-event cost of AppNotifications in process, next to an emulated
+ * marshaling hop. This is not a measurement of the placement costs as a whole:
+ * nothing here runs real COM-RPC, and AppGateway and AppGatewayCommon are not
+ * measured.
+ *
+ *   colocated  - AppNotificationsImplementation in the WPEFramework process
+ *                ("mode": "Off", APPGATEWAY_COLOCATE_COMPONENTS=ON); the gateway
+ *                calls it through the interface pointer directly.
+ *   emulated   - the same calls carried over a COM-RPC shaped hop: arguments
+ *                serialized into a frame, written to a socketpair, decoded and
+ *                invoked on a stub thread, result written back. This is an
+ *                emulation of the transport path of "mode": "Local" minus the
+ *                process switch, not real COM-RPC, so it is a lower bound for
+ *                the out-of-process cost. It covers AppNotifications calls
+ *                only, not the AppGateway or AppGatewayCommon interfaces.
+ *
+ * Event delivery is measured end to end in the colocated placement (Emit until
+ * the responder receives it). Out of process an event crosses the boundary
+ * twice (backend -> AppNotifications, AppNotifications -> AppGateway), so its
+ * cost is reported as colocated delivery plus two emulated hops of the same
+ * payload size.
+ *
+ * Not part of the L0 suite; build with -DAPPGW_L0_ENABLE_BENCHMARKS=ON and run
+ * appnotifications_l0bench [iterations] on the target.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <core/core.h>
+#include <interfaces/IAppNotifications.h>
+
+#include "AppNotificationsServiceMock.h"
+#include "AppNotificationsTestHelpers.h"
+#include "L0Bootstrap.hpp"
+
+using WPEFramework::Exchange::IAppNotifications;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double NanosPerOp(const Clock::time_point start, const Clock::time_point end, const uint32_t operations)
+{
+    return std::chrono::duration<double, std::nano>(end - start).count() / operations;
+}
+
+// Synchronous request/reply over a socketpair with a dedicated stub thread,
+// mirroring how a COM-RPC proxy hands a call to the remote stub.
+class LoopbackChannel {
+public:
+    using Handler = std::function<uint32_t(const std::vector<std::string>& args)>;
+
+    explicit LoopbackChannel(Handler handler)
+        : _handler(std::move(handler))
+        , _fds { -1, -1 }
+        , _stub()
+    {
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, _fds) == 0) {
+            _stub = std::thread([this]() { Serve(); });
+        }
+    }
+
+    ~LoopbackChannel()
+    {
+        if (_fds[0] >= 0) {
+            ::shutdown(_fds[0], SHUT_RDWR);
+        }
+        if (_stub.joinable()) {
+            _stub.join();
+        }
+        for (int fd : _fds) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+
+    LoopbackChannel(const LoopbackChannel&) = delete;
+    LoopbackChannel& operator=(const LoopbackChannel&) = delete;
+
+    bool IsValid() const { return _stub.joinable(); }
+
+    uint32_t Invoke(const std::vector<std::string>& args)
+    {
+        _frame.clear();
+        Append(_frame, static_cast<uint32_t>(args.size()));
+        for (const std::string& arg : args) {
+            Append(_frame, static_cast<uint32_t>(arg.size()));
+            _frame.append(arg);
+        }
+        uint32_t result = WPEFramework::Core::ERROR_GENERAL;
+        if (WriteAll(_fds[0], _frame.data(), _frame.size())) {
+            ReadAll(_fds[0], &result, sizeof(result));
+        }
+        return result;
+    }
+
+private:
+    static void Append(std::string& frame, const uint32_t value)
+    {
+        frame.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    static bool WriteAll(const int fd, const void* data, size_t length)
+    {
+        const char* cursor = static_cast<const char*>(data);
+        while (length > 0) {
+            const ssize_t written = ::write(fd, cursor, length);
+            if (written <= 0) {
+                return false;
+            }
+            cursor += written;
+            length -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    static bool ReadAll(const int fd, void* data, size_t length)
+    {
+        char* cursor = static_cast<char*>(data);
+        while (length > 0) {
+            const ssize_t received = ::read(fd, cursor, length);
+            if (received <= 0) {
+                return false;
+            }
+            cursor += received;
+            length -= static_cast<size_t>(received);
+        }
+        return true;
+    }
+
+    void Serve()
+    {
+        std::vector<std::string> args;
+        uint32_t count = 0;
+        while (ReadAll(_fds[1], &count, sizeof(count))) {
+            args.resize(count);
+            for (std::string& arg : args) {
+                uint32_t length = 0;
+                if (!ReadAll(_fds[1], &length, sizeof(length))) {
+                    return;
+                }
+                arg.resize(length);
+                if (length > 0 && !ReadAll(_fds[1], &arg[0], length)) {
+                    return;
+                }
+            }
+            const uint32_t result = _handler(args);
+            if (!WriteAll(_fds[1], &result, sizeof(result))) {
+                return;
+            }
+        }
+    }
+
+    Handler _handler;
+    int _fds[2];
+    std::thread _stub;
+    std::string _frame;
+};
+
+// The fake's counter is a plain integer bumped on the worker thread
+uint32_t EmitCount(const L0Test::ANResponderFake* gateway)
+{
+    return __atomic_load_n(&gateway->emitCount, __ATOMIC_ACQUIRE);
+}
+
+IAppNotifications::AppNotificationContext MakeContext(const uint32_t connectionId)
+{
+    IAppNotifications::AppNotificationContext context;
+    context.connectionId = connectionId;
+    context.requestId = 1;
+    context.appId = "com.bench.app";
+    context.origin = APP_GATEWAY_CALLSIGN;
+    context.version = "0";
+    return context;
+}
+
+void Report(const char* operation, const char* placement, const double nanos)
+{
+    std::printf("%-34s %-12s %12.0f ns/op\n", operation, placement, nanos);
+}
+
+double BenchSubscribeDirect(IAppNotifications* impl, const uint32_t iterations)
+{
+    const IAppNotifications::AppNotificationContext context = MakeContext(1);
+    const Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        impl->Subscribe(context, true, "org.rdk.Bench", "onBenchSubscribe");
+        impl->Subscribe(context, false, "org.rdk.Bench", "onBenchSubscribe");
+    }
+    return NanosPerOp(start, Clock::now(), iterations * 2);
+}
+
+double BenchSubscribeMarshaled(IAppNotifications* impl, const uint32_t iterations)
+{
+    LoopbackChannel channel([impl](const std::vector<std::string>& args) -> uint32_t {
+        IAppNotifications::AppNotificationContext context;
+        context.connectionId = static_cast<uint32_t>(std::strtoul(args[0].c_str(), nullptr, 10));
+        context.requestId = static_cast<uint32_t>(std::strtoul(args[1].c_str(), nullptr, 10));
+        context.appId = args[2];
+        context.origin = args[3];
+        context.version = args[4];
+        return impl->Subscribe(context, args[5] == "1", args[6], args[7]);
+    });
+    if (!channel.IsValid()) {
+        return 0.0;
+    }
+    const Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        channel.Invoke({ "1", "1", "com.bench.app", APP_GATEWAY_CALLSIGN, "0", "1", "org.rdk.Bench", "onBenchSubscribe" });
+        channel.Invoke({ "1", "1", "com.bench.app", APP_GATEWAY_CALLSIGN, "0", "0", "org.rdk.Bench", "onBenchSubscribe" });
+    }
+    return NanosPerOp(start, Clock::now(), iterations * 2);
+}
+
+double BenchHop(const std::string& payload, const uint32_t iterations)
+{
+    LoopbackChannel channel([](const std::vector<std::string>&) -> uint32_t {
+        return WPEFramework::Core::ERROR_NONE;
+    });
+    if (!channel.IsValid()) {
+        return 0.0;
+    }
+    const std::vector<std::string> args { "onBenchEvent", payload, "" };
+    const Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        channel.Invoke(args);
+    }
+    return NanosPerOp(start, Clock::now(), iterations);
+}
+
+double BenchEmitCallDirect(IAppNotifications* impl, const std::string& payload, const uint32_t iterations)
+{
+    const Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        impl->Emit("onBenchUnsubscribed", payload, "");
+    }
+    return NanosPerOp(start, Clock::now(), iterations);
+}
+
+// Emit -> EmitJob -> EventUpdate -> responder Emit, measured until the last event lands
+double BenchEventDelivery(IAppNotifications* impl, L0Test::AppNotificationsServiceMock& shell,
+                          const std::string& payload, const uint32_t iterations)
+{
+    const IAppNotifications::AppNotificationContext context = MakeContext(2);
+    impl->Subscribe(context, true, "org.rdk.Bench", "onBenchEvent");
+    impl->Emit("onBenchEvent", payload, "");
+
+    const Clock::time_point warmupDeadline = Clock::now() + std::chrono::seconds(5);
+    while (shell.GetAppGatewayFake() == nullptr || EmitCount(shell.GetAppGatewayFake()) == 0) {
+        if (Clock::now() > warmupDeadline) {
+            return 0.0;
+        }
+        std::this_thread::yield();
+    }
+    L0Test::ANResponderFake* gateway = shell.GetAppGatewayFake();
+    const uint32_t baseline = EmitCount(gateway);
+
+    const Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        impl->Emit("onBenchEvent", payload, "");
+    }
+    const Clock::time_point deadline = start + std::chrono::seconds(30);
+    while (EmitCount(gateway) < baseline + iterations) {
+        if (Clock::now() > deadline) {
+            return 0.0;
+        }
+        std::this_thread::yield();
+    }
+    const Clock::time_point end = Clock::now();
+
+    impl->Subscribe(context, false, "org.rdk.Bench", "onBenchEvent");
+    return NanosPerOp(start, end, iterations);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const uint32_t iterations = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 20000;
+    if (iterations == 0) {
+        std::fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    L0Test::L0BootstrapGuard bootstrap;
+
+    L0Test::AppNotificationsServiceMock::Config config;
+    config.provideNotificationHandler = false;
+    L0Test::AppNotificationsServiceMock shell(config);
+    IAppNotifications* impl = L0Test::CreateConfiguredImpl(&shell);
+    if (impl == nullptr) {
+        std::fprintf(stderr, "failed to create AppNotificationsImplementation\n");
+        return 1;
+    }
+
+    std::printf("AppNotifications in-process cost vs. an emulated hop, %u iterations\n", iterations);
+    std::printf("'emulated' rows stand in a socketpair hop for COM-RPC and cover AppNotifications only;\n"
+                "they are not measured over real COM-RPC and are a lower bound for out-of-process cost\n\n");
+
+    Report("Subscribe/Unsubscribe", "colocated", BenchSubscribeDirect(impl, iterations));
+    Report("Subscribe/Unsubscribe", "emulated", BenchSubscribeMarshaled(impl, iterations));
+
+    const size_t sizes[] = { 64, 1024, 8192 };
+    for (const size_t size : sizes) {
+        const std::string payload = "{\"value\":\"" + std::string(size, 'x') + "\"}";
+        const std::string label = "event " + std::to_string(size) + "B";
+
+        const double hop = BenchHop(payload, iterations);
+        const double emitCall = BenchEmitCallDirect(impl, payload, iterations);
+        const double delivery = BenchEventDelivery(impl, shell, payload, iterations);
+
+        std::printf("\n");
+        Report((label + " Emit call").c_str(), "colocated", emitCall);
+        Report((label + " Emit call").c_str(), "emulated", emitCall + hop);
+        Report((label + " delivery").c_str(), "colocated", delivery);
+        Report((label + " delivery (est.)").c_str(), "emulated", delivery + 2 * hop);
+    }
+
+    impl->Release();
+    return 0;
+}
@@ -0,0 +1,178 @@
+/*
+ * JobPool_ChurnBenchmark.cpp
+ *
+ * Heap allocations and time per job for the worker-pool jobs AppNotifications
+ * creates on every Emit and Subscribe, with and without Utils::JobPool:
+ *
+ *   heap    - the pre-pool shape: Core::ProxyType<JOB>::Create() with the
+ *             strings copied in through the constructor, freed on release
+ *   pooled  - EmitJob::Create / SubscriberJob::Create as shipped, taking the
+ *             job from its JobPool and handing it back on release
+ *
+ * Allocations are counted by replacing the global operator new, after a
+ * warm-up round so the pooled rows show the steady state. Jobs are created
+ * and released without being dispatched; dispatch cost does not depend on
+ * where the job came from.
+ *
+ * Not part of the L0 suite; build with -DAPPGW_L0_ENABLE_BENCHMARKS=ON and run
+ * jobpool_l0bench [iterations] on the target.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+// Pulls in the jobs together with the rest of the implementation they refer to
+// NOLINTNEXTLINE(build/include)
+#include <AppNotificationsImplementation.cpp>
+
+using WPEFramework::Core::IDispatch;
+using WPEFramework::Core::ProxyType;
+using WPEFramework::Plugin::AppNotificationsImplementation;
+
+namespace {
+
+std::atomic<uint64_t> g_allocations(0);
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Same members as AppNotificationsImplementation::EmitJob before it was pooled
+class HeapEmitJob : public IDispatch {
+public:
+    HeapEmitJob(AppNotificationsImplementation* parent, const string& event, const string& payload, const string& appId)
+        : mParent(parent), mEvent(event), mPayload(payload), mAppId(appId) {}
+
+    void Dispatch() override {}
+
+private:
+    AppNotificationsImplementation* mParent;
+    string mEvent;
+    string mPayload;
+    string mAppId;
+};
+
+// Same members as AppNotificationsImplementation::SubscriberJob before it was pooled
+class HeapSubscriberJob : public IDispatch {
+public:
+    HeapSubscriberJob(AppNotificationsImplementation* parent, const string& module, const string& event, const bool subscribe)
+        : mParent(parent), mEvent(event), mModule(module), mSubscribe(subscribe) {}
+
+    void Dispatch() override {}
+
+private:
+    AppNotificationsImplementation* mParent;
+    string mEvent;
+    string mModule;
+    bool mSubscribe;
+};
+
+struct Result {
+    double allocationsPerJob;
+    double nanosPerJob;
+};
+
+template <typename CREATE>
+Result Measure(const uint32_t iterations, CREATE&& create)
+{
+    // Warm-up: fills the pool and lets the strings reach their steady capacity
+    for (uint32_t index = 0; index < 64; ++index) {
+        ProxyType<IDispatch> job = create();
+    }
+
+    const uint64_t before = g_allocations.load(std::memory_order_relaxed);
+    const Clock::time_point start = Clock::now();
+    for (uint32_t index = 0; index < iterations; ++index) {
+        ProxyType<IDispatch> job = create();
+        if (!job.IsValid()) {
+            std::abort();
+        }
+    }
+    const Clock::time_point end = Clock::now();
+    const uint64_t allocations = g_allocations.load(std::memory_order_relaxed) - before;
+
+    Result result;
+    result.allocationsPerJob = static_cast<double>(allocations) / iterations;
+    result.nanosPerJob = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    return result;
+}
+
+void Report(const char* job, const char* source, const Result& result)
+{
+    std::printf("%-16s %-8s %8.2f allocs/job %10.0f ns/job\n", job, source, result.allocationsPerJob, result.nanosPerJob);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const uint32_t iterations = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 200000;
+    if (iterations == 0) {
+        std::fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    // Long enough to live outside the small string buffer, like real event traffic
+    const string event = "Device.onNetworkStatusChanged";
+    const string payload = "{\"connected\":true,\"interface\":\"WIFI\",\"ipAddress\":\"192.168.100.200\","
+                           "\"ssid\":\"benchmark-network\",\"signalStrength\":-54,\"frequency\":5.18}";
+    const string appId = "com.example.benchmark.application";
+    const string module = "org.rdk.NetworkManager";
+
+    std::printf("Job churn, %u jobs per row, steady state after warm-up\n", iterations);
+
+    Report("EmitJob", "heap", Measure(iterations, [&]() {
+        return ProxyType<IDispatch>(ProxyType<HeapEmitJob>::Create(nullptr, event, payload, appId));
+    }));
+    Report("EmitJob", "pooled", Measure(iterations, [&]() {
+        return AppNotificationsImplementation::EmitJob::Create(nullptr, event, payload, appId);
+    }));
+    Report("SubscriberJob", "heap", Measure(iterations, [&]() {
+        return ProxyType<IDispatch>(ProxyType<HeapSubscriberJob>::Create(nullptr, module, event, true));
+    }));
+    Report("SubscriberJob", "pooled", Measure(iterations, [&]() {
+        return AppNotificationsImplementation::SubscriberJob::Create(nullptr, module, event, true);
+    }));
+    return 0;
+}
@@ -0,0 +1,421 @@
+/*
+ * Resolver_ScalingBenchmark.cpp
+ *
+ * How Resolver::LoadConfig, lookups and reloads scale with the size of
+ * resolutions.json. For each requested size a synthetic config is generated
+ * and the benchmark reports:
+ *
+ *   load      - LoadConfig on an empty resolver (parse + insert)
+ *   memory    - resident set growth caused by the loaded tables
+ *   lookup    - ResolveAlias p50/p99 with N concurrent reader threads
+ *   reload    - ClearResolutions + LoadConfig while the readers keep running,
+ *               and the reader p99 observed during the reload
+ *
+ * The generated configs follow the shape of resolution.base.json: a handful of
+ * large modules and a long tail of small ones, about a fifth of the methods
+ * permission gated, event keys, some versioned events, "params" schemas,
+ * additionalContext and a few trailing-'*' prefix rules. Lookups are Zipf
+ * distributed over the keys, with a share of prefix-rule hits and misses.
+ *
+ * LoadConfig logs every entry at INFO on stderr; run with 2>/dev/null so the
+ * terminal does not dominate the load numbers.
+ *
+ * Not part of the L0 suite; build with -DAPPGW_L0_ENABLE_BENCHMARKS=ON and run
+ *   appgateway_l0bench [--out DIR] [--readers N] [--lookups N] [entries...]
+ * Defaults are 4 readers, 200000 lookups per reader and 1000 10000 100000
+ * entries. With --out the generated configs are kept in DIR.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <malloc.h>
+#include <unistd.h>
+
+#include <core/core.h>
+
+#include <Resolver.h>
+
+using WPEFramework::Plugin::Resolver;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double Millis(const Clock::time_point start, const Clock::time_point end)
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+size_t ResidentBytes()
+{
+    long pages = 0;
+    long resident = 0;
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm != nullptr) {
+        if (std::fscanf(statm, "%ld %ld", &pages, &resident) != 2) {
+            resident = 0;
+        }
+        std::fclose(statm);
+    }
+    return static_cast<size_t>(resident) * static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+// ---------------------------------------------------------------------------
+// Synthetic config generator
+// ---------------------------------------------------------------------------
+
+struct SyntheticConfig {
+    std::string json;
+    // Keys that resolve exactly, in popularity order (index 0 is the hottest)
+    std::vector<std::string> keys;
+    // Keys that only resolve through a prefix rule
+    std::vector<std::string> prefixKeys;
+    size_t prefixRules;
+};
+
+class ConfigGenerator {
+public:
+    explicit ConfigGenerator(const uint32_t seed)
+        : _random(seed)
+    {
+    }
+
+    SyntheticConfig Generate(const uint32_t entries)
+    {
+        static const char* const knownModules[] = {
+            "device", "localization", "metrics", "texttospeech", "voiceguidance", "accessibility",
+            "lifecycle", "closedcaptions", "audiodescriptions", "network", "discovery", "advertising"
+        };
+        static const char* const verbs[] = { "get", "set", "is", "request", "update", "clear" };
+        static const char* const nouns[] = {
+            "Name", "Language", "Locale", "Resolution", "Volume", "Profile", "Settings", "Status",
+            "Preference", "Timezone", "Capabilities", "Session", "Token", "Region", "Mode", "State"
+        };
+
+        SyntheticConfig config;
+        config.prefixRules = 0;
+        config.keys.reserve(entries);
+
+        // Module sizes fall off roughly as 1/rank, like the shipping file
+        const uint32_t moduleCount = std::max<uint32_t>(12, entries / 40);
+        std::vector<double> weights(moduleCount);
+        double total = 0.0;
+        for (uint32_t rank = 0; rank < moduleCount; ++rank) {
+            weights[rank] = 1.0 / (rank + 1);
+            total += weights[rank];
+        }
+        std::vector<uint32_t> perModule(moduleCount, 0);
+        uint32_t assigned = 0;
+        for (uint32_t rank = 0; rank < moduleCount && assigned < entries; ++rank) {
+            perModule[rank] = std::max<uint32_t>(1, static_cast<uint32_t>(entries * weights[rank] / total));
+            perModule[rank] = std::min(perModule[rank], entries - assigned);
+            assigned += perModule[rank];
+        }
+        perModule[0] += entries - assigned;
+
+        std::uniform_int_distribution<uint32_t> percent(0, 99);
+        std::string& json = config.json;
+        json.reserve(static_cast<size_t>(entries) * 160);
+        json = "{\n    \"resolutions\": {\n";
+        bool first = true;
+
+        for (uint32_t module = 0; module < moduleCount; ++module) {
+            const std::string moduleName = (module < (sizeof(knownModules) / sizeof(knownModules[0])))
+                ? std::string(knownModules[module])
+                : "vendor" + std::to_string(module);
+            const std::string plugin = "org.rdk.Plugin" + std::to_string(module % 64);
+
+            // One module in ten forwards its unknown methods with a prefix rule
+            if ((module % 10) == 9) {
+                AppendEntry(json, first, moduleName + ".*", "\"alias\": \"" + plugin + ".*\"");
+                config.prefixRules++;
+                config.prefixKeys.push_back(moduleName + ".forwarded" + std::to_string(module));
+            }
+
+            for (uint32_t method = 0; method < perModule[module]; ++method) {
+                const char* verb = verbs[method % (sizeof(verbs) / sizeof(verbs[0]))];
+                const char* noun = nouns[(method / 6) % (sizeof(nouns) / sizeof(nouns[0]))];
+                const uint32_t roll = percent(_random);
+
+                std::string key;
+                std::string body;
+                if (roll < 15) {
+                    // Event key, a third of them versioned
+                    key = moduleName + ".on" + noun + "Changed" + std::to_string(method);
+                    body = "\"event\": \"" + plugin + "\", \"alias\": \"" + plugin + "\"";
+                    if ((method % 3) == 0) {
+                        body += ", \"versionedEvent\": true";
+                    }
+                } else {
+                    key = moduleName + "." + verb + noun + std::to_string(method);
+                    if (roll < 75) {
+                        body = "\"alias\": \"org.rdk.AppGatewayCommon\", \"useComRpc\": true";
+                    } else {
+                        body = "\"alias\": \"" + plugin + "." + verb + noun + "\"";
+                    }
+                }
+                if (percent(_random) < 20) {
+                    body += ", \"permissionGroup\": \"org.rdk.permission.group.enhanced\"";
+                }
+                if (roll >= 15 && roll < 20) {
+                    body += ", \"additionalContext\": { \"origin\": \"" + moduleName + "\" }";
+                }
+                if (roll >= 20 && roll < 25) {
+                    body += ", \"params\": { \"value\": { \"type\": \"string\", \"required\": true } }";
+                }
+                AppendEntry(json, first, key, body);
+                config.keys.push_back(std::move(key));
+            }
+        }
+        json += "\n    }\n}\n";
+
+        // Popularity does not follow file order
+        std::shuffle(config.keys.begin(), config.keys.end(), _random);
+        return config;
+    }
+
+private:
+    static void AppendEntry(std::string& json, bool& first, const std::string& key, const std::string& body)
+    {
+        if (!first) {
+            json += ",\n";
+        }
+        first = false;
+        json += "        \"" + key + "\": { " + body + " }";
+    }
+
+    std::mt19937 _random;
+};
+
+// ---------------------------------------------------------------------------
+// Lookup workload
+// ---------------------------------------------------------------------------
+
+// Zipf (s = 1) over the exact keys, plus prefix-rule hits and misses
+class LookupMix {
+public:
+    LookupMix(const SyntheticConfig& config)
+        : _config(config)
+        , _cdf(config.keys.size())
+    {
+        double sum = 0.0;
+        for (size_t rank = 0; rank < _cdf.size(); ++rank) {
+            sum += 1.0 / (rank + 1);
+            _cdf[rank] = sum;
+        }
+        for (double& value : _cdf) {
+            value /= sum;
+        }
+    }
+
+    const std::string& Pick(std::mt19937& random, std::string& scratch) const
+    {
+        const uint32_t roll = random() % 100;
+        if (roll < 3 && !_config.prefixKeys.empty()) {
+            return _config.prefixKeys[random() % _config.prefixKeys.size()];
+        }
+        if (roll < 8) {
+            scratch = "unknown.method" + std::to_string(random() % 1000);
+            return scratch;
+        }
+        const double target = std::uniform_real_distribution<double>(0.0, 1.0)(random);
+        const size_t index = std::lower_bound(_cdf.begin(), _cdf.end(), target) - _cdf.begin();
+        return _config.keys[std::min(index, _cdf.size() - 1)];
+    }
+
+private:
+    const SyntheticConfig& _config;
+    std::vector<double> _cdf;
+};
+
+struct Percentiles {
+    double p50;
+    double p99;
+    size_t samples;
+};
+
+Percentiles Summarize(std::vector<std::vector<uint32_t>>& perThread)
+{
+    std::vector<uint32_t> all;
+    for (const std::vector<uint32_t>& samples : perThread) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    Percentiles result = { 0.0, 0.0, all.size() };
+    if (!all.empty()) {
+        std::sort(all.begin(), all.end());
+        result.p50 = all[(all.size() - 1) * 50 / 100];
+        result.p99 = all[(all.size() - 1) * 99 / 100];
+    }
+    return result;
+}
+
+// Runs the readers until each has done its lookups (or, with a stop flag, until
+// it is raised) and returns per-lookup latencies in nanoseconds
+Percentiles RunReaders(Resolver& resolver, const LookupMix& mix, const uint32_t readers,
+                       const uint32_t lookups, const std::atomic<bool>* stop)
+{
+    std::vector<std::vector<uint32_t>> latencies(readers);
+    std::vector<std::thread> threads;
+    std::atomic<uint32_t> ready(0);
+    std::atomic<bool> go(false);
+
+    for (uint32_t reader = 0; reader < readers; ++reader) {
+        threads.emplace_back([&, reader]() {
+            std::mt19937 random(1000 + reader);
+            std::string scratch;
+            std::vector<uint32_t>& samples = latencies[reader];
+            samples.reserve(lookups);
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (uint32_t i = 0; (stop != nullptr) ? !stop->load(std::memory_order_relaxed) : (i < lookups); ++i) {
+                const std::string& key = mix.Pick(random, scratch);
+                const Clock::time_point start = Clock::now();
+                const std::string alias = resolver.ResolveAlias(key);
+                const Clock::time_point end = Clock::now();
+                samples.push_back(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+            }
+        });
+    }
+    while (ready.load() < readers) {
+        std::this_thread::yield();
+    }
+    go.store(true, std::memory_order_release);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return Summarize(latencies);
+}
+
+bool WriteFile(const std::string& path, const std::string& content)
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    file << content;
+    return file.good();
+}
+
+void RunSize(const uint32_t entries, const std::string& directory, const uint32_t readers, const uint32_t lookups)
+{
+    ConfigGenerator generator(entries);
+    SyntheticConfig config = generator.Generate(entries);
+    const std::string path = directory + "/resolutions." + std::to_string(entries) + ".json";
+    if (!WriteFile(path, config.json)) {
+        std::fprintf(stderr, "failed to write %s\n", path.c_str());
+        return;
+    }
+    const size_t fileBytes = config.json.size();
+    config.json.clear();
+    config.json.shrink_to_fit();
+    LookupMix mix(config);
+
+    ::malloc_trim(0);
+    const size_t residentBefore = ResidentBytes();
+
+    Resolver resolver(nullptr);
+    const Clock::time_point loadStart = Clock::now();
+    const bool loaded = resolver.LoadConfig(path);
+    const double loadMs = Millis(loadStart, Clock::now());
+    if (!loaded) {
+        std::fprintf(stderr, "LoadConfig failed for %s\n", path.c_str());
+        return;
+    }
+    ::malloc_trim(0);
+    const size_t residentAfter = ResidentBytes();
+
+    const Percentiles steady = RunReaders(resolver, mix, readers, lookups, nullptr);
+
+    std::atomic<bool> stop(false);
+    Percentiles duringReload = { 0.0, 0.0, 0 };
+    std::thread background([&]() { duringReload = RunReaders(resolver, mix, readers, 0, &stop); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const Clock::time_point reloadStart = Clock::now();
+    resolver.ClearResolutions();
+    resolver.LoadConfig(path);
+    const double reloadMs = Millis(reloadStart, Clock::now());
+    stop.store(true);
+    background.join();
+
+    std::printf("%8u entries  %7.1f KB file  %3zu prefix rules\n", entries, fileBytes / 1024.0, config.prefixRules);
+    std::printf("    load             %10.2f ms\n", loadMs);
+    std::printf("    resident growth  %10.1f KB  (%.0f B/entry)\n",
+                (residentAfter > residentBefore) ? (residentAfter - residentBefore) / 1024.0 : 0.0,
+                (residentAfter > residentBefore) ? static_cast<double>(residentAfter - residentBefore) / entries : 0.0);
+    std::printf("    lookup           p50 %8.0f ns  p99 %8.0f ns  (%u readers, %zu lookups)\n",
+                steady.p50, steady.p99, readers, steady.samples);
+    std::printf("    reload           %10.2f ms\n", reloadMs);
+    std::printf("    lookup (reload)  p50 %8.0f ns  p99 %8.0f ns  (%zu lookups)\n\n",
+                duringReload.p50, duringReload.p99, duringReload.samples);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string directory;
+    uint32_t readers = 4;
+    uint32_t lookups = 200000;
+    std::vector<uint32_t> sizes;
+
+    for (int index = 1; index < argc; ++index) {
+        const std::string arg = argv[index];
+        if ((arg == "--out" || arg == "--readers" || arg == "--lookups") && (index + 1) < argc) {
+            const char* value = argv[++index];
+            if (arg == "--out") {
+                directory = value;
+            } else if (arg == "--readers") {
+                readers = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            } else {
+                lookups = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            }
+        } else if (!arg.empty() && arg[0] != '-') {
+            sizes.push_back(static_cast<uint32_t>(std::strtoul(arg.c_str(), nullptr, 10)));
+        } else {
+            sizes.clear();
+            readers = 0;
+            break;
+        }
+    }
+    if (sizes.empty() && readers != 0) {
+        sizes = { 1000, 10000, 100000 };
+    }
+    if (readers == 0 || lookups == 0 || std::find(sizes.begin(), sizes.end(), 0U) != sizes.end()) {
+        std::fprintf(stderr, "usage: %s [--out DIR] [--readers N] [--lookups N] [entries...]\n", argv[0]);
+        return 1;
+    }
+
+    const bool keep = !directory.empty();
+    if (!keep) {
+        char pattern[] = "/tmp/resolver_bench_XXXXXX";
+        if (::mkdtemp(pattern) == nullptr) {
+            std::fprintf(stderr, "failed to create a temporary directory\n");
+            return 1;
+        }
+        directory = pattern;
+    }
+
+    std::printf("Resolver scaling benchmark\n\n");
+    for (const uint32_t entries : sizes) {
+        RunSize(entries, directory, readers, lookups);
+    }
+
+    if (!keep) {
+        for (const uint32_t entries : sizes) {
+            ::unlink((directory + "/resolutions." + std::to_string(entries) + ".json").c_str());
+        }
+        ::rmdir(directory.c_str());
+    } else {
+        std::printf("Generated configs kept in %s\n", directory.c_str());
+    }
+    return 0;
+}
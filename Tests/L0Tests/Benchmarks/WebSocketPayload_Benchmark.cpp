@@ -0,0 +1,202 @@
+/*
+ * WebSocketPayload_Benchmark.cpp
+ *
+ * Throughput of the inbound WebSocket payload work done on the resource
+ * monitor thread, per kernel set available on this CPU (scalar, sse2/avx2 or
+ * neon), against the byte-at-a-time loops they replace:
+ *
+ *   unmask   - XOR with the 4 byte masking key
+ *   utf8     - UTF-8 validation of a JSON-RPC text payload, all ASCII
+ *   utf8-mb  - the same with about one multibyte character per 16 bytes
+ *   frame    - WebSocketInboundFrames::Prepare on a whole masked text frame
+ *              (header rewrite + unmask + validate)
+ *
+ * Frame sizes default to 64 256 1024 4096 16384 65536 bytes; each size is run
+ * until about 64 MiB have been processed. Results are MB/s.
+ *
+ * Not part of the L0 suite; build with -DAPPGW_L0_ENABLE_BENCHMARKS=ON and run
+ *   websocketpayload_l0bench [sizes...]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "UtilsWebSocketPayload.h"
+
+using WPEFramework::Utils::Utf8Validator;
+using WPEFramework::Utils::WebSocketInboundFrames;
+using WPEFramework::Utils::WebSocketPayload;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+static const uint8_t kKey[4] = { 0x5A, 0x13, 0xC4, 0x7E };
+static const size_t kVolume = 64 * 1024 * 1024;
+
+// Keeps results observable so the loops are not optimised away
+volatile uint32_t gSink = 0;
+
+std::string Payload(const size_t size, const bool multibyte)
+{
+    // Shape of a bulk metrics.* report
+    static const char* const kRecord = "{\"name\":\"metrics.mediaProgress\",\"value\":12345,\"unit\":\"ms\"},";
+    static const char* const kWide = "\xC3\xA9";
+    std::string text = "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"metrics.report\",\"params\":[";
+    while (text.size() < size) {
+        text += kRecord;
+        if (multibyte) {
+            text.insert(text.size() - 20, kWide);
+            text.insert(text.size() - 40, kWide);
+            text.insert(text.size() - 50, kWide);
+        }
+    }
+    text.resize(size);
+    // Do not end inside a multibyte character
+    while (!text.empty() && (static_cast<uint8_t>(text.back()) >= 0x80)) {
+        text.back() = ' ';
+    }
+    return text;
+}
+
+std::vector<uint8_t> MaskedFrame(const std::string& payload)
+{
+    std::vector<uint8_t> frame;
+    frame.push_back(0x81);
+    if (payload.size() < 126) {
+        frame.push_back(static_cast<uint8_t>(0x80 | payload.size()));
+    } else if (payload.size() <= 0xFFFF) {
+        frame.push_back(0x80 | 126);
+        frame.push_back(static_cast<uint8_t>(payload.size() >> 8));
+        frame.push_back(static_cast<uint8_t>(payload.size() & 0xFF));
+    } else {
+        frame.push_back(0x80 | 127);
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            frame.push_back(static_cast<uint8_t>(static_cast<uint64_t>(payload.size()) >> shift));
+        }
+    }
+    frame.insert(frame.end(), kKey, kKey + 4);
+    for (size_t index = 0; index < payload.size(); ++index) {
+        frame.push_back(static_cast<uint8_t>(payload[index]) ^ kKey[index & 0x03]);
+    }
+    return frame;
+}
+
+void UnmaskBytewise(uint8_t* data, const size_t length)
+{
+    for (size_t index = 0; index < length; ++index) {
+        data[index] ^= kKey[index & 0x03];
+    }
+}
+
+bool Utf8Bytewise(const uint8_t* data, const size_t length)
+{
+    // Same automaton without the ASCII skip
+    Utf8Validator validator;
+    bool ok = true;
+    for (size_t index = 0; ok && (index < length); ++index) {
+        ok = (data[index] < 0x80) ? true : validator.Update(&data[index], 1);
+    }
+    return (ok && validator.Complete());
+}
+
+template <typename WORK>
+double MegabytesPerSecond(const size_t size, WORK&& work)
+{
+    const size_t rounds = std::max<size_t>(1, kVolume / size);
+    work(); // warm up
+    const Clock::time_point start = Clock::now();
+    for (size_t round = 0; round < rounds; ++round) {
+        work();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return (static_cast<double>(size) * static_cast<double>(rounds)) / (seconds * 1e6);
+}
+
+void Run(const char* name, const size_t size, const bool kernelsApply)
+{
+    const std::string ascii = Payload(size, false);
+    const std::string wide = Payload(size, true);
+    std::vector<uint8_t> buffer(ascii.begin(), ascii.end());
+    const std::vector<uint8_t> frame = MaskedFrame(ascii);
+    std::vector<uint8_t> work(frame.size());
+
+    double unmask;
+    double utf8;
+    double utf8mb;
+    if (kernelsApply) {
+        unmask = MegabytesPerSecond(size, [&]() {
+            WebSocketPayload::Unmask(buffer.data(), buffer.size(), kKey, 0);
+            gSink += buffer[size / 2];
+        });
+        utf8 = MegabytesPerSecond(size, [&]() {
+            gSink += Utf8Validator::IsValid(reinterpret_cast<const uint8_t*>(ascii.data()), ascii.size()) ? 1 : 0;
+        });
+        utf8mb = MegabytesPerSecond(size, [&]() {
+            gSink += Utf8Validator::IsValid(reinterpret_cast<const uint8_t*>(wide.data()), wide.size()) ? 1 : 0;
+        });
+    } else {
+        unmask = MegabytesPerSecond(size, [&]() {
+            UnmaskBytewise(buffer.data(), buffer.size());
+            gSink += buffer[size / 2];
+        });
+        utf8 = MegabytesPerSecond(size, [&]() {
+            gSink += Utf8Bytewise(reinterpret_cast<const uint8_t*>(ascii.data()), ascii.size()) ? 1 : 0;
+        });
+        utf8mb = MegabytesPerSecond(size, [&]() {
+            gSink += Utf8Bytewise(reinterpret_cast<const uint8_t*>(wide.data()), wide.size()) ? 1 : 0;
+        });
+    }
+
+    double whole = 0.0;
+    if (kernelsApply) {
+        whole = MegabytesPerSecond(size, [&]() {
+            ::memcpy(work.data(), frame.data(), frame.size());
+            WebSocketInboundFrames frames;
+            uint16_t skip = 0;
+            gSink += frames.Prepare(work.data(), work.size(), skip) ? skip : 0;
+        });
+    }
+
+    std::printf("%-9s %8zu %10.0f %10.0f %10.0f", name, size, unmask, utf8, utf8mb);
+    if (kernelsApply) {
+        std::printf(" %10.0f\n", whole);
+    } else {
+        std::printf(" %10s\n", "-");
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::vector<size_t> sizes;
+    for (int index = 1; index < argc; ++index) {
+        const long value = std::strtol(argv[index], nullptr, 10);
+        if (value > 0) {
+            sizes.push_back(static_cast<size_t>(value));
+        }
+    }
+    if (sizes.empty()) {
+        sizes = { 64, 256, 1024, 4096, 16384, 65536 };
+    }
+
+    const WebSocketPayload::Kernels* kernels[3];
+    const uint8_t count = WebSocketPayload::Available(kernels, 3);
+
+    std::printf("default kernels: %s\n\n", WebSocketPayload::Active().name);
+    std::printf("%-9s %8s %10s %10s %10s %10s   (MB/s)\n", "kernels", "bytes", "unmask", "utf8", "utf8-mb", "frame");
+    for (const size_t size : sizes) {
+        Run("bytewise", size, false);
+        for (uint8_t index = 0; index < count; ++index) {
+            WebSocketPayload::Select(kernels[index]->name);
+            Run(kernels[index]->name, size, true);
+        }
+    }
+    return (gSink == 0xFFFFFFFF ? 1 : 0);
+}
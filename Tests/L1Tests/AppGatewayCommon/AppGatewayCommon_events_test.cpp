@@ -19,6 +19,8 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
 #include <string>
 
 #include "Module.h"
@@ -163,6 +165,91 @@ TEST_F(EventsTest, AGC_L1_205_Metrics_NoOp_ReturnsNull)
     EXPECT_EQ("null", result);
 }
 
+TEST_F(EventsTest, AGC_L1_235_Metrics_AggregatedPerAppAndMetric)
+{
+    auto ctx = MakeContext();
+    string result;
+    for (int i = 1; i <= 4; ++i) {
+        const string payload = R"({"entityId":"movie","progress":)" + std::to_string(i * 10) + "}";
+        EXPECT_EQ(Core::ERROR_NONE, plugin.HandleAppGatewayRequest(ctx, "metrics.mediaProgress", payload, result));
+        EXPECT_EQ("null", result);
+    }
+    EXPECT_EQ(Core::ERROR_NONE, plugin.HandleAppGatewayRequest(ctx, "metrics.ready", "{}", result));
+
+    std::vector<AppMetricsSink::Summary> summaries;
+    plugin.mMetricsSink.Drain(summaries);
+    ASSERT_EQ(2u, summaries.size());
+    for (const auto& summary : summaries) {
+        EXPECT_EQ(ctx.appId, summary.appId);
+        if (summary.metric == "mediaprogress") {
+            EXPECT_EQ(4u, summary.count);
+            EXPECT_EQ(4u, summary.valueCount);
+            EXPECT_DOUBLE_EQ(25.0, summary.mean);
+            EXPECT_DOUBLE_EQ(40.0, summary.max);
+            EXPECT_LE(summary.p50, summary.p95);
+        } else {
+            EXPECT_EQ("ready", summary.metric);
+            EXPECT_EQ(1u, summary.count);
+            EXPECT_EQ(0u, summary.valueCount);
+        }
+    }
+
+    // Drained counters start over
+    summaries.clear();
+    plugin.mMetricsSink.Drain(summaries);
+    EXPECT_TRUE(summaries.empty());
+}
+
+TEST_F(EventsTest, AGC_L1_236_Metrics_IdleSlotsAreReused)
+{
+    AppMetricsSink sink;
+    for (uint32_t index = 0; index < AppMetricsSink::Capacity; ++index) {
+        EXPECT_TRUE(sink.Record("app" + std::to_string(index), "launch", false, 0.0));
+    }
+    // Table full: a new pair is dropped and counted
+    EXPECT_FALSE(sink.Record("late.app", "launch", false, 0.0));
+    EXPECT_EQ(1u, sink.Dropped());
+
+    std::vector<AppMetricsSink::Summary> summaries;
+    sink.Drain(summaries);
+    EXPECT_EQ(static_cast<size_t>(AppMetricsSink::Capacity), summaries.size());
+    EXPECT_EQ(static_cast<uint32_t>(AppMetricsSink::Capacity), sink.InUse());
+
+    // A pair that stays busy keeps its slot, pairs idle for a whole interval give theirs back
+    EXPECT_TRUE(sink.Record("app0", "launch", false, 0.0));
+    summaries.clear();
+    sink.Drain(summaries);
+    ASSERT_EQ(1u, summaries.size());
+    EXPECT_EQ("app0", summaries[0].appId);
+    EXPECT_EQ(1u, sink.InUse());
+
+    EXPECT_TRUE(sink.Record("late.app", "launch", true, 5.0));
+    summaries.clear();
+    sink.Drain(summaries);
+    ASSERT_EQ(1u, summaries.size());
+    EXPECT_EQ("late.app", summaries[0].appId);
+    EXPECT_EQ(1u, summaries[0].count);
+    EXPECT_DOUBLE_EQ(5.0, summaries[0].max);
+    EXPECT_EQ(1u, sink.Dropped());
+}
+
+TEST_F(EventsTest, AGC_L1_237_Metrics_OutOfRangeValuesAreClamped)
+{
+    AppMetricsSink sink;
+    EXPECT_TRUE(sink.Record("app", "progress", true, std::nan("")));
+    EXPECT_TRUE(sink.Record("app", "progress", true, std::numeric_limits<double>::infinity()));
+    EXPECT_TRUE(sink.Record("app", "progress", true, -5.0));
+    EXPECT_TRUE(sink.Record("app", "progress", true, 1e300));
+
+    std::vector<AppMetricsSink::Summary> summaries;
+    sink.Drain(summaries);
+    ASSERT_EQ(1u, summaries.size());
+    EXPECT_EQ(4u, summaries[0].count);
+    // Non-finite values are not counted as values; the rest are clamped to the range
+    EXPECT_EQ(2u, summaries[0].valueCount);
+    EXPECT_DOUBLE_EQ(static_cast<double>(UINT64_MAX / 1000), summaries[0].max);
+}
+
 // Fixture for tests that null out mDelegate. The base Deinitialize unconditionally
 // dereferences mDelegate, so these tests must not call Deinitialize in TearDown.
 class NullDelegateEventsTest : public ::testing::Test {
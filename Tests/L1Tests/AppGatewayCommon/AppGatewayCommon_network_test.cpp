@@ -132,8 +132,16 @@ protected:
         delete sService;     sService = nullptr;
     }
 
+    // What the controller reports when NetworkManager is deactivated
+    static void DeactivateNetworkManager()
+    {
+        sPlugin->mDelegate->interfaceCache->mNotification.Deactivated("org.rdk.NetworkManager", nullptr);
+    }
+
     void TearDown() override
     {
+        // Each test scripts its own NetworkManager answers; do not serve the previous one
+        DeactivateNetworkManager();
         ::testing::Mock::VerifyAndClearExpectations(sMockNetwork);
         EXPECT_CALL(*sMockNetwork, Register(_)).Times(AnyNumber()).WillRepeatedly(Return(Core::ERROR_NONE));
         EXPECT_CALL(*sMockNetwork, Unregister(_)).Times(AnyNumber()).WillRepeatedly(Return(Core::ERROR_NONE));
@@ -340,6 +348,101 @@ TEST_F(NetworkDelegateTest, AGC_L1_156_GetInternetConnectionStatus_BothEthernetA
     EXPECT_NE(result.find("ethernet"), std::string::npos);
 }
 
+TEST_F(NetworkDelegateTest, AGC_L1_233_GetNetworkConnected_RepeatedReads_ServedFromSnapshot)
+{
+    EXPECT_CALL(mockNetwork, GetPrimaryInterface(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>("eth0"), Return(Core::ERROR_NONE)));
+
+    const auto ctx = MakeContext();
+    for (int i = 0; i < 5; ++i) {
+        string result;
+        EXPECT_EQ(Core::ERROR_NONE, plugin.HandleAppGatewayRequest(ctx, "network.connected", "{}", result));
+        EXPECT_EQ("true", result);
+    }
+
+    // An active interface change updates the snapshot without another COM-RPC call
+    auto networkDelegate = plugin.mDelegate->getNetworkDelegate();
+    networkDelegate->mNotificationHandler.onActiveInterfaceChange("eth0", "");
+    string result;
+    EXPECT_EQ(Core::ERROR_NONE, plugin.HandleAppGatewayRequest(ctx, "network.connected", "{}", result));
+    EXPECT_EQ("false", result);
+}
+
+TEST_F(NetworkDelegateTest, AGC_L1_234_GetInternetConnectionStatus_InvalidatedByStatusEvent)
+{
+    Exchange::INetworkManager::InterfaceDetails wifiIface;
+    wifiIface.type = Exchange::INetworkManager::INTERFACE_TYPE_WIFI;
+    wifiIface.name = "wlan0";
+    wifiIface.connected = true;
+
+    auto makeIterator = [&wifiIface]() {
+        auto* mockIterator = new NiceMock<MockInterfaceDetailsIterator>();
+        EXPECT_CALL(*mockIterator, Next(_))
+            .WillOnce(DoAll(SetArgReferee<0>(wifiIface), Return(true)))
+            .WillRepeatedly(Return(false));
+        EXPECT_CALL(*mockIterator, Release())
+            .WillOnce(::testing::Invoke([mockIterator]() { delete mockIterator; return 0; }));
+        return mockIterator;
+    };
+
+    EXPECT_CALL(mockNetwork, GetAvailableInterfaces(_))
+        .Times(2)
+        .WillOnce(DoAll(SetArgReferee<0>(makeIterator()), Return(Core::ERROR_NONE)))
+        .WillOnce(DoAll(SetArgReferee<0>(makeIterator()), Return(Core::ERROR_NONE)));
+
+    const auto ctx = MakeContext();
+    for (int i = 0; i < 3; ++i) {
+        string result;
+        EXPECT_EQ(Core::ERROR_NONE, plugin.HandleAppGatewayRequest(ctx, "device.network", "{}", result));
+        EXPECT_NE(result.find("wifi"), std::string::npos);
+    }
+
+    // The event does not carry the interface type, so the next read rebuilds once
+    plugin.mDelegate->getNetworkDelegate()->mNotificationHandler.onInternetStatusChange(
+        Exchange::INetworkManager::INTERNET_FULLY_CONNECTED,
+        Exchange::INetworkManager::INTERNET_LIMITED,
+        "wlan0");
+    for (int i = 0; i < 3; ++i) {
+        string result;
+        EXPECT_EQ(Core::ERROR_NONE, plugin.HandleAppGatewayRequest(ctx, "device.network", "{}", result));
+        EXPECT_NE(result.find("wifi"), std::string::npos);
+    }
+}
+
+TEST_F(NetworkDelegateTest, AGC_L1_238_Connectivity_DroppedWhenNetworkManagerDeactivated)
+{
+    EXPECT_CALL(mockNetwork, GetPrimaryInterface(_))
+        .Times(2)
+        .WillOnce(DoAll(SetArgReferee<0>("eth0"), Return(Core::ERROR_NONE)))
+        .WillOnce(DoAll(SetArgReferee<0>(""), Return(Core::ERROR_NONE)));
+
+    const auto ctx = MakeContext();
+    string result;
+    EXPECT_EQ(Core::ERROR_NONE, plugin.HandleAppGatewayRequest(ctx, "network.connected", "{}", result));
+    EXPECT_EQ("true", result);
+    EXPECT_EQ(Core::ERROR_NONE, plugin.HandleAppGatewayRequest(ctx, "network.connected", "{}", result));
+    EXPECT_EQ("true", result);
+
+    // No events come from a deactivated NetworkManager: its registration and the
+    // snapshot go with it, and the next read starts over on a fresh interface
+    EXPECT_CALL(mockNetwork, Unregister(_)).WillOnce(Return(Core::ERROR_NONE)).RetiresOnSaturation();
+    DeactivateNetworkManager();
+    auto networkDelegate = plugin.mDelegate->getNetworkDelegate();
+    EXPECT_EQ(nullptr, networkDelegate->mNetworkManager);
+    EXPECT_FALSE(networkDelegate->mNotificationHandler.GetRegistered());
+
+    EXPECT_CALL(mockNetwork, Register(_)).WillOnce(Return(Core::ERROR_NONE)).RetiresOnSaturation();
+    EXPECT_EQ(Core::ERROR_NONE, plugin.HandleAppGatewayRequest(ctx, "network.connected", "{}", result));
+    EXPECT_EQ("false", result);
+    EXPECT_NE(nullptr, networkDelegate->mNetworkManager);
+
+    // Another plugin going away leaves the new snapshot alone
+    plugin.mDelegate->interfaceCache->mNotification.Deactivated("org.rdk.Unrelated", nullptr);
+    EXPECT_EQ(Core::ERROR_NONE, plugin.HandleAppGatewayRequest(ctx, "network.connected", "{}", result));
+    EXPECT_EQ("false", result);
+}
+
 /* ================================================================
  * Category B – Null NetworkManager interface
  *
@@ -1033,6 +1033,35 @@ TEST_F(SystemDelegateTest, AGC_L1_139_GetTimeZone_MissingTimeZoneField)
     EXPECT_NE(Core::ERROR_NONE, rc);
 }
 
+TEST_F(SystemDelegateTest, AGC_L1_239_TimeSinceWakeup_DroppedWhenPowerManagerDeactivated)
+{
+    auto systemDelegate = plugin.mDelegate->getSystemDelegate();
+    ASSERT_NE(systemDelegate, nullptr);
+    auto& sinceWakeup = systemDelegate->_sinceWakeup;
+
+    int64_t drift = 0;
+    ASSERT_TRUE(sinceWakeup.Anchor(120, sinceWakeup.Generation(), drift));
+    uint64_t seconds = 0;
+    EXPECT_TRUE(sinceWakeup.Read(seconds));
+
+    // Only PowerManager going away (deactivated or crashed) ends the extrapolation
+    plugin.mDelegate->interfaceCache->mNotification.Deactivated("org.rdk.Unrelated", nullptr);
+    EXPECT_TRUE(sinceWakeup.Read(seconds));
+
+    plugin.mDelegate->interfaceCache->mNotification.Deactivated("org.rdk.PowerManager", nullptr);
+    EXPECT_FALSE(sinceWakeup.Read(seconds));
+    EXPECT_EQ(nullptr, systemDelegate->_powerModeSource);
+
+    // With PowerManager gone the value is not served from the old anchor
+    const auto ctx = MakeContext();
+    string result;
+    EXPECT_EQ(Core::ERROR_UNAVAILABLE, plugin.HandleAppGatewayRequest(ctx, "device.timeinactivestate", "{}", result));
+
+    ASSERT_TRUE(sinceWakeup.Anchor(60, sinceWakeup.Generation(), drift));
+    plugin.mDelegate->interfaceCache->mNotification.Unavailable("org.rdk.PowerManager", nullptr);
+    EXPECT_FALSE(sinceWakeup.Read(seconds));
+}
+
 /* ================================================================
  * Gap C – SystemDelegate Emit notification dispatch tests
  *
@@ -42,6 +42,10 @@
 #include "ServiceMock.h"
 #include "COMLinkMock.h"
 #include "DispatcherMock.h"
+#include "UtilsIso3166.h"
+#include "UtilsRequestArena.h"
+#include "UtilsTraceId.h"
+#include "UtilsWarmSnapshot.h"
 #include "WorkerPoolImplementation.h"
 
 using namespace WPEFramework;
@@ -346,6 +350,325 @@ TEST(AppGatewayPluginTest, Resolver_LoadConfigAndQueryFields_Success)
     std::remove(path.c_str());
 }
 
+TEST(AppGatewayPluginTest, Resolver_ResolveEventName_UsesPrecomputedVersionedName)
+{
+    Resolver resolver(nullptr);
+    const std::string cfg = R"({
+      "resolutions": {
+        "Accessibility.onClosedCaptionsSettingsChanged": {
+          "alias": "org.rdk.FbSettings",
+          "event": "Accessibility.onClosedCaptionsSettingsChanged",
+          "versionedEvent": true
+        },
+        "device.onNameChanged": {
+          "alias": "org.rdk.FbSettings",
+          "event": "device.onNameChanged"
+        }
+      }
+    })";
+
+    const std::string path = WriteResolverTempConfig("agw_resolver_versioned.json", cfg);
+    ASSERT_TRUE(resolver.LoadConfig(path));
+
+    EXPECT_EQ("Accessibility.onClosedCaptionsSettingsChanged.v8",
+        resolver.ResolveEventName("accessibility.onclosedcaptionssettingschanged", "8"));
+    EXPECT_EQ("accessibility.onclosedcaptionssettingschanged",
+        resolver.ResolveEventName("accessibility.onclosedcaptionssettingschanged", "0"));
+    EXPECT_EQ("device.onNameChanged", resolver.ResolveEventName("device.onNameChanged", "8"));
+    EXPECT_EQ("unknown.event", resolver.ResolveEventName("unknown.event", "8"));
+
+    std::remove(path.c_str());
+}
+
+TEST(AppGatewayPluginTest, Resolver_PrefixRules_ExactFirstThenLongestPrefix)
+{
+    Resolver resolver(nullptr);
+    const std::string cfg = R"({
+      "resolutions": {
+        "device.*": {
+          "alias": "org.rdk.AppGatewayCommon",
+          "useComRpc": true
+        },
+        "device.audio*": {
+          "alias": "org.rdk.DisplaySettings.*",
+          "permissionGroup": "device.audio"
+        },
+        "device.name": {
+          "alias": "org.rdk.DeviceInfo.name"
+        },
+        "device.bad*key*": {
+          "alias": "x.y"
+        }
+      }
+    })";
+
+    const std::string path = WriteResolverTempConfig("agw_resolver_prefix.json", cfg);
+    ASSERT_TRUE(resolver.LoadConfig(path));
+
+    // Exact key wins over any prefix rule
+    EXPECT_EQ("org.rdk.DeviceInfo.name", resolver.ResolveAlias("Device.Name"));
+    EXPECT_FALSE(resolver.HasComRpcRequestSupport("device.name"));
+
+    // Namespace wildcard
+    EXPECT_EQ("org.rdk.AppGatewayCommon", resolver.ResolveAlias("device.make"));
+    EXPECT_TRUE(resolver.HasComRpcRequestSupport("Device.Make"));
+
+    // Longer prefix takes precedence and its '*' alias receives the unmatched tail
+    EXPECT_EQ("org.rdk.DisplaySettings.Settings", resolver.ResolveAlias("device.audioSettings"));
+    std::string permissionGroup;
+    EXPECT_TRUE(resolver.HasPermissionGroup("device.audioSettings", permissionGroup));
+    EXPECT_EQ("device.audio", permissionGroup);
+
+    // A key that only spells the prefix leaves no tail for the '*' alias
+    EXPECT_TRUE(resolver.ResolveAlias("device.audio").empty());
+    EXPECT_EQ("org.rdk.AppGatewayCommon", resolver.ResolveAlias("device."));
+
+    // Keys outside every prefix and malformed wildcard keys do not resolve
+    EXPECT_TRUE(resolver.ResolveAlias("devicex").empty());
+    EXPECT_EQ("org.rdk.AppGatewayCommon", resolver.ResolveAlias("device.badkey"));
+
+    resolver.ClearResolutions();
+    EXPECT_FALSE(resolver.IsConfigured());
+    EXPECT_TRUE(resolver.ResolveAlias("device.make").empty());
+
+    std::remove(path.c_str());
+}
+
+TEST(AppGatewayPluginTest, Resolver_ParamsSchema_RejectsMalformedLiterals)
+{
+    Resolver resolver(nullptr);
+    const std::string cfg = R"({
+      "resolutions": {
+        "ui.setFlag": {
+          "alias": "org.rdk.AppGatewayCommon",
+          "params": { "flag": { "type": "boolean" } }
+        },
+        "voiceguidance.setSpeed": {
+          "alias": "org.rdk.AppGatewayCommon",
+          "params": { "value": { "type": "number" } }
+        },
+        "audio.setVolume": {
+          "alias": "org.rdk.AppGatewayCommon",
+          "params": { "value": { "type": "number", "min": 0, "max": 100 } }
+        }
+      }
+    })";
+    const std::string path = WriteResolverTempConfig("agw_resolver_params_literals.json", cfg);
+    ASSERT_TRUE(resolver.LoadConfig(path));
+
+    std::string message;
+    EXPECT_TRUE(resolver.ValidateParams("ui.setFlag", "null", message));
+    EXPECT_TRUE(resolver.ValidateParams("ui.setFlag", " null \n", message));
+    EXPECT_TRUE(resolver.ValidateParams("ui.setFlag", R"({"flag":true,"other":null})", message));
+    EXPECT_TRUE(resolver.ValidateParams("ui.setFlag", R"({"flag":false ,"other":[null, true]})", message));
+
+    // Literals must end at a delimiter
+    for (const char* params : { "nullx", "null}", "null null" }) {
+        EXPECT_FALSE(resolver.ValidateParams("ui.setFlag", params, message)) << params;
+        EXPECT_EQ("Params must be an object", message) << params;
+    }
+    for (const char* params : { R"({"flag":truex})", R"({"flag":falsey})", R"({"flag":nullx})",
+                                R"({"flag":true"x"})", R"({"other":nul})", R"({"other":trueish,"flag":true})" }) {
+        EXPECT_FALSE(resolver.ValidateParams("ui.setFlag", params, message)) << params;
+        EXPECT_EQ("Malformed params", message) << params;
+    }
+
+    EXPECT_TRUE(resolver.ValidateParams("voiceguidance.setSpeed", R"({"value":-1.5e0})", message));
+    EXPECT_TRUE(resolver.ValidateParams("voiceguidance.setSpeed", R"({"value":0})", message));
+    // A number needs at least one digit after the sign, and digits after '.' and 'e'
+    for (const char* params : { R"({"value":-})", R"({"value":- 1})", R"({"value":-x})", R"({"value":01})",
+                                R"({"value":1.})", R"({"value":.5})", R"({"value":1e})", R"({"value":1x})",
+                                R"({"other":-,"value":1})" }) {
+        EXPECT_FALSE(resolver.ValidateParams("voiceguidance.setSpeed", params, message)) << params;
+        EXPECT_EQ("Malformed params", message) << params;
+    }
+
+    // Nothing may follow the object, and nested brackets must close in order
+    EXPECT_TRUE(resolver.ValidateParams("ui.setFlag", " {\"flag\":true} \n", message));
+    for (const char* params : { R"({"flag":true} garbage)", R"({}})", R"({"flag":true},)",
+                                R"({"other":{]})", R"({"other":[}})", R"({"other":[{"a":[1]]}})" }) {
+        EXPECT_FALSE(resolver.ValidateParams("ui.setFlag", params, message)) << params;
+        EXPECT_EQ("Malformed params", message) << params;
+    }
+
+    // Range checks read the whole number, however long its text is
+    const std::string tiny = "0." + std::string(70, '0') + "1";
+    EXPECT_TRUE(resolver.ValidateParams("audio.setVolume", "{\"value\":" + tiny + "}", message));
+    EXPECT_FALSE(resolver.ValidateParams("audio.setVolume", "{\"value\":" + tiny + "e200}", message));
+    EXPECT_EQ("Parameter 'value' is out of range", message);
+
+    std::remove(path.c_str());
+}
+
+TEST(AppGatewayPluginTest, Resolver_ParamsSchema_ValidatesRawParams)
+{
+    Resolver resolver(nullptr);
+    const std::string cfg = R"({
+      "resolutions": {
+        "device.setName": {
+          "alias": "org.rdk.AppGatewayCommon",
+          "params": {
+            "value": { "type": "string", "required": true }
+          }
+        },
+        "voiceguidance.setSpeed": {
+          "alias": "org.rdk.AppGatewayCommon",
+          "params": {
+            "value": { "type": "number", "required": true, "min": 0.5, "max": 2 }
+          }
+        },
+        "closedcaptions.setFontFamily": {
+          "alias": "org.rdk.AppGatewayCommon",
+          "params": {
+            "value": { "type": "string", "enum": ["monospaced_serif", "proportional_serif"] },
+            "count": { "type": "integer" }
+          }
+        },
+        "device.name": {
+          "alias": "org.rdk.AppGatewayCommon"
+        }
+      }
+    })";
+
+    const std::string path = WriteResolverTempConfig("agw_resolver_params_schema.json", cfg);
+    ASSERT_TRUE(resolver.LoadConfig(path));
+
+    std::string message;
+    EXPECT_TRUE(resolver.ValidateParams("device.setName", R"({"value":"Living Room","extra":[1,{"a":"}"}]})", message));
+    EXPECT_FALSE(resolver.ValidateParams("device.setName", "{}", message));
+    EXPECT_EQ("Missing required parameter 'value'", message);
+    EXPECT_FALSE(resolver.ValidateParams("device.setName", "", message));
+    EXPECT_FALSE(resolver.ValidateParams("device.setName", R"({"value":true})", message));
+    EXPECT_EQ("Parameter 'value' must be a string", message);
+    EXPECT_FALSE(resolver.ValidateParams("device.setName", R"({"value":"x")", message));
+    EXPECT_EQ("Malformed params", message);
+
+    EXPECT_TRUE(resolver.ValidateParams("VoiceGuidance.setSpeed", R"({ "value" : 1.5 })", message));
+    EXPECT_TRUE(resolver.ValidateParams("voiceguidance.setSpeed", R"({"value":2})", message));
+    EXPECT_FALSE(resolver.ValidateParams("voiceguidance.setSpeed", R"({"value":3})", message));
+    EXPECT_EQ("Parameter 'value' is out of range", message);
+
+    EXPECT_TRUE(resolver.ValidateParams("closedcaptions.setFontFamily", R"({"value":"proportional_serif"})", message));
+    EXPECT_TRUE(resolver.ValidateParams("closedcaptions.setFontFamily", "", message));
+    EXPECT_FALSE(resolver.ValidateParams("closedcaptions.setFontFamily", R"({"value":"cursive"})", message));
+    EXPECT_FALSE(resolver.ValidateParams("closedcaptions.setFontFamily", R"({"count":1.5})", message));
+    EXPECT_EQ("Parameter 'count' must be an integer", message);
+
+    // Methods without a schema and unknown methods are not validated here
+    EXPECT_TRUE(resolver.ValidateParams("device.name", "not json", message));
+    EXPECT_TRUE(resolver.ValidateParams("unknown.method", "not json", message));
+
+    std::remove(path.c_str());
+}
+
+TEST(AppGatewayPluginTest, Resolver_Snapshot_RestoresTablesOnlyForMatchingSources)
+{
+    const std::string cfg = R"({
+      "resolutions": {
+        "device.setName": {
+          "alias": "org.rdk.System.setFriendlyName",
+          "permissionGroup": "org.rdk.permission.group.enhanced",
+          "params": { "value": { "type": "string", "required": true } }
+        },
+        "Device.onNameChanged": {
+          "alias": "org.rdk.AppGatewayCommon",
+          "event": "org.rdk.AppGatewayCommon",
+          "versionedEvent": true
+        },
+        "discovery.launch": {
+          "alias": "org.rdk.AppGatewayCommon",
+          "additionalContext": { "origin": "discovery" }
+        },
+        "device.*": { "alias": "org.rdk.System.*" },
+        "device.audio.*": { "alias": "org.rdk.DisplaySettings" }
+      }
+    })";
+    const std::string path = WriteResolverTempConfig("agw_resolver_snapshot.json", cfg);
+    const std::string snapshot = path + ".snapshot";
+    const uint64_t fingerprint = Utils::WarmSnapshot::Fingerprint({ path });
+
+    {
+        Resolver source(nullptr);
+        ASSERT_TRUE(source.LoadConfig(path));
+        ASSERT_TRUE(source.SaveSnapshot(snapshot, fingerprint));
+    }
+
+    Resolver resolver(nullptr);
+    EXPECT_FALSE(resolver.LoadSnapshot(snapshot, fingerprint + 1));
+    EXPECT_FALSE(resolver.IsConfigured());
+    ASSERT_TRUE(resolver.LoadSnapshot(snapshot, fingerprint));
+
+    EXPECT_EQ("org.rdk.System.setFriendlyName", resolver.ResolveAlias("device.setName"));
+    EXPECT_EQ("org.rdk.System.getMake", resolver.ResolveAlias("device.getMake"));
+    EXPECT_EQ("org.rdk.DisplaySettings", resolver.ResolveAlias("device.audio.get"));
+    std::string group;
+    EXPECT_TRUE(resolver.HasPermissionGroup("device.setName", group));
+    EXPECT_EQ("org.rdk.permission.group.enhanced", group);
+    EXPECT_TRUE(resolver.IsVersionedEvent("device.onNameChanged"));
+    EXPECT_EQ("Device.onNameChanged.v8", resolver.ResolveEventName("device.onNameChanged", "8"));
+    JsonValue additionalContext;
+    EXPECT_TRUE(resolver.HasIncludeContext("discovery.launch", additionalContext));
+    EXPECT_EQ(Core::JSON::Variant::type::OBJECT, additionalContext.Content());
+    std::string message;
+    EXPECT_FALSE(resolver.ValidateParams("device.setName", "{}", message));
+    EXPECT_EQ("Missing required parameter 'value'", message);
+
+    // Editing the source changes its fingerprint, so the snapshot no longer applies
+    std::ofstream(path, std::ios::app) << "\n";
+    Resolver stale(nullptr);
+    EXPECT_FALSE(stale.LoadSnapshot(snapshot, Utils::WarmSnapshot::Fingerprint({ path })));
+
+    std::remove(path.c_str());
+    std::remove(snapshot.c_str());
+}
+
+TEST(AppGatewayPluginTest, Resolver_Snapshot_WarmMatchesColdForNonObjectContexts)
+{
+    const std::string cfg = R"({
+      "resolutions": {
+        "context.object": { "alias": "org.rdk.A", "additionalContext": { "origin": "discovery" } },
+        "context.string": { "alias": "org.rdk.B", "includeContext": true, "additionalContext": "discovery" },
+        "context.array": { "alias": "org.rdk.C", "includeContext": true, "additionalContext": [ "a", 1, { "b": true } ] },
+        "context.number": { "alias": "org.rdk.D", "includeContext": true, "additionalContext": 42 },
+        "context.boolean": { "alias": "org.rdk.E", "additionalContext": false },
+        "context.none": { "alias": "org.rdk.F", "includeContext": true }
+      }
+    })";
+    const std::string path = WriteResolverTempConfig("agw_resolver_snapshot_contexts.json", cfg);
+    const std::string snapshot = path + ".snapshot";
+    const uint64_t fingerprint = Utils::WarmSnapshot::Fingerprint({ path });
+
+    Resolver cold(nullptr);
+    ASSERT_TRUE(cold.LoadConfig(path));
+    ASSERT_TRUE(cold.SaveSnapshot(snapshot, fingerprint));
+    Resolver warm(nullptr);
+    ASSERT_TRUE(warm.LoadSnapshot(snapshot, fingerprint));
+
+    for (const char* method : { "context.object", "context.string", "context.array", "context.number", "context.boolean", "context.none" }) {
+        JsonValue coldContext;
+        JsonValue warmContext;
+        const bool coldInclude = cold.HasIncludeContext(method, coldContext);
+        const bool warmInclude = warm.HasIncludeContext(method, warmContext);
+        EXPECT_EQ(coldInclude, warmInclude) << method;
+        EXPECT_EQ(coldContext.IsSet(), warmContext.IsSet()) << method;
+        EXPECT_EQ(coldContext.Content(), warmContext.Content()) << method;
+        std::string coldText;
+        std::string warmText;
+        coldContext.ToString(coldText);
+        warmContext.ToString(warmText);
+        EXPECT_EQ(coldText, warmText) << method;
+        EXPECT_EQ(cold.HasComRpcRequestSupport(method), warm.HasComRpcRequestSupport(method)) << method;
+    }
+
+    JsonValue context;
+    EXPECT_TRUE(warm.HasIncludeContext("context.string", context));
+    EXPECT_EQ(Core::JSON::Variant::type::STRING, context.Content());
+    EXPECT_EQ("discovery", context.String());
+
+    std::remove(path.c_str());
+    std::remove(snapshot.c_str());
+}
+
 TEST(AppGatewayPluginTest, Resolver_ClearResolutions_MakesResolverUnconfigured)
 {
     Resolver resolver(nullptr);
@@ -715,6 +1038,34 @@ TEST(AppGatewayPluginTest, AppGatewayImplementation_UpdateContext_InvalidParamsS
         std::remove(path.c_str());
 }
 
+TEST(AppGatewayPluginTest, AppGatewayImplementation_UpdateContext_CarriesTraceIdOfCurrentRequest)
+{
+        TestAppGatewayImplementation impl;
+        impl.mResolverPtr = std::make_shared<Resolver>(nullptr);
+
+        const std::string cfg = R"({"resolutions":{"device.name":{"alias":"org.rdk.DeviceInfo.name","includeContext":true}}})";
+        const std::string path = WriteResolverTempConfig("agw_impl_update_context_trace.json", cfg);
+        ASSERT_TRUE(impl.mResolverPtr->LoadConfig(path));
+
+        const auto ctx = MakeImplementationContext();
+        const std::string untraced = impl.UpdateContext(ctx, "device.name", R"({"k":"v"})", "org.rdk.AppGateway", false);
+        EXPECT_EQ(std::string::npos, untraced.find("traceId"));
+
+        const uint64_t first = Utils::TraceId::Next();
+        const uint64_t second = Utils::TraceId::Next();
+        EXPECT_NE(first, second);
+        EXPECT_EQ(16u, Utils::TraceId::ToString(first).size());
+        {
+            Utils::TraceId::Scope trace(first);
+            EXPECT_EQ(first, Utils::TraceId::CurrentOrNext());
+            const std::string traced = impl.UpdateContext(ctx, "device.name", R"({"k":"v"})", "org.rdk.AppGateway", false);
+            EXPECT_NE(std::string::npos, traced.find("\"traceId\":\"" + Utils::TraceId::ToString(first) + "\""));
+        }
+        EXPECT_EQ(0u, Utils::TraceId::Current());
+
+        std::remove(path.c_str());
+}
+
 TEST(AppGatewayPluginTest, AppGatewayImplementation_PreProcessEvent_MissingListenReturnsBadRequest)
 {
         TestAppGatewayImplementation impl;
@@ -832,6 +1183,146 @@ TEST(AppGatewayPluginTest, AppGatewayImplementation_FetchResolvedData_HandlesRes
         std::remove(path.c_str());
 }
 
+TEST(AppGatewayPluginTest, Iso3166_Alpha3ToAlpha2_CoversAssignedCodes)
+{
+    using WPEFramework::Utils::Iso3166::Alpha3ToAlpha2;
+    std::string country;
+    EXPECT_TRUE(Alpha3ToAlpha2("USA", country));
+    EXPECT_EQ("us", country);
+    // First and last entries of the table, and territories beyond the original handful
+    EXPECT_TRUE(Alpha3ToAlpha2("abw", country));
+    EXPECT_EQ("aw", country);
+    EXPECT_TRUE(Alpha3ToAlpha2("ZWE", country));
+    EXPECT_EQ("zw", country);
+    EXPECT_TRUE(Alpha3ToAlpha2("Fra", country));
+    EXPECT_EQ("fr", country);
+    EXPECT_TRUE(Alpha3ToAlpha2("NLD", country));
+    EXPECT_EQ("nl", country);
+
+    country = "unchanged";
+    EXPECT_FALSE(Alpha3ToAlpha2("XYZ", country));
+    EXPECT_FALSE(Alpha3ToAlpha2("us", country));
+    EXPECT_FALSE(Alpha3ToAlpha2("", country));
+    EXPECT_EQ("unchanged", country);
+}
+
+TEST(AppGatewayPluginTest, RequestArena_ScopeRewind_ReusesSlots)
+{
+    auto& arena = WPEFramework::Utils::RequestArena::Current();
+    const size_t baseline = arena.Used();
+
+    {
+        WPEFramework::Utils::RequestArena::Scope outer;
+        EXPECT_EQ("org.rdk.method", arena.ToLower("Org.RDK.Method"));
+        {
+            WPEFramework::Utils::RequestArena::Scope inner;
+            std::string& params = arena.String();
+            EXPECT_TRUE(params.empty());
+            params = "{\"value\":true}";
+            EXPECT_EQ(baseline + 2, arena.Used());
+        }
+        // Inner scope released only its own slot
+        EXPECT_EQ(baseline + 1, arena.Used());
+    }
+    EXPECT_EQ(baseline, arena.Used());
+
+    // Repeated requests reuse the slots already allocated
+    const size_t slots = arena.Slots();
+    for (int i = 0; i < 100; ++i) {
+        WPEFramework::Utils::RequestArena::Scope scope;
+        arena.ToLower("Device.Name");
+        arena.String() = "{}";
+    }
+    EXPECT_EQ(slots, arena.Slots());
+}
+
+TEST(AppGatewayPluginTest, PendingRequestTable_CompleteAndExpire)
+{
+    WPEFramework::Utils::PendingRequestTable table(100, 8);
+    typedef WPEFramework::Utils::PendingRequestTable::Entry Entry;
+    auto noop = [](const Entry&, const Core::hresult, const std::string&) {};
+
+    EXPECT_EQ(Core::ERROR_NONE, table.Add(1, 10, "keyboard.standard", 500, 1000, noop));
+    EXPECT_EQ(Core::ERROR_NONE, table.Add(1, 11, "keyboard.password", 2000, 1000, noop));
+    EXPECT_EQ(Core::ERROR_DUPLICATE_KEY, table.Add(1, 10, "keyboard.standard", 500, 1000, noop));
+    // Same request id on another connection is a different request
+    EXPECT_EQ(Core::ERROR_NONE, table.Add(2, 10, "keyboard.standard", 500, 1000, noop));
+    EXPECT_EQ(3u, table.Size());
+
+    Entry entry;
+    EXPECT_TRUE(table.Complete(2, 10, entry));
+    EXPECT_EQ(2u, entry.connectionId);
+    EXPECT_EQ("keyboard.standard", entry.method);
+    EXPECT_FALSE(table.Complete(2, 10, entry));
+
+    std::vector<Entry> expired;
+    table.Expire(1400, expired);
+    EXPECT_TRUE(expired.empty());
+    table.Expire(1600, expired);
+    ASSERT_EQ(1u, expired.size());
+    EXPECT_EQ(10u, expired[0].requestId);
+
+    // Longer than one wheel revolution (8 x 100ms) is still honoured
+    expired.clear();
+    table.Expire(2900, expired);
+    EXPECT_TRUE(expired.empty());
+    table.Expire(3100, expired);
+    ASSERT_EQ(1u, expired.size());
+    EXPECT_EQ(11u, expired[0].requestId);
+    EXPECT_EQ(0u, table.Size());
+}
+
+TEST(AppGatewayPluginTest, PendingRequestTable_RemoveConnection_OnlyTouchesThatConnection)
+{
+    WPEFramework::Utils::PendingRequestTable table(100, 8);
+    typedef WPEFramework::Utils::PendingRequestTable::Entry Entry;
+    auto noop = [](const Entry&, const Core::hresult, const std::string&) {};
+
+    for (uint32_t id = 1; id <= 5; ++id) {
+        EXPECT_EQ(Core::ERROR_NONE, table.Add(7, id, "discovery.userInterest", 1000, 0, noop));
+    }
+    EXPECT_EQ(Core::ERROR_NONE, table.Add(8, 1, "discovery.userInterest", 1000, 0, noop));
+    EXPECT_EQ(5u, table.Size(7));
+
+    std::vector<Entry> removed;
+    table.RemoveConnection(7, removed);
+    EXPECT_EQ(5u, removed.size());
+    EXPECT_EQ(0u, table.Size(7));
+    EXPECT_EQ(1u, table.Size());
+
+    // Stale wheel slots of removed entries are skipped on expiry
+    std::vector<Entry> expired;
+    table.Expire(1200, expired);
+    ASSERT_EQ(1u, expired.size());
+    EXPECT_EQ(8u, expired[0].connectionId);
+}
+
+TEST(AppGatewayPluginTest, AppGatewayResponderImplementation_Request_TimesOutWithStructuredError)
+{
+    TestAppGatewayResponderImplementation responder;
+    std::mutex lock;
+    std::condition_variable signal;
+    bool done = false;
+    Core::hresult outcome = Core::ERROR_NONE;
+    std::string payload;
+
+    EXPECT_EQ(Core::ERROR_NONE, responder.Request(42, 900, "keyboard.standard", "{}", 50,
+        [&](const WPEFramework::Utils::PendingRequestTable::Entry&, const Core::hresult result, const std::string& error) {
+            std::lock_guard<std::mutex> guard(lock);
+            outcome = result;
+            payload = error;
+            done = true;
+            signal.notify_one();
+        }));
+    EXPECT_EQ(Core::ERROR_DUPLICATE_KEY, responder.Request(42, 900, "keyboard.standard", "{}"));
+
+    std::unique_lock<std::mutex> guard(lock);
+    ASSERT_TRUE(signal.wait_for(guard, std::chrono::seconds(2), [&]() { return done; }));
+    EXPECT_EQ(Core::ERROR_TIMEDOUT, outcome);
+    EXPECT_NE(std::string::npos, payload.find("App did not respond in time"));
+    EXPECT_EQ(0u, responder.mPendingRequests.Size());
+}
+
 TEST(AppGatewayPluginTest, AppGatewayResponderImplementation_ConstructAndDestroy_NoCrash)
 {
     EXPECT_NO_THROW({
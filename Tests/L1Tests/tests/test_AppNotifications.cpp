@@ -895,6 +895,25 @@ TEST_F(AppNotificationsTest, Emitter_Emit_EmptyArguments_NocrashNoThrow)
     std::this_thread::sleep_for(std::chrono::milliseconds(60));
 }
 
+TEST_F(AppNotificationsTest, EmitJob_CreateRelease_RecyclesPooledInstances)
+{
+    typedef Plugin::AppNotificationsImplementation::EmitJob EmitJob;
+
+    // Warm the pool once, then repeated create/release cycles must not allocate new jobs.
+    {
+        Core::ProxyType<Core::IDispatch> job = EmitJob::Create(&impl, "warmup", "{}", "appA");
+    }
+    const uint32_t created = Utils::JobPool<EmitJob>::Count();
+
+    for (int i = 0; i < 1000; ++i) {
+        Core::ProxyType<Core::IDispatch> job = EmitJob::Create(&impl, "evt", "{\"i\":1}", "appA");
+        EXPECT_TRUE(job.IsValid());
+    }
+
+    EXPECT_EQ(created, Utils::JobPool<EmitJob>::Count());
+    EXPECT_GE(Utils::JobPool<EmitJob>::CurrentQueueSize(), 1u);
+}
+
 // ===========================================================================
 // End-to-end scenario: Subscribe → Emit → Cleanup
 // ===========================================================================
@@ -2611,15 +2630,95 @@ TEST_F(AppNotificationsTest, Cleanup_LargeNumberOfEventsAndConnections_AllCleare
 // SubscriberMap Add duplicate context to same key
 // ===========================================================================
 
-TEST_F(AppNotificationsTest, SubscriberMap_Add_DuplicateContext_BothStored)
+TEST_F(AppNotificationsTest, SubscriberMap_Add_DuplicateContext_StoredOnce)
 {
-    // Adding the exact same context twice should result in two entries.
+    // Adding the exact same context twice keeps a single entry.
     auto ctx = MakeContext(1, 100, "dupApp", APP_GATEWAY_CALLSIGN);
-    impl.mSubMap.Add("dupAddKey", ctx);
-    impl.mSubMap.Add("dupAddKey", ctx);
+    EXPECT_EQ(Core::ERROR_NONE, impl.mSubMap.Add("dupAddKey", ctx));
+    EXPECT_EQ(Core::ERROR_DUPLICATE_KEY, impl.mSubMap.Add("dupAddKey", ctx));
 
     auto subs = impl.mSubMap.Get("dupaddkey");
-    EXPECT_EQ(2u, subs.size());
+    EXPECT_EQ(1u, subs.size());
+    EXPECT_EQ(1u, impl.mSubMap.SubscriptionCount(100, APP_GATEWAY_CALLSIGN));
+}
+
+TEST_F(AppNotificationsTest, SubscriberMap_Add_SameConnectionNewRequest_RefreshesContext)
+{
+    // A second listen from the same connection and origin replaces the stored context.
+    auto ctx1 = MakeContext(1, 100, "dupApp", APP_GATEWAY_CALLSIGN, "0");
+    auto ctx2 = MakeContext(2, 100, "dupApp", APP_GATEWAY_CALLSIGN, "8");
+    impl.mSubMap.Add("refreshKey", ctx1);
+    EXPECT_EQ(Core::ERROR_DUPLICATE_KEY, impl.mSubMap.Add("refreshKey", ctx2));
+
+    auto subs = impl.mSubMap.Get("refreshkey");
+    ASSERT_EQ(1u, subs.size());
+    EXPECT_EQ(2u, subs[0].requestId);
+    EXPECT_EQ("8", subs[0].version);
+}
+
+TEST_F(AppNotificationsTest, SubscriberMap_EventUpdate_CachesDerivedEventNames)
+{
+    auto ctx = MakeContext(1, 100, "app1", APP_GATEWAY_CALLSIGN);
+    impl.mSubMap.Add("Device.onNameChanged.v8", ctx);
+
+    impl.mSubMap.EventUpdate("Device.onNameChanged.v8", "{}", "");
+    impl.mSubMap.EventUpdate("Device.onNameChanged.v8", "{}", "");
+
+    ASSERT_EQ(1u, impl.mSubMap.mEventNames.size());
+    const auto& names = impl.mSubMap.mEventNames.begin()->second;
+    EXPECT_EQ("device.onnamechanged.v8", names.lowerKey);
+    EXPECT_EQ("Device.onNameChanged", names.dispatchName);
+}
+
+TEST_F(AppNotificationsTest, SubscriberMap_Remove_DifferentRequestId_RemovesSubscription)
+{
+    // Unsubscribe arrives with a new requestId; it must still match the subscription.
+    auto ctx = MakeContext(1, 100, "app1", APP_GATEWAY_CALLSIGN);
+    auto unlisten = MakeContext(7, 100, "app1", APP_GATEWAY_CALLSIGN);
+    impl.mSubMap.Add("unlistenKey", ctx);
+
+    impl.mSubMap.Remove("unlistenKey", unlisten);
+
+    EXPECT_FALSE(impl.mSubMap.Exists("unlistenkey"));
+    EXPECT_EQ(0u, impl.mSubMap.SubscriptionCount(100, APP_GATEWAY_CALLSIGN));
+}
+
+TEST_F(AppNotificationsTest, Subscribe_DuplicateListen_CountsDuplicate)
+{
+    auto ctx = MakeContext(1, 100, "app1", APP_GATEWAY_CALLSIGN);
+    EXPECT_EQ(Core::ERROR_NONE, impl.Subscribe(ctx, true, "org.rdk.Plugin", "dupListenEvent"));
+    EXPECT_EQ(Core::ERROR_NONE, impl.Subscribe(ctx, true, "org.rdk.Plugin", "dupListenEvent"));
+
+    EXPECT_EQ(1u, impl.mSubMap.Get("duplistenevent").size());
+    EXPECT_EQ(1u, impl.mDuplicateSubscriptions.load());
+}
+
+TEST_F(AppNotificationsTest, Subscribe_OverQuota_ReturnsInvalidRange)
+{
+    impl.mSubMap.SetMaxSubscriptionsPerConnection(2);
+    auto ctx = MakeContext(1, 100, "app1", APP_GATEWAY_CALLSIGN);
+    auto other = MakeContext(2, 200, "app2", APP_GATEWAY_CALLSIGN);
+
+    EXPECT_EQ(Core::ERROR_NONE, impl.Subscribe(ctx, true, "org.rdk.Plugin", "quotaA"));
+    EXPECT_EQ(Core::ERROR_NONE, impl.Subscribe(ctx, true, "org.rdk.Plugin", "quotaB"));
+    EXPECT_EQ(Core::ERROR_INVALID_RANGE, impl.Subscribe(ctx, true, "org.rdk.Plugin", "quotaC"));
+    EXPECT_FALSE(impl.mSubMap.Exists("quotac"));
+    EXPECT_EQ(1u, impl.mRejectedSubscriptions.load());
+
+    // Re-listening to an existing event is not counted against the quota.
+    EXPECT_EQ(Core::ERROR_NONE, impl.Subscribe(ctx, true, "org.rdk.Plugin", "quotaA"));
+
+    // Other connections have their own quota.
+    EXPECT_EQ(Core::ERROR_NONE, impl.Subscribe(other, true, "org.rdk.Plugin", "quotaC"));
+
+    // Freeing a slot allows a new subscription.
+    EXPECT_EQ(Core::ERROR_NONE, impl.Subscribe(ctx, false, "org.rdk.Plugin", "quotaB"));
+    EXPECT_EQ(Core::ERROR_NONE, impl.Subscribe(ctx, true, "org.rdk.Plugin", "quotaC"));
+    EXPECT_EQ(2u, impl.mSubMap.SubscriptionCount(100, APP_GATEWAY_CALLSIGN));
+
+    // Cleanup resets the quota for the connection.
+    impl.Cleanup(100, APP_GATEWAY_CALLSIGN);
+    EXPECT_EQ(0u, impl.mSubMap.SubscriptionCount(100, APP_GATEWAY_CALLSIGN));
 }
 
 // ===========================================================================
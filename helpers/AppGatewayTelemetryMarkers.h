@@ -155,6 +155,23 @@
  */
 #define AGW_MARKER_HEALTH_STATS                     "ENTS_INFO_AppGwHealth"
 
+/**
+ * @brief Binary-encoded flush batch (sent periodically when TelemetryFormat::BINARY is selected)
+ * @details Carries every aggregated marker of one reporting interval in a single dictionary-coded
+ *          batch instead of one marker per key. Large batches are split across several events.
+ * @payload "<sequence>.<part>/<parts>:<base64>"
+ * @note Expand with the agw-telemetry-decode tool, which prints the per-marker JSON payloads
+ */
+#define AGW_MARKER_TELEMETRY_BATCH                  "ENTS_INFO_AppGwTelemetryBatch"
+
+/**
+ * @brief Telemetry markers dropped before they reached T2 (sent with the next flush)
+ * @details The T2 send queue drops its oldest marker when it is full, i.e. when the T2
+ *          daemon falls behind; this reports how many were lost since the previous flush
+ * @payload { "dropped": <count>, "unit": "count" }
+ */
+#define AGW_MARKER_TELEMETRY_DROPPED                "ENTS_INFO_AppGwTelemetryDropped"
+
 /**
  * @brief LinchPin connection metric (sent periodically)
  * @details Tracks LinchPin AS connection state changes (connected events)
@@ -179,6 +196,34 @@
  */
 #define AGW_MARKER_LINCHPIN_NOTIFICATION_COUNT      "ENTS_INFO_AppGwLinchPinNotificationCount"
 
+/**
+ * @brief Duplicate subscription metric (sent periodically)
+ * @details Counts listen requests for an event the (connection, origin) was already subscribed to
+ * @payload { "sum": <duplicate_count>, "count": <occurrences>, "unit": "count", "reporting_interval_sec": 3600 }
+ * @usage AGW_REPORT_METRIC(context, AGW_MARKER_SUBSCRIPTIONS_DUPLICATE, 1.0, AGW_UNIT_COUNT)
+ */
+#define AGW_MARKER_SUBSCRIPTIONS_DUPLICATE          "ENTS_INFO_AppGwSubscriptionsDuplicate"
+
+/**
+ * @brief Rejected subscription metric (sent periodically)
+ * @details Counts listen requests rejected because the connection reached its subscription limit
+ * @payload { "sum": <rejected_count>, "count": <occurrences>, "unit": "count", "reporting_interval_sec": 3600 }
+ * @usage AGW_REPORT_METRIC(context, AGW_MARKER_SUBSCRIPTIONS_REJECTED, 1.0, AGW_UNIT_COUNT)
+ */
+#define AGW_MARKER_SUBSCRIPTIONS_REJECTED           "ENTS_INFO_AppGwSubscriptionsRejected"
+
+/**
+ * @brief App-reported metrics.* summary event (sent immediately, already aggregated)
+ * @details AppGatewayCommon aggregates metrics.* calls per app and metric and sends one
+ *          event per pair and flush interval; app and metric travel in the payload, so
+ *          apps cannot create markers. mean/max/p50/p95 are present when the calls
+ *          carried a numeric progress/position/duration/value field
+ * @payload { "app_id": "<appId>", "metric": "<metric>", "count": <calls>, "mean": <value>,
+ *            "max": <value>, "p50": <value>, "p95": <value>, "dropped": <calls_not_aggregated> }
+ * @usage AGW_REPORT_EVENT(context, AGW_MARKER_APP_METRIC, payload)
+ */
+#define AGW_MARKER_APP_METRIC                       "ENTS_INFO_AppGwAppMetric"
+
 /**
  * @brief API error count metric prefix
  * @details Per-API error count metrics sent periodically
@@ -22,6 +22,7 @@
 #include <interfaces/IAppNotifications.h>
 #include "UtilsLogging.h"
 #include "UtilsCallsign.h"
+#include "UtilsJobPool.h"
 #include <mutex>
 #include <map>
 #include <unordered_set>
@@ -34,10 +35,9 @@ public:
     class EXTERNAL EventDelegateDispatchJob : public Core::IDispatch
     {
     public:
-        EventDelegateDispatchJob(BaseEventDelegate *delegate, const string &event, const string &payload, string appId = "")
-            : mDelegate(*delegate), mEvent(event), mPayload(payload), mAppId(appId) {}
+        EventDelegateDispatchJob()
+            : mDelegate(nullptr), mEvent(), mPayload(), mAppId() {}
 
-        EventDelegateDispatchJob() = delete;
         EventDelegateDispatchJob(const EventDelegateDispatchJob &) = delete;
         EventDelegateDispatchJob &operator=(const EventDelegateDispatchJob &) = delete;
         ~EventDelegateDispatchJob()
@@ -47,16 +47,30 @@ public:
         static Core::ProxyType<Core::IDispatch> Create(BaseEventDelegate *parent,
                                                        const string &event, const string &payload, string appId = "")
         {
-            return (Core::ProxyType<Core::IDispatch>(Core::ProxyType<EventDelegateDispatchJob>::Create(parent, event, payload, appId)));
+            Core::ProxyType<EventDelegateDispatchJob> job = Utils::JobPool<EventDelegateDispatchJob>::Element();
+            job->mDelegate = parent;
+            job->mEvent = event;
+            job->mPayload = payload;
+            job->mAppId = appId;
+            return (Core::ProxyType<Core::IDispatch>(job));
         }
 
         virtual void Dispatch()
         {
-            mDelegate.DispatchToAppNotifications(mEvent, mPayload, mAppId);
+            mDelegate->DispatchToAppNotifications(mEvent, mPayload, mAppId);
+        }
+
+        // Invoked by the job pool on recycle
+        void Clear()
+        {
+            mDelegate = nullptr;
+            mEvent.clear();
+            mPayload.clear();
+            mAppId.clear();
         }
 
     private:
-        BaseEventDelegate &mDelegate;
+        BaseEventDelegate *mDelegate;
         string mEvent;
         string mPayload;
         string mAppId;
@@ -79,8 +79,13 @@ class ContextUtils {
             return baseEventName + RDK8_SUFFIX;
         }
 
+        static bool IsRDK8VersionedEventName(const string& eventName) {
+            return eventName.size() > RDK8_SUFFIX_LENGTH &&
+                eventName.compare(eventName.size() - RDK8_SUFFIX_LENGTH, RDK8_SUFFIX_LENGTH, RDK8_SUFFIX) == 0;
+        }
+
         static string GetBaseEventNameFromVersionedEvent(const string& versionedEventName) {
-            if (versionedEventName.size() > RDK8_SUFFIX_LENGTH && RDK8_SUFFIX == versionedEventName.substr(versionedEventName.size() - RDK8_SUFFIX_LENGTH)) {
+            if (IsRDK8VersionedEventName(versionedEventName)) {
                 return versionedEventName.substr(0, versionedEventName.size() - RDK8_SUFFIX_LENGTH);
             }
             return versionedEventName;
@@ -0,0 +1,481 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+#pragma once
+
+#include <core/JSON.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace WPEFramework
+{
+    namespace Utils
+    {
+        // Per-method parameter check compiled from the "params" schema of a resolution:
+        //
+        //   "params": {
+        //     "value":  { "type": "string", "required": true, "enum": ["a", "b"] },
+        //     "volume": { "type": "integer", "min": 0, "max": 100 }
+        //   }
+        //
+        // Compile() flattens the schema into a sorted rule table once at load time.
+        // Validate() then makes a single pass over the raw params text, checking each
+        // top-level member against its rule as it is scanned; no JSON container is
+        // built. Members without a rule are accepted and skipped.
+        class ParamValidator
+        {
+        public:
+            enum : uint32_t {
+                TypeAny = 0,
+                TypeString = 1 << 0,
+                TypeNumber = 1 << 1,
+                TypeInteger = 1 << 2,
+                TypeBoolean = 1 << 3,
+                TypeObject = 1 << 4,
+                TypeArray = 1 << 5,
+                TypeNull = 1 << 6
+            };
+
+            ParamValidator()
+                : mRules()
+                , mRequiredMask(0)
+                , mSchema()
+            {
+            }
+
+            // Builds the rule table; false with a description in error if the schema is unusable
+            bool Compile(const Core::JSON::VariantContainer& schema, std::string& error)
+            {
+                mRules.clear();
+                mRequiredMask = 0;
+                schema.ToString(mSchema);
+
+                Core::JSON::VariantContainer::Iterator it = schema.Variants();
+                while (it.Next()) {
+                    const Core::JSON::Variant& spec = it.Current();
+                    if (spec.Content() != Core::JSON::Variant::type::OBJECT) {
+                        error = std::string("schema for '") + it.Label() + "' is not an object";
+                        return false;
+                    }
+                    Core::JSON::VariantContainer fields = spec.Object();
+
+                    Rule rule;
+                    rule.name = it.Label();
+                    if (fields.HasLabel("type")) {
+                        const Core::JSON::Variant& type = fields["type"];
+                        rule.type = (type.Content() == Core::JSON::Variant::type::STRING) ? TypeFromName(type.String()) : static_cast<uint32_t>(~0u);
+                        if (rule.type == static_cast<uint32_t>(~0u)) {
+                            error = std::string("unknown type for '") + rule.name + "'";
+                            return false;
+                        }
+                    }
+                    rule.required = fields.HasLabel("required") && fields["required"].Content() == Core::JSON::Variant::type::BOOLEAN && fields["required"].Boolean();
+                    rule.hasMin = ExtractNumber(fields, "min", rule.min);
+                    rule.hasMax = ExtractNumber(fields, "max", rule.max);
+                    if (fields.HasLabel("enum")) {
+                        if (fields["enum"].Content() != Core::JSON::Variant::type::ARRAY) {
+                            error = std::string("enum for '") + rule.name + "' is not an array";
+                            return false;
+                        }
+                        Core::JSON::ArrayType<Core::JSON::Variant> values = fields["enum"].Array();
+                        Core::JSON::ArrayType<Core::JSON::Variant>::Iterator value = values.Elements();
+                        while (value.Next()) {
+                            if (value.Current().Content() != Core::JSON::Variant::type::STRING) {
+                                error = std::string("enum for '") + rule.name + "' must only hold strings";
+                                return false;
+                            }
+                            rule.enumValues.push_back(value.Current().String());
+                        }
+                    }
+                    mRules.push_back(std::move(rule));
+                }
+
+                std::sort(mRules.begin(), mRules.end(), [](const Rule& a, const Rule& b) { return a.name < b.name; });
+                uint32_t requiredCount = 0;
+                for (size_t index = 0; index < mRules.size(); ++index) {
+                    if (index > 0 && mRules[index].name == mRules[index - 1].name) {
+                        error = std::string("duplicate rule for '") + mRules[index].name + "'";
+                        return false;
+                    }
+                    if (mRules[index].required) {
+                        if (requiredCount == 64) {
+                            error = "more than 64 required parameters";
+                            return false;
+                        }
+                        mRules[index].requiredBit = 1ULL << requiredCount++;
+                        mRequiredMask |= mRules[index].requiredBit;
+                    }
+                }
+                return true;
+            }
+
+            // One pass over params; false with a client-facing message if they do not match
+            bool Validate(const std::string& params, std::string& message) const
+            {
+                size_t pos = SkipSpace(params, 0);
+                if (pos == params.size()
+                    || (params.compare(pos, 4, "null") == 0 && SkipSpace(params, pos + 4) == params.size())) {
+                    // No params at all is only acceptable when nothing is required
+                    return CheckRequired(0, message);
+                }
+                if (params[pos] != '{') {
+                    message = "Params must be an object";
+                    return false;
+                }
+
+                uint64_t seen = 0;
+                std::string key;
+                pos = SkipSpace(params, pos + 1);
+                if (pos < params.size() && params[pos] == '}') {
+                    return AtEnd(params, pos + 1, message) && CheckRequired(seen, message);
+                }
+                while (pos < params.size()) {
+                    if (params[pos] != '"' || !ReadString(params, pos, key)) {
+                        message = "Malformed params";
+                        return false;
+                    }
+                    pos = SkipSpace(params, pos);
+                    if (pos >= params.size() || params[pos] != ':') {
+                        message = "Malformed params";
+                        return false;
+                    }
+                    pos = SkipSpace(params, pos + 1);
+
+                    const size_t start = pos;
+                    if (!SkipValue(params, pos)) {
+                        message = "Malformed params";
+                        return false;
+                    }
+                    const Rule* rule = Find(key);
+                    if (rule != nullptr) {
+                        if (!CheckValue(*rule, params, start, pos, message)) {
+                            return false;
+                        }
+                        seen |= rule->requiredBit;
+                    }
+
+                    pos = SkipSpace(params, pos);
+                    if (pos < params.size() && params[pos] == ',') {
+                        pos = SkipSpace(params, pos + 1);
+                        continue;
+                    }
+                    if (pos < params.size() && params[pos] == '}') {
+                        return AtEnd(params, pos + 1, message) && CheckRequired(seen, message);
+                    }
+                    break;
+                }
+                message = "Malformed params";
+                return false;
+            }
+
+            bool IsEmpty() const
+            {
+                return mRules.empty();
+            }
+
+            // The schema text this validator was compiled from
+            const std::string& Schema() const
+            {
+                return mSchema;
+            }
+
+        private:
+            struct Rule
+            {
+                Rule()
+                    : name(), type(TypeAny), required(false), requiredBit(0)
+                    , hasMin(false), hasMax(false), min(0.0), max(0.0), enumValues()
+                {
+                }
+
+                std::string name;
+                uint32_t type;
+                bool required;
+                uint64_t requiredBit;
+                bool hasMin;
+                bool hasMax;
+                double min;
+                double max;
+                std::vector<std::string> enumValues;
+            };
+
+            static uint32_t TypeFromName(const std::string& name)
+            {
+                if (name == "string") return TypeString;
+                // An integer is also a number, so "number" accepts both
+                if (name == "number") return TypeNumber | TypeInteger;
+                if (name == "integer") return TypeInteger;
+                if (name == "boolean") return TypeBoolean;
+                if (name == "object") return TypeObject;
+                if (name == "array") return TypeArray;
+                if (name == "null") return TypeNull;
+                return static_cast<uint32_t>(~0u);
+            }
+
+            static const char* TypeName(const uint32_t type)
+            {
+                switch (type) {
+                case TypeString: return "a string";
+                case TypeInteger: return "an integer";
+                case TypeBoolean: return "a boolean";
+                case TypeObject: return "an object";
+                case TypeArray: return "an array";
+                case TypeNull: return "null";
+                default: return "a number";
+                }
+            }
+
+            static bool ExtractNumber(Core::JSON::VariantContainer& fields, const char* name, double& value)
+            {
+                if (!fields.HasLabel(name)) {
+                    return false;
+                }
+                const Core::JSON::Variant& field = fields[name];
+                if (field.Content() == Core::JSON::Variant::type::NUMBER) {
+                    value = static_cast<double>(field.Number());
+                    return true;
+                }
+                if (field.Content() == Core::JSON::Variant::type::FLOAT) {
+                    value = field.Float();
+                    return true;
+                }
+                return false;
+            }
+
+            const Rule* Find(const std::string& name) const
+            {
+                auto it = std::lower_bound(mRules.begin(), mRules.end(), name,
+                    [](const Rule& rule, const std::string& value) { return rule.name < value; });
+                return (it != mRules.end() && it->name == name) ? &(*it) : nullptr;
+            }
+
+            // Nothing but whitespace may follow the params object
+            static bool AtEnd(const std::string& params, const size_t pos, std::string& message)
+            {
+                if (SkipSpace(params, pos) != params.size()) {
+                    message = "Malformed params";
+                    return false;
+                }
+                return true;
+            }
+
+            bool CheckRequired(const uint64_t seen, std::string& message) const
+            {
+                const uint64_t missing = mRequiredMask & ~seen;
+                if (missing == 0) {
+                    return true;
+                }
+                for (const Rule& rule : mRules) {
+                    if ((rule.requiredBit & missing) != 0) {
+                        message = "Missing required parameter '" + rule.name + "'";
+                        break;
+                    }
+                }
+                return false;
+            }
+
+            bool CheckValue(const Rule& rule, const std::string& params, const size_t start, const size_t end, std::string& message) const
+            {
+                uint32_t type = TypeNumber;
+                switch (params[start]) {
+                case '"': type = TypeString; break;
+                case '{': type = TypeObject; break;
+                case '[': type = TypeArray; break;
+                case 't':
+                case 'f': type = TypeBoolean; break;
+                case 'n': type = TypeNull; break;
+                default:
+                    if (params.find_first_of(".eE", start) >= end) {
+                        type = TypeInteger;
+                    }
+                    break;
+                }
+
+                if (rule.type != TypeAny && (rule.type & type) == 0) {
+                    const uint32_t expected = (rule.type == (TypeNumber | TypeInteger)) ? static_cast<uint32_t>(TypeNumber) : rule.type;
+                    message = "Parameter '" + rule.name + "' must be " + TypeName(expected);
+                    return false;
+                }
+                if ((type == TypeNumber || type == TypeInteger) && (rule.hasMin || rule.hasMax)) {
+                    // SkipValue() checked the whole [start, end) is one JSON number, so
+                    // strtod() stops exactly at end
+                    const double value = std::strtod(params.c_str() + start, nullptr);
+                    if ((rule.hasMin && value < rule.min) || (rule.hasMax && value > rule.max)) {
+                        message = "Parameter '" + rule.name + "' is out of range";
+                        return false;
+                    }
+                }
+                if (type == TypeString && !rule.enumValues.empty()) {
+                    std::string value;
+                    size_t pos = start;
+                    ReadString(params, pos, value);
+                    if (std::find(rule.enumValues.begin(), rule.enumValues.end(), value) == rule.enumValues.end()) {
+                        message = "Parameter '" + rule.name + "' has an unsupported value";
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            static size_t SkipSpace(const std::string& text, size_t pos)
+            {
+                while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) {
+                    ++pos;
+                }
+                return pos;
+            }
+
+            // Reads the string starting at text[pos] == '"', decoding the simple escapes;
+            // pos is left after the closing quote
+            static bool ReadString(const std::string& text, size_t& pos, std::string& value)
+            {
+                value.clear();
+                for (++pos; pos < text.size(); ++pos) {
+                    const char c = text[pos];
+                    if (c == '"') {
+                        ++pos;
+                        return true;
+                    }
+                    if (c != '\\') {
+                        value.push_back(c);
+                        continue;
+                    }
+                    if (++pos >= text.size()) {
+                        return false;
+                    }
+                    switch (text[pos]) {
+                    case 'n': value.push_back('\n'); break;
+                    case 't': value.push_back('\t'); break;
+                    case 'r': value.push_back('\r'); break;
+                    case 'b': value.push_back('\b'); break;
+                    case 'f': value.push_back('\f'); break;
+                    case 'u':
+                        // Kept verbatim; only matters for enum values outside ASCII
+                        value.push_back('\\');
+                        value.push_back('u');
+                        break;
+                    default: value.push_back(text[pos]); break;
+                    }
+                }
+                return false;
+            }
+
+            // Moves pos past the value starting at text[pos]
+            static bool SkipValue(const std::string& text, size_t& pos)
+            {
+                if (pos >= text.size()) {
+                    return false;
+                }
+                const char first = text[pos];
+                if (first == '"') {
+                    for (++pos; pos < text.size(); ++pos) {
+                        if (text[pos] == '\\') {
+                            ++pos;
+                        } else if (text[pos] == '"') {
+                            ++pos;
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+                if (first == '{' || first == '[') {
+                    // Closing brackets still expected, innermost last
+                    std::string expected;
+                    for (; pos < text.size(); ++pos) {
+                        const char c = text[pos];
+                        if (c == '"') {
+                            if (!SkipValue(text, pos)) {
+                                return false;
+                            }
+                            --pos;
+                        } else if (c == '{' || c == '[') {
+                            expected.push_back(c == '{' ? '}' : ']');
+                        } else if (c == '}' || c == ']') {
+                            if (c != expected.back()) {
+                                return false;
+                            }
+                            expected.pop_back();
+                            if (expected.empty()) {
+                                ++pos;
+                                return true;
+                            }
+                        }
+                    }
+                    return false;
+                }
+                const size_t start = pos;
+                while (pos < text.size() && text[pos] != ',' && text[pos] != '}' && text[pos] != ']'
+                       && text[pos] != ' ' && text[pos] != '\t' && text[pos] != '\n' && text[pos] != '\r') {
+                    ++pos;
+                }
+                if (pos == start) {
+                    return false;
+                }
+                const char c = text[start];
+                if (c == 't') return text.compare(start, pos - start, "true") == 0;
+                if (c == 'f') return text.compare(start, pos - start, "false") == 0;
+                if (c == 'n') return text.compare(start, pos - start, "null") == 0;
+                return IsNumber(text, start, pos);
+            }
+
+            // JSON number grammar: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+            static bool IsNumber(const std::string& text, size_t pos, const size_t end)
+            {
+                auto digits = [&text, &pos, end]() {
+                    const size_t start = pos;
+                    while (pos < end && text[pos] >= '0' && text[pos] <= '9') {
+                        ++pos;
+                    }
+                    return pos - start;
+                };
+                if (pos < end && text[pos] == '-') {
+                    ++pos;
+                }
+                // At least one digit, and no leading zeros
+                if (pos < end && text[pos] == '0') {
+                    ++pos;
+                } else if (digits() == 0) {
+                    return false;
+                }
+                if (pos < end && text[pos] == '.') {
+                    ++pos;
+                    if (digits() == 0) {
+                        return false;
+                    }
+                }
+                if (pos < end && (text[pos] == 'e' || text[pos] == 'E')) {
+                    ++pos;
+                    if (pos < end && (text[pos] == '+' || text[pos] == '-')) {
+                        ++pos;
+                    }
+                    if (digits() == 0) {
+                        return false;
+                    }
+                }
+                return pos == end;
+            }
+
+            std::vector<Rule> mRules;
+            uint64_t mRequiredMask;
+            std::string mSchema;
+        };
+    } // namespace Utils
+} // namespace WPEFramework
@@ -0,0 +1,222 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+#pragma once
+
+#include <core/core.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace WPEFramework
+{
+    namespace Utils
+    {
+        // Outstanding gateway-to-app requests, indexed by (connectionId, requestId) and
+        // by connection. Deadlines are kept in a single timer wheel: Expire() only walks
+        // the slots whose tick has passed, and a disconnect touches just the entries of
+        // that connection. Entries are handed back to the caller, which runs the
+        // completion callback outside the table lock.
+        class PendingRequestTable
+        {
+        public:
+            struct Entry;
+            typedef std::function<void(const Entry& entry, const Core::hresult result, const std::string& payload)> Callback;
+
+            struct Entry
+            {
+                uint32_t connectionId;
+                uint32_t requestId;
+                std::string method;
+                uint64_t deadline;
+                uint64_t sequence;
+                Callback callback;
+            };
+
+            PendingRequestTable(const uint32_t tickMs, const uint32_t slots)
+                : mMutex()
+                , mEntries()
+                , mByConnection()
+                , mWheel(slots == 0 ? 1 : slots)
+                , mTickMs(tickMs == 0 ? 1 : tickMs)
+                , mCurrentTick(0)
+                , mSequence(0)
+                , mStarted(false)
+            {
+            }
+
+            PendingRequestTable(const PendingRequestTable&) = delete;
+            PendingRequestTable& operator=(const PendingRequestTable&) = delete;
+
+            Core::hresult Add(const uint32_t connectionId, const uint32_t requestId, const std::string& method,
+                              const uint32_t timeoutMs, const uint64_t nowMs, const Callback& callback)
+            {
+                const uint64_t key = Key(connectionId, requestId);
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (mEntries.find(key) != mEntries.end()) {
+                    return Core::ERROR_DUPLICATE_KEY;
+                }
+                if (!mStarted) {
+                    mCurrentTick = nowMs / mTickMs;
+                    mStarted = true;
+                }
+
+                Entry entry;
+                entry.connectionId = connectionId;
+                entry.requestId = requestId;
+                entry.method = method;
+                entry.deadline = nowMs + timeoutMs;
+                entry.sequence = ++mSequence;
+                entry.callback = callback;
+
+                // First tick that starts after the deadline, so the entry is due once its
+                // slot is walked; never a slot that has already been walked this round
+                uint64_t tick = (entry.deadline / mTickMs) + 1;
+                if (tick <= mCurrentTick) {
+                    tick = mCurrentTick + 1;
+                }
+                mWheel[tick % mWheel.size()].push_back(Slot{ key, entry.sequence });
+                mByConnection[connectionId].insert(requestId);
+                mEntries.emplace(key, std::move(entry));
+                return Core::ERROR_NONE;
+            }
+
+            // Removes the entry answered by the app; false if it already completed or timed out
+            bool Complete(const uint32_t connectionId, const uint32_t requestId, Entry& entry)
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                auto it = mEntries.find(Key(connectionId, requestId));
+                if (it == mEntries.end()) {
+                    return false;
+                }
+                entry = std::move(it->second);
+                Erase(it);
+                return true;
+            }
+
+            // O(k) in the number of requests outstanding on the connection
+            void RemoveConnection(const uint32_t connectionId, std::vector<Entry>& removed)
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                auto conn = mByConnection.find(connectionId);
+                if (conn == mByConnection.end()) {
+                    return;
+                }
+                for (const uint32_t requestId : conn->second) {
+                    auto it = mEntries.find(Key(connectionId, requestId));
+                    if (it != mEntries.end()) {
+                        removed.push_back(std::move(it->second));
+                        mEntries.erase(it);
+                    }
+                }
+                mByConnection.erase(conn);
+                // Wheel slots referencing these entries are dropped lazily on expiry
+            }
+
+            // Advances the wheel to nowMs and collects every entry whose deadline has passed
+            void Expire(const uint64_t nowMs, std::vector<Entry>& expired)
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (!mStarted) {
+                    return;
+                }
+                const uint64_t target = nowMs / mTickMs;
+                if (target <= mCurrentTick) {
+                    return;
+                }
+                // A jump longer than one revolution only needs each slot walked once
+                const uint64_t steps = std::min<uint64_t>(target - mCurrentTick, mWheel.size());
+                for (uint64_t step = 1; step <= steps; ++step) {
+                    ExpireSlot(mWheel[(mCurrentTick + step) % mWheel.size()], nowMs, expired);
+                }
+                mCurrentTick = target;
+            }
+
+            size_t Size() const
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                return mEntries.size();
+            }
+
+            size_t Size(const uint32_t connectionId) const
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                auto conn = mByConnection.find(connectionId);
+                return (conn != mByConnection.end()) ? conn->second.size() : 0;
+            }
+
+        private:
+            struct Slot
+            {
+                uint64_t key;
+                uint64_t sequence;
+            };
+
+            static uint64_t Key(const uint32_t connectionId, const uint32_t requestId)
+            {
+                return (static_cast<uint64_t>(connectionId) << 32) | requestId;
+            }
+
+            void Erase(std::unordered_map<uint64_t, Entry>::iterator it)
+            {
+                auto conn = mByConnection.find(static_cast<uint32_t>(it->first >> 32));
+                if (conn != mByConnection.end()) {
+                    conn->second.erase(static_cast<uint32_t>(it->first));
+                    if (conn->second.empty()) {
+                        mByConnection.erase(conn);
+                    }
+                }
+                mEntries.erase(it);
+            }
+
+            void ExpireSlot(std::vector<Slot>& slot, const uint64_t nowMs, std::vector<Entry>& expired)
+            {
+                size_t kept = 0;
+                for (size_t index = 0; index < slot.size(); ++index) {
+                    auto it = mEntries.find(slot[index].key);
+                    if (it == mEntries.end() || it->second.sequence != slot[index].sequence) {
+                        // Completed, removed or re-added since it was filed here
+                        continue;
+                    }
+                    if (it->second.deadline <= nowMs) {
+                        expired.push_back(std::move(it->second));
+                        Erase(it);
+                    } else {
+                        // Due in a later revolution of the wheel
+                        slot[kept++] = slot[index];
+                    }
+                }
+                slot.resize(kept);
+            }
+
+            mutable std::mutex mMutex;
+            std::unordered_map<uint64_t, Entry> mEntries;
+            std::unordered_map<uint32_t, std::unordered_set<uint32_t>> mByConnection;
+            std::vector<std::vector<Slot>> mWheel;
+            const uint32_t mTickMs;
+            uint64_t mCurrentTick;
+            uint64_t mSequence;
+            bool mStarted;
+        };
+    } // namespace Utils
+} // namespace WPEFramework
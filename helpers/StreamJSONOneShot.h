@@ -4,6 +4,8 @@
 //  which can lead to infinite loops if the data is malformed. This variant only attempts to parse the data once per call.
 //  - Parses incoming buffer in a single call, instead of looping.
 //  - Public API mirrors the original StreamJSONType.
+//  - Preformatted messages can be queued next to JSON elements; their bytes are
+//    streamed to the link as they are, one send buffer fill at a time.
 
 #pragma once
 
@@ -11,9 +13,68 @@
 #include <core/core.h>
 #include <plugins/plugins.h>
 
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <memory>
+
 namespace WPEFramework {
 namespace Core {
 
+    // A message that is already text on the wire: a small envelope around a shared
+    // payload. The payload is not copied into a JSON element, serialized again or
+    // held twice; the link pulls it in send buffer sized pieces.
+    class PreformattedMessage {
+    public:
+        PreformattedMessage() = delete;
+        PreformattedMessage(const PreformattedMessage&) = delete;
+        PreformattedMessage& operator=(const PreformattedMessage&) = delete;
+
+        PreformattedMessage(string&& prefix, const std::shared_ptr<const string>& payload, string&& suffix)
+            : _prefix(std::move(prefix))
+            , _payload(payload)
+            , _suffix(std::move(suffix))
+        {
+            ASSERT(_payload != nullptr);
+        }
+        ~PreformattedMessage() = default;
+
+        uint32_t Length() const {
+            return static_cast<uint32_t>(_prefix.size() + _payload->size() + _suffix.size());
+        }
+
+        // Copies up to length bytes starting at offset into stream; returns the count
+        uint16_t Copy(uint8_t* stream, const uint16_t length, const uint32_t offset) const {
+            uint16_t loaded = 0;
+            uint32_t position = offset;
+            const string* parts[] = { &_prefix, _payload.get(), &_suffix };
+            for (const string* part : parts) {
+                if (position >= part->size()) {
+                    position -= static_cast<uint32_t>(part->size());
+                    continue;
+                }
+                const uint32_t available = static_cast<uint32_t>(part->size()) - position;
+                const uint16_t chunk = static_cast<uint16_t>(std::min<uint32_t>(available, length - loaded));
+                ::memcpy(stream + loaded, part->data() + position, chunk);
+                loaded += chunk;
+                position = 0;
+                if (loaded == length) {
+                    break;
+                }
+            }
+            return loaded;
+        }
+
+        string ToString() const {
+            return _prefix + *_payload + _suffix;
+        }
+
+    private:
+        const string _prefix;
+        const std::shared_ptr<const string> _payload;
+        const string _suffix;
+    };
+
     template <typename SOURCE, typename ALLOCATOR, typename INTERFACE /*= Core::JSON::IElement or IMessagePack*/>
     class StreamJSONOneShotType {
     private:
@@ -25,26 +86,34 @@ namespace Core {
             SerializerImpl(const SerializerImpl&) = delete;
             SerializerImpl& operator=(const SerializerImpl&) = delete;
 
-            SerializerImpl(ParentClass& parent, const uint8_t slotSize)
+            SerializerImpl(ParentClass& parent, const uint8_t slotSize VARIABLE_IS_NOT_USED)
                 : _parent(parent)
                 , _adminLock()
-                , _sendQueue(slotSize)
+                , _sendQueue()
                 , _offset(0)
             {
             }
 
             ~SerializerImpl() {
-                _sendQueue.Clear();
+                _sendQueue.clear();
             }
 
             bool IsIdle() const {
-                return (_sendQueue.Count() == 0);
+                return (_sendQueue.empty());
             }
 
             bool Submit(const ProxyType<INTERFACE>& entry) {
                 _adminLock.Lock();
-                _sendQueue.Add(const_cast<ProxyType<INTERFACE>&>(entry));
-                const bool trigger = (_sendQueue.Count() == 1);
+                _sendQueue.emplace_back(entry, nullptr);
+                const bool trigger = (_sendQueue.size() == 1);
+                _adminLock.Unlock();
+                return trigger;
+            }
+
+            bool Submit(const std::shared_ptr<const PreformattedMessage>& entry) {
+                _adminLock.Lock();
+                _sendQueue.emplace_back(ProxyType<INTERFACE>(), entry);
+                const bool trigger = (_sendQueue.size() == 1);
                 _adminLock.Unlock();
                 return trigger;
             }
@@ -53,14 +122,27 @@ namespace Core {
                 uint16_t loaded = 0;
 
                 _adminLock.Lock();
-                if (_sendQueue.Count() > 0) {
-                    loaded = Serialize(_sendQueue[0], stream, length);
-                    // If fully sent or we’re not in a partial-send state, notify and pop
-                    if ((_offset == 0) || (loaded != length)) {
-                        Core::ProxyType<INTERFACE> current = _sendQueue[0];
-                        _parent.Send(current);
-                        _sendQueue.Remove(0);
-                        _offset = 0;
+                if (_sendQueue.empty() == false) {
+                    const Entry& head = _sendQueue.front();
+                    if (head.second != nullptr) {
+                        // Preformatted: stream the next piece. Like the JSON path below it ends
+                        // on a fill that is not full, so a message that fills its last buffer
+                        // exactly is followed by an empty fill before the next one starts
+                        loaded = head.second->Copy(stream, length, _offset);
+                        _offset += loaded;
+                        if ((_offset >= head.second->Length()) && (loaded != length)) {
+                            _sendQueue.pop_front();
+                            _offset = 0;
+                        }
+                    } else {
+                        loaded = Serialize(head.first, stream, length);
+                        // If fully sent or we’re not in a partial-send state, notify and pop
+                        if ((_offset == 0) || (loaded != length)) {
+                            Core::ProxyType<INTERFACE> current = head.first;
+                            _parent.Send(current);
+                            _sendQueue.pop_front();
+                            _offset = 0;
+                        }
                     }
                 }
                 _adminLock.Unlock();
@@ -81,9 +163,11 @@ namespace Core {
             }
 
         private:
+            typedef std::pair<ProxyType<INTERFACE>, std::shared_ptr<const PreformattedMessage>> Entry;
+
             ParentClass& _parent;
             mutable Core::CriticalSection _adminLock;
-            mutable Core::ProxyList<INTERFACE> _sendQueue;
+            mutable std::deque<Entry> _sendQueue;
             mutable uint32_t _offset;
         };
 
@@ -236,8 +320,17 @@ namespace Core {
             }
         }
 
+        inline void Submit(const std::shared_ptr<const PreformattedMessage>& message) {
+            if (_channel.IsOpen() == true) {
+                if (_serializer.Submit(message)) {
+                    _channel.Trigger();
+                }
+            }
+        }
+
         inline uint32_t Open(const uint32_t waitTime) { return _channel.Open(waitTime); }
         inline uint32_t Close(const uint32_t waitTime) { return _channel.Close(waitTime); }
+        inline uint32_t Close(const uint32_t waitTime, const uint16_t code, const string& reason) { return _channel.Close(waitTime, code, reason); }
         inline bool IsOpen() const { return _channel.IsOpen(); }
         inline bool IsClosed() const { return _channel.IsClosed(); }
         inline bool IsSuspended() const { return _channel.IsSuspended(); }
@@ -0,0 +1,120 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace WPEFramework
+{
+    namespace Utils
+    {
+        // Capabilities of the connected display (encoded EDID, size, max resolution,
+        // HDR and HDCP), kept as the exact strings the getters return. They only change
+        // on hotplug, so the record is used only while the owner is tracking hotplug
+        // events and is dropped by Invalidate() on each one. Fields fill on first use;
+        // a value fetched across an Invalidate() is refused so it cannot describe the
+        // previous display.
+        class DisplayCapabilities
+        {
+        public:
+            enum Field : uint8_t
+            {
+                EDID = 0,
+                SIZE,
+                MAX_RESOLUTION,
+                HDR,
+                HDCP,
+                FIELD_COUNT
+            };
+
+            DisplayCapabilities()
+                : mLock()
+                , mTracking(false)
+                , mGeneration(0)
+                , mValid()
+                , mValues()
+            {
+                mValid.fill(false);
+            }
+
+            DisplayCapabilities(const DisplayCapabilities&) = delete;
+            DisplayCapabilities& operator=(const DisplayCapabilities&) = delete;
+
+            // Enables the record once hotplug events are delivered; disabling drops it
+            void Track(const bool tracking)
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                if (mTracking != tracking) {
+                    mTracking = tracking;
+                    Drop();
+                }
+            }
+
+            bool Get(const Field field, std::string& value) const
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                if (!mTracking || !mValid[field]) {
+                    return false;
+                }
+                value = mValues[field];
+                return true;
+            }
+
+            // Take before fetching and pass to Store()
+            uint32_t Generation() const
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                return mGeneration;
+            }
+
+            bool Store(const Field field, const std::string& value, const uint32_t generation)
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                if (!mTracking || generation != mGeneration) {
+                    return false;
+                }
+                mValues[field] = value;
+                mValid[field] = true;
+                return true;
+            }
+
+            void Invalidate()
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                Drop();
+            }
+
+        private:
+            void Drop()
+            {
+                mValid.fill(false);
+                ++mGeneration;
+            }
+
+            mutable std::mutex mLock;
+            bool mTracking;
+            uint32_t mGeneration;
+            std::array<bool, FIELD_COUNT> mValid;
+            std::array<std::string, FIELD_COUNT> mValues;
+        };
+    } // namespace Utils
+} // namespace WPEFramework
@@ -0,0 +1,198 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace WPEFramework
+{
+    namespace Utils
+    {
+        // Counts the work a component has in flight so that shutting it down can be a
+        // drain rather than a cut: app requests taken in for resolution (keyed by
+        // connection and request ID, ended by the response or by the connection going
+        // away) and queued jobs (responses, emits, registrations).
+        //
+        // Begin() starts draining: Accept() and AdmitJob() refuse new work from then
+        // on, while AddJob() still counts follow-on work of what was already accepted
+        // (e.g. the response to an in-flight request). Wait() blocks until nothing is
+        // in flight or the timeout passes; Requests() and Jobs() report what was left.
+        class DrainTracker
+        {
+        public:
+            DrainTracker()
+                : mLock()
+                , mIdle()
+                , mDraining(false)
+                , mRequests()
+                , mRequestCount(0)
+                , mJobs(0)
+            {
+            }
+
+            DrainTracker(const DrainTracker&) = delete;
+            DrainTracker& operator=(const DrainTracker&) = delete;
+
+            // Registers a request taken in for resolution; false once draining
+            bool Accept(const uint32_t connectionId, const uint32_t requestId)
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                if (mDraining) {
+                    return false;
+                }
+                ++mRequests[Key(connectionId, requestId)];
+                ++mRequestCount;
+                return true;
+            }
+
+            // Ends a request; unknown requests (already ended, or never accepted) are ignored
+            void Complete(const uint32_t connectionId, const uint32_t requestId)
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                auto it = mRequests.find(Key(connectionId, requestId));
+                if (it == mRequests.end()) {
+                    return;
+                }
+                --mRequestCount;
+                if (--(it->second) == 0) {
+                    mRequests.erase(it);
+                }
+                NotifyIfIdle();
+            }
+
+            // Ends every request of a connection that went away
+            void CompleteConnection(const uint32_t connectionId)
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                for (auto it = mRequests.begin(); it != mRequests.end();) {
+                    if (static_cast<uint32_t>(it->first >> 32) == connectionId) {
+                        mRequestCount -= it->second;
+                        it = mRequests.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+                NotifyIfIdle();
+            }
+
+            // Counts a job that starts new work; false once draining
+            bool AdmitJob()
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                if (mDraining) {
+                    return false;
+                }
+                ++mJobs;
+                return true;
+            }
+
+            // Counts a job that finishes work already in flight, also while draining
+            void AddJob()
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                ++mJobs;
+            }
+
+            void JobDone()
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                if (mJobs > 0) {
+                    --mJobs;
+                }
+                NotifyIfIdle();
+            }
+
+            void Begin()
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                mDraining = true;
+            }
+
+            // Accepts new work again, e.g. when the component is initialized anew
+            void Resume()
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                mDraining = false;
+            }
+
+            bool IsDraining() const
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                return mDraining;
+            }
+
+            // True once nothing is in flight, false if the timeout passed first
+            bool Wait(const uint32_t timeoutMs)
+            {
+                std::unique_lock<std::mutex> lock(mLock);
+                return mIdle.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return IsIdle(); });
+            }
+
+            // Waits without a deadline, for work that must not be cut off
+            void WaitIdle()
+            {
+                std::unique_lock<std::mutex> lock(mLock);
+                mIdle.wait(lock, [this] { return IsIdle(); });
+            }
+
+            uint32_t Requests() const
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                return mRequestCount;
+            }
+
+            uint32_t Jobs() const
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                return mJobs;
+            }
+
+        private:
+            static uint64_t Key(const uint32_t connectionId, const uint32_t requestId)
+            {
+                return ((static_cast<uint64_t>(connectionId) << 32) | requestId);
+            }
+
+            bool IsIdle() const
+            {
+                return ((mRequestCount == 0) && (mJobs == 0));
+            }
+
+            // Called with mLock held; the waiter re-checks under the lock, so a
+            // notification is never missed
+            void NotifyIfIdle()
+            {
+                if (IsIdle()) {
+                    mIdle.notify_all();
+                }
+            }
+
+            mutable std::mutex mLock;
+            std::condition_variable mIdle;
+            bool mDraining;
+            std::unordered_map<uint64_t, uint32_t> mRequests;
+            uint32_t mRequestCount;
+            uint32_t mJobs;
+        };
+    } // namespace Utils
+} // namespace WPEFramework
@@ -0,0 +1,117 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <time.h>
+
+namespace WPEFramework
+{
+    namespace Utils
+    {
+        // A seconds counter that advances with a local clock (uptime, time since
+        // wakeup), sampled once from its owner and answered locally afterwards.
+        // The sample is anchored to the given clock and extrapolated; Read() stops
+        // answering once the anchor is older than the resync period, so the caller
+        // samples again and Anchor() reports how far the extrapolation had drifted.
+        // Invalidate() drops the anchor when the counter is known to jump (e.g. a
+        // power state transition); a sample taken across an Invalidate() is refused.
+        class ExtrapolatedCounter
+        {
+        public:
+            ExtrapolatedCounter(const clockid_t clock, const uint32_t resyncSec)
+                : mLock()
+                , mClock(clock)
+                , mResyncMs(static_cast<uint64_t>(resyncSec) * 1000)
+                , mValid(false)
+                , mGeneration(0)
+                , mAnchorValueMs(0)
+                , mAnchorClockMs(0)
+            {
+            }
+
+            ExtrapolatedCounter(const ExtrapolatedCounter&) = delete;
+            ExtrapolatedCounter& operator=(const ExtrapolatedCounter&) = delete;
+
+            bool Read(uint64_t& seconds) const
+            {
+                const uint64_t now = NowMs();
+                std::lock_guard<std::mutex> lock(mLock);
+                if (!mValid || now - mAnchorClockMs >= mResyncMs) {
+                    return false;
+                }
+                seconds = (mAnchorValueMs + (now - mAnchorClockMs)) / 1000;
+                return true;
+            }
+
+            // Take before sampling and pass to Anchor()
+            uint32_t Generation() const
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                return mGeneration;
+            }
+
+            // Anchors a fresh sample unless the counter was invalidated since generation
+            // was taken. drift receives sample minus extrapolation in seconds (0 when
+            // there was no anchor to compare with).
+            bool Anchor(const uint64_t seconds, const uint32_t generation, int64_t& drift)
+            {
+                const uint64_t now = NowMs();
+                std::lock_guard<std::mutex> lock(mLock);
+                drift = 0;
+                if (generation != mGeneration) {
+                    return false;
+                }
+                if (mValid) {
+                    const uint64_t extrapolated = (mAnchorValueMs + (now - mAnchorClockMs)) / 1000;
+                    drift = static_cast<int64_t>(seconds) - static_cast<int64_t>(extrapolated);
+                }
+                // The sample is whole seconds; assume it is halfway through the second
+                mAnchorValueMs = seconds * 1000 + 500;
+                mAnchorClockMs = now;
+                mValid = true;
+                return true;
+            }
+
+            void Invalidate()
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                mValid = false;
+                ++mGeneration;
+            }
+
+        private:
+            uint64_t NowMs() const
+            {
+                struct timespec ts;
+                ::clock_gettime(mClock, &ts);
+                return static_cast<uint64_t>(ts.tv_sec) * 1000 + static_cast<uint64_t>(ts.tv_nsec) / 1000000;
+            }
+
+            mutable std::mutex mLock;
+            const clockid_t mClock;
+            const uint64_t mResyncMs;
+            bool mValid;
+            uint32_t mGeneration;
+            uint64_t mAnchorValueMs;
+            uint64_t mAnchorClockMs;
+        };
+    } // namespace Utils
+} // namespace WPEFramework
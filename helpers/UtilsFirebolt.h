@@ -22,6 +22,10 @@
 
 #include <mutex>
 #include <map>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
 
 using namespace WPEFramework;
 
@@ -140,39 +144,32 @@ class ErrorUtils {
     }
 
     static std::string GetFireboltError(const FireboltError& error) {
-        std::string errorMessage;
-        Core::JSONRPC::Message::Info info;
-        switch (error) {
-            case FireboltError::NOT_SUPPORTED:
-                info.Code = ERROR_NOT_SUPPORTED;
-                info.Text = "NotSupported";
-                break;
-            case FireboltError::NOT_AVAILABLE:
-                info.Code = ERROR_NOT_AVAILABLE;
-                info.Text = "NotAvailable";
-                break;
-            case FireboltError::NOT_PERMITTED:
-                info.Code = ERROR_NOT_PERMITTED;
-                info.Text = "NotPermitted";
-                break;
-            default:
-                errorMessage = "UnknownError";
-                break;
-        }
-        info.ToString(errorMessage);
-        return errorMessage;
+        return FireboltErrorText(error);
+    }
+
+    // The fixed Firebolt errors never change; each is rendered once
+    static const std::string& FireboltErrorText(const FireboltError& error) {
+        static const std::string rendered[] = {
+            RenderFireboltError(FireboltError::NOT_SUPPORTED),
+            RenderFireboltError(FireboltError::NOT_AVAILABLE),
+            RenderFireboltError(FireboltError::NOT_PERMITTED)
+        };
+        static const size_t count = sizeof(rendered) / sizeof(rendered[0]);
+        static const std::string unknown = RenderFireboltError(static_cast<FireboltError>(count));
+        const size_t index = static_cast<size_t>(error);
+        return (index < count) ? rendered[index] : unknown;
     }
 
     static void NotSupported(string& resolution) {
-        resolution = ErrorUtils::GetFireboltError(FireboltError::NOT_SUPPORTED);
+        resolution = ErrorUtils::FireboltErrorText(FireboltError::NOT_SUPPORTED);
     }
 
     static void NotAvailable(string& resolution) {
-        resolution = ErrorUtils::GetFireboltError(FireboltError::NOT_AVAILABLE);
+        resolution = ErrorUtils::FireboltErrorText(FireboltError::NOT_AVAILABLE);
     }
 
     static void NotPermitted(string& resolution) {
-        resolution = ErrorUtils::GetFireboltError(FireboltError::NOT_PERMITTED);
+        resolution = ErrorUtils::FireboltErrorText(FireboltError::NOT_PERMITTED);
     }
 
     static void CustomInitialize(const string& message, string& resolution) {
@@ -190,7 +187,85 @@ class ErrorUtils {
     static void CustomBadMethod(const string& message, string& resolution) {
         resolution = ErrorUtils::GetErrorMessageForFrameworkErrors(Core::ERROR_INVALID_DESIGNATOR, message);
     }
-    
+
+    static void CustomTimeout(const string& message, string& resolution) {
+        resolution = ErrorUtils::GetErrorMessageForFrameworkErrors(Core::ERROR_TIMEDOUT, message);
+    }
+
+    static void CustomConnectionClosed(const string& message, string& resolution) {
+        resolution = ErrorUtils::GetErrorMessageForFrameworkErrors(Core::ERROR_CONNECTION_CLOSED, message);
+    }
+
+    private:
+    static std::string RenderFireboltError(const FireboltError& error) {
+        std::string errorMessage;
+        Core::JSONRPC::Message::Info info;
+        switch (error) {
+            case FireboltError::NOT_SUPPORTED:
+                info.Code = ERROR_NOT_SUPPORTED;
+                info.Text = "NotSupported";
+                break;
+            case FireboltError::NOT_AVAILABLE:
+                info.Code = ERROR_NOT_AVAILABLE;
+                info.Text = "NotAvailable";
+                break;
+            case FireboltError::NOT_PERMITTED:
+                info.Code = ERROR_NOT_PERMITTED;
+                info.Text = "NotPermitted";
+                break;
+            default:
+                errorMessage = "UnknownError";
+                break;
+        }
+        info.ToString(errorMessage);
+        return errorMessage;
+    }
+};
+
+// Response bodies that are constants: null/true/false results and the fixed
+// Firebolt errors. Everything after the request ID of their JSON-RPC envelope is
+// rendered once, so a responder splices in the ID instead of parsing the body and
+// serializing a message.
+class ConstantResponses {
+    public:
+    // Shared envelope tail for body, or an empty pointer if body is not a constant
+    static const std::shared_ptr<const std::string>& Tail(const std::string& body) {
+        static const Table table;
+        static const std::shared_ptr<const std::string> none;
+        if (body.size() <= table.longest) {
+            for (const auto& entry : table.entries) {
+                if (entry.first == body) {
+                    return entry.second;
+                }
+            }
+        }
+        return none;
+    }
+
+    private:
+    struct Table {
+        Table() : entries(), longest(0) {
+            Result("null");
+            Result("true");
+            Result("false");
+            Error(ErrorUtils::FireboltErrorText(FireboltError::NOT_PERMITTED));
+            Error(ErrorUtils::FireboltErrorText(FireboltError::NOT_SUPPORTED));
+            Error(ErrorUtils::FireboltErrorText(FireboltError::NOT_AVAILABLE));
+        }
+        void Result(const std::string& body) {
+            Add(body, ",\"result\":" + body + "}");
+        }
+        void Error(const std::string& body) {
+            Add(body, ",\"error\":" + body + "}");
+        }
+        void Add(const std::string& body, const std::string& tail) {
+            entries.emplace_back(body, std::make_shared<const std::string>(tail));
+            longest = std::max(longest, body.size());
+        }
+
+        std::vector<std::pair<std::string, std::shared_ptr<const std::string>>> entries;
+        size_t longest;
+    };
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,255 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <core/core.h>
+#include <plugins/IPlugin.h>
+#include <plugins/IShell.h>
+
+namespace WPEFramework
+{
+    namespace Utils
+    {
+        // Keeps the COM interfaces obtained through IShell::QueryInterfaceByCallsign,
+        // keyed by callsign and interface ID, so request paths do not walk the
+        // controller's plugin table (and set up proxies, out of process) every time.
+        // Entries are dropped when the owning plugin is deactivated, crashes or becomes
+        // unavailable; the next Acquire queries the shell again. Failed lookups are not
+        // cached, so a plugin that is activated later is picked up on first use.
+        //
+        // Holders of longer-lived state tied to a plugin (notification registrations,
+        // values maintained by its events) can Watch() the cache to learn when that
+        // plugin goes away.
+        class InterfaceCache
+        {
+        public:
+            struct IObserver
+            {
+                virtual ~IObserver() = default;
+
+                // The plugin behind callsign was deactivated or became unavailable; its
+                // cached interfaces are already dropped
+                virtual void Revoked(const string& callsign) = 0;
+            };
+
+        private:
+            class Notification : public PluginHost::IPlugin::INotification
+            {
+            public:
+                explicit Notification(InterfaceCache& parent)
+                    : mParent(parent)
+                {
+                }
+                ~Notification() override = default;
+
+                Notification(const Notification&) = delete;
+                Notification& operator=(const Notification&) = delete;
+
+                void Activated(const string& /*callsign*/, PluginHost::IShell* /*plugin*/) override
+                {
+                }
+                void Deactivated(const string& callsign, PluginHost::IShell* /*plugin*/) override
+                {
+                    mParent.Revoke(callsign);
+                }
+                void Unavailable(const string& callsign, PluginHost::IShell* /*plugin*/) override
+                {
+                    mParent.Revoke(callsign);
+                }
+
+                BEGIN_INTERFACE_MAP(Notification)
+                INTERFACE_ENTRY(PluginHost::IPlugin::INotification)
+                END_INTERFACE_MAP
+
+            private:
+                InterfaceCache& mParent;
+            };
+
+            struct Entry
+            {
+                Core::IUnknown* unknown;
+                void* instance;
+            };
+
+        public:
+            InterfaceCache()
+                : mLock()
+                , mShell(nullptr)
+                , mEntries()
+                , mGeneration(0)
+                , mObserverLock()
+                , mObservers()
+                , mNotification(*this)
+            {
+            }
+
+            ~InterfaceCache()
+            {
+                Close();
+            }
+
+            InterfaceCache(const InterfaceCache&) = delete;
+            InterfaceCache& operator=(const InterfaceCache&) = delete;
+
+            // Starts following plugin state changes on shell; must be matched by Close()
+            // while the shell is still valid
+            void Open(PluginHost::IShell* shell)
+            {
+                ASSERT(shell != nullptr);
+                {
+                    std::lock_guard<std::mutex> lock(mLock);
+                    if (mShell != nullptr) {
+                        return;
+                    }
+                    mShell = shell;
+                }
+                shell->Register(&mNotification);
+            }
+
+            void Close()
+            {
+                PluginHost::IShell* shell = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(mLock);
+                    shell = mShell;
+                    mShell = nullptr;
+                }
+                if (shell != nullptr) {
+                    shell->Unregister(&mNotification);
+                }
+                Invalidate(string());
+            }
+
+            // Returns the interface with a reference held for the caller (Release() it as
+            // with QueryInterfaceByCallsign), or nullptr if the plugin does not provide it.
+            template <typename INTERFACE>
+            INTERFACE* Acquire(const string& callsign)
+            {
+                const Key key(callsign, INTERFACE::ID);
+                PluginHost::IShell* shell = nullptr;
+                uint32_t generation = 0;
+                {
+                    std::lock_guard<std::mutex> lock(mLock);
+                    auto it = mEntries.find(key);
+                    if (it != mEntries.end()) {
+                        it->second.unknown->AddRef();
+                        return static_cast<INTERFACE*>(it->second.instance);
+                    }
+                    shell = mShell;
+                    generation = mGeneration;
+                }
+                if (shell == nullptr) {
+                    return nullptr;
+                }
+
+                // Queried without the lock: the controller may be delivering a state
+                // change notification that needs it
+                INTERFACE* instance = shell->QueryInterfaceByCallsign<INTERFACE>(callsign);
+                if (instance == nullptr) {
+                    return nullptr;
+                }
+
+                std::lock_guard<std::mutex> lock(mLock);
+                if (generation != mGeneration || mShell == nullptr) {
+                    // Invalidated while querying; hand out this reference uncached
+                    return instance;
+                }
+                auto result = mEntries.emplace(key, Entry { instance, instance });
+                if (result.second == false) {
+                    // Another caller cached it first
+                    instance->Release();
+                    instance = static_cast<INTERFACE*>(result.first->second.instance);
+                }
+                result.first->second.unknown->AddRef();
+                return instance;
+            }
+
+            // Drops every interface cached for callsign (all of them if callsign is empty)
+            void Invalidate(const string& callsign)
+            {
+                std::vector<Core::IUnknown*> released;
+                {
+                    std::lock_guard<std::mutex> lock(mLock);
+                    ++mGeneration;
+                    auto it = callsign.empty() ? mEntries.begin() : mEntries.lower_bound(Key(callsign, 0));
+                    while (it != mEntries.end() && (callsign.empty() || it->first.first == callsign)) {
+                        released.push_back(it->second.unknown);
+                        it = mEntries.erase(it);
+                    }
+                }
+                // Released outside the lock; dropping a proxy may call out of process
+                for (Core::IUnknown* unknown : released) {
+                    unknown->Release();
+                }
+            }
+
+            size_t Size() const
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                return mEntries.size();
+            }
+
+            void Watch(IObserver* observer)
+            {
+                ASSERT(observer != nullptr);
+                std::lock_guard<std::mutex> lock(mObserverLock);
+                if (std::find(mObservers.begin(), mObservers.end(), observer) == mObservers.end()) {
+                    mObservers.push_back(observer);
+                }
+            }
+
+            // Once this returns observer is not called any more, nor still being called
+            void Unwatch(IObserver* observer)
+            {
+                std::lock_guard<std::mutex> lock(mObserverLock);
+                mObservers.erase(std::remove(mObservers.begin(), mObservers.end(), observer), mObservers.end());
+            }
+
+        private:
+            typedef std::pair<string, uint32_t> Key;
+
+            void Revoke(const string& callsign)
+            {
+                Invalidate(callsign);
+
+                // Held across the calls so Unwatch() waits for one in progress
+                std::lock_guard<std::mutex> lock(mObserverLock);
+                for (IObserver* observer : mObservers) {
+                    observer->Revoked(callsign);
+                }
+            }
+
+            mutable std::mutex mLock;
+            PluginHost::IShell* mShell;
+            std::map<Key, Entry> mEntries;
+            uint32_t mGeneration;
+            std::mutex mObserverLock;
+            std::vector<IObserver*> mObservers;
+            Core::Sink<Notification> mNotification;
+        };
+    } // namespace Utils
+} // namespace WPEFramework
@@ -0,0 +1,68 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+#pragma once
+
+#include <core/core.h>
+
+#ifndef JOB_POOL_INITIAL_SIZE
+#define JOB_POOL_INITIAL_SIZE 8
+#endif
+
+namespace WPEFramework
+{
+    namespace Utils
+    {
+        // Recycling pool for Core::IDispatch jobs submitted to the worker pool.
+        // JOB must be default constructible and provide Clear(); the proxy pool calls
+        // Clear() when the last reference is dropped and keeps the instance for the
+        // next Element(), so string members retain their capacity between requests.
+        // The pool is a function-local static so it outlives every plugin instance
+        // that hands jobs out of it.
+        template <typename JOB>
+        class JobPool
+        {
+        public:
+            JobPool() = delete;
+            JobPool(const JobPool&) = delete;
+            JobPool& operator=(const JobPool&) = delete;
+
+            static Core::ProxyType<JOB> Element()
+            {
+                return Instance().Element();
+            }
+
+            static uint32_t CurrentQueueSize()
+            {
+                return Instance().CurrentQueueSize();
+            }
+
+            static uint32_t Count()
+            {
+                return Instance().Count();
+            }
+
+        private:
+            static Core::ProxyPoolType<JOB>& Instance()
+            {
+                static Core::ProxyPoolType<JOB> pool(JOB_POOL_INITIAL_SIZE);
+                return pool;
+            }
+        };
+    } // namespace Utils
+} // namespace WPEFramework
@@ -0,0 +1,129 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <deque>
+#include <string>
+
+#ifndef REQUEST_ARENA_MAX_RETAINED_CAPACITY
+#define REQUEST_ARENA_MAX_RETAINED_CAPACITY (16 * 1024)
+#endif
+
+namespace WPEFramework
+{
+    namespace Utils
+    {
+        // Per-thread monotonic scratch space for the transient strings built while a
+        // single request is resolved (lowercased lookup keys, rewritten params).
+        // String() hands out the next slot; slots are never freed individually, the
+        // whole arena is rewound when the outermost Scope ends. Slots keep their
+        // capacity across requests, so a steady request mix stops touching the heap.
+        // References are valid until the enclosing Scope is left.
+        class RequestArena
+        {
+        public:
+            class Scope
+            {
+            public:
+                Scope()
+                    : mArena(RequestArena::Current())
+                    , mMark(mArena.mUsed)
+                {
+                }
+                ~Scope()
+                {
+                    mArena.Rewind(mMark);
+                }
+
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+
+            private:
+                RequestArena& mArena;
+                const size_t mMark;
+            };
+
+            static RequestArena& Current()
+            {
+                static thread_local RequestArena arena;
+                return arena;
+            }
+
+            // Empty string slot owned by the arena
+            std::string& String()
+            {
+                if (mUsed == mSlots.size()) {
+                    mSlots.emplace_back();
+                }
+                std::string& slot = mSlots[mUsed++];
+                slot.clear();
+                return slot;
+            }
+
+            // Lowercased copy of input in an arena slot
+            const std::string& ToLower(const std::string& input)
+            {
+                std::string& slot = String();
+                slot.assign(input);
+                std::transform(slot.begin(), slot.end(), slot.begin(),
+                               [](unsigned char c) { return std::tolower(c); });
+                return slot;
+            }
+
+            size_t Used() const
+            {
+                return mUsed;
+            }
+
+            size_t Slots() const
+            {
+                return mSlots.size();
+            }
+
+        private:
+            RequestArena()
+                : mSlots()
+                , mUsed(0)
+            {
+            }
+
+            RequestArena(const RequestArena&) = delete;
+            RequestArena& operator=(const RequestArena&) = delete;
+
+            void Rewind(const size_t mark)
+            {
+                mUsed = mark;
+                if (mark == 0) {
+                    // Do not let one oversized payload pin memory on this thread forever
+                    for (std::string& slot : mSlots) {
+                        if (slot.capacity() > REQUEST_ARENA_MAX_RETAINED_CAPACITY) {
+                            std::string().swap(slot);
+                        }
+                    }
+                }
+            }
+
+            std::deque<std::string> mSlots;
+            size_t mUsed;
+        };
+    } // namespace Utils
+} // namespace WPEFramework
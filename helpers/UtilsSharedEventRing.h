@@ -0,0 +1,416 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Reserved Emit method that rings the consumer of a SharedEventRing; the payload
+// names the ring and carries its key, see SharedEventRing::DoorbellPayload()
+#define APP_GATEWAY_EVENT_RING_DOORBELL "appgateway.eventRing"
+// Ring names handed over by the doorbell must start with this
+#define APP_GATEWAY_EVENT_RING_PREFIX "/agw-events-"
+
+namespace WPEFramework
+{
+    namespace Utils
+    {
+        // Single producer, single consumer ring of event frames (connection, request,
+        // method, payload) in POSIX shared memory, so events can pass between
+        // processes without a marshaled call each. The producer creates the ring and
+        // the consumer attaches to it by name.
+        //
+        // Head and tail are free-running byte counts in the shared control block;
+        // the producer only moves head and the consumer only moves tail, so neither
+        // side takes a lock. Push() reports when the ring was empty before the frame,
+        // which is the only time the consumer needs waking up: Drain() publishes its
+        // tail before it looks at head again, so a frame pushed while it is draining
+        // is either seen by it or makes the producer ring.
+        //
+        // Frames from the other process are bounds checked before they are read; a
+        // corrupt ring is dropped as a whole rather than followed out of bounds.
+        //
+        // The doorbell travels over an interface anyone can call, so Create() puts a
+        // random key in the ring and the consumer only attaches to, and only drains
+        // for, a doorbell carrying that key. Reading the key takes access to the
+        // segment, which is private to the user that created it.
+        class SharedEventRing
+        {
+        public:
+            static constexpr uint32_t MinimumCapacity = 4096;
+
+            struct Frame
+            {
+                uint32_t connectionId;
+                uint32_t requestId;
+                std::string method;
+                std::string payload;
+            };
+
+        private:
+            static constexpr uint32_t Magic = 0x41475752; // "AGWR"
+            static constexpr uint32_t Version = 2;
+            static constexpr uint32_t Skip = 0xFFFFFFFF;
+
+            struct Control
+            {
+                uint32_t magic;
+                uint32_t version;
+                uint32_t capacity;
+                uint32_t reserved;
+                uint64_t key;
+                alignas(64) std::atomic<uint64_t> head;
+                alignas(64) std::atomic<uint64_t> tail;
+            };
+            static_assert((sizeof(Control) % 64) == 0, "frames start on a cache line");
+            static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared counters must be lock free to work across processes");
+
+            struct Record
+            {
+                uint32_t size; // whole record, 8 byte aligned; Skip in methodLength pads to the end
+                uint32_t connectionId;
+                uint32_t requestId;
+                uint32_t methodLength;
+                uint32_t payloadLength;
+                uint32_t reserved;
+            };
+            static_assert((sizeof(Record) % 8) == 0, "records stay 8 byte aligned");
+
+        public:
+            SharedEventRing()
+                : mName()
+                , mControl(nullptr)
+                , mData(nullptr)
+                , mCapacity(0)
+                , mMapped(0)
+                , mOwner(false)
+            {
+            }
+
+            ~SharedEventRing()
+            {
+                Close();
+            }
+
+            SharedEventRing(const SharedEventRing&) = delete;
+            SharedEventRing& operator=(const SharedEventRing&) = delete;
+
+            // Producer side: creates (or replaces a stale) ring with room for capacity
+            // bytes of frames
+            bool Create(const std::string& name, const uint32_t capacity)
+            {
+                Close();
+                const uint32_t usable = (capacity < MinimumCapacity ? MinimumCapacity : capacity) & ~static_cast<uint32_t>(7);
+
+                int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+                if ((fd < 0) && (errno == EEXIST)) {
+                    ::shm_unlink(name.c_str());
+                    fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+                }
+                if (fd < 0) {
+                    return false;
+                }
+                const size_t size = sizeof(Control) + usable;
+                if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+                    ::close(fd);
+                    ::shm_unlink(name.c_str());
+                    return false;
+                }
+                void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                ::close(fd);
+                if (base == MAP_FAILED) {
+                    ::shm_unlink(name.c_str());
+                    return false;
+                }
+
+                mControl = new (base) Control();
+                mControl->magic = Magic;
+                mControl->version = Version;
+                mControl->capacity = usable;
+                mControl->reserved = 0;
+                mControl->key = NewKey();
+                mControl->head.store(0, std::memory_order_relaxed);
+                mControl->tail.store(0, std::memory_order_release);
+                Map(name, base, size, usable, true);
+                return true;
+            }
+
+            // Consumer side: attaches to a ring created by Create() of this user with the
+            // given key. The ring attached so far stays in place if this fails.
+            bool Attach(const std::string& name, const uint64_t key)
+            {
+                const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+                if (fd < 0) {
+                    return false;
+                }
+                struct stat info;
+                if ((::fstat(fd, &info) != 0) || (info.st_uid != ::geteuid()) || ((info.st_mode & (S_IRWXG | S_IRWXO)) != 0)
+                    || (static_cast<size_t>(info.st_size) < sizeof(Control) + MinimumCapacity)) {
+                    ::close(fd);
+                    return false;
+                }
+                const size_t size = static_cast<size_t>(info.st_size);
+                void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                ::close(fd);
+                if (base == MAP_FAILED) {
+                    return false;
+                }
+
+                Control* control = static_cast<Control*>(base);
+                const uint32_t capacity = control->capacity;
+                if ((control->magic != Magic) || (control->version != Version) || (control->key != key)
+                    || (capacity < MinimumCapacity) || ((capacity & 7) != 0) || (sizeof(Control) + capacity > size)) {
+                    ::munmap(base, size);
+                    return false;
+                }
+                Close();
+                mControl = control;
+                Map(name, base, size, capacity, false);
+                return true;
+            }
+
+            void Close()
+            {
+                if (mControl != nullptr) {
+                    ::munmap(mControl, mMapped);
+                    if (mOwner) {
+                        ::shm_unlink(mName.c_str());
+                    }
+                }
+                mName.clear();
+                mControl = nullptr;
+                mData = nullptr;
+                mCapacity = 0;
+                mMapped = 0;
+                mOwner = false;
+            }
+
+            bool IsOpen() const
+            {
+                return (mControl != nullptr);
+            }
+
+            const std::string& Name() const
+            {
+                return mName;
+            }
+
+            uint32_t Capacity() const
+            {
+                return mCapacity;
+            }
+
+            uint64_t Key() const
+            {
+                return (mControl != nullptr) ? mControl->key : 0;
+            }
+
+            // True once the consumer has taken every frame pushed so far
+            bool IsEmpty() const
+            {
+                return (mControl == nullptr)
+                    || (mControl->tail.load(std::memory_order_acquire) == mControl->head.load(std::memory_order_relaxed));
+            }
+
+            // Payload of the doorbell Emit that names this ring and carries its key
+            std::string DoorbellPayload() const
+            {
+                char key[17];
+                ::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(Key()));
+                return "{\"ring\":\"" + mName + "\",\"key\":\"" + key + "\"}";
+            }
+
+            // Reads back what DoorbellPayload() wrote; false for anything else
+            static bool ParseDoorbellPayload(const std::string& payload, std::string& name, uint64_t& key)
+            {
+                static const std::string Head = "{\"ring\":\"";
+                static const std::string Middle = "\",\"key\":\"";
+                static const std::string Tail = "\"}";
+                static constexpr size_t KeyLength = 16;
+                if ((payload.size() < Head.size() + Middle.size() + KeyLength + Tail.size())
+                    || (payload.compare(0, Head.size(), Head) != 0)
+                    || (payload.compare(payload.size() - Tail.size(), Tail.size(), Tail) != 0)) {
+                    return false;
+                }
+                const size_t middle = payload.size() - Tail.size() - KeyLength - Middle.size();
+                if ((middle < Head.size()) || (payload.compare(middle, Middle.size(), Middle) != 0)) {
+                    return false;
+                }
+                name = payload.substr(Head.size(), middle - Head.size());
+                if (name.find('"') != std::string::npos) {
+                    return false;
+                }
+                key = 0;
+                for (size_t index = middle + Middle.size(); index < payload.size() - Tail.size(); ++index) {
+                    const char digit = payload[index];
+                    uint64_t value;
+                    if ((digit >= '0') && (digit <= '9')) {
+                        value = static_cast<uint64_t>(digit - '0');
+                    } else if ((digit >= 'a') && (digit <= 'f')) {
+                        value = static_cast<uint64_t>(digit - 'a' + 10);
+                    } else {
+                        return false;
+                    }
+                    key = (key << 4) | value;
+                }
+                return true;
+            }
+
+            // Appends a frame; false if it does not fit right now (the caller delivers it
+            // another way). wasEmpty is set when the consumer has to be rung.
+            bool Push(const uint32_t connectionId, const uint32_t requestId, const std::string& method,
+                const std::string& payload, bool& wasEmpty)
+            {
+                wasEmpty = false;
+                if (mControl == nullptr) {
+                    return false;
+                }
+                const uint64_t length = sizeof(Record) + static_cast<uint64_t>(method.size()) + payload.size();
+                const uint64_t need = (length + 7) & ~static_cast<uint64_t>(7);
+                if (need > mCapacity) {
+                    return false;
+                }
+
+                const uint64_t head = mControl->head.load(std::memory_order_relaxed);
+                const uint64_t tail = mControl->tail.load(std::memory_order_acquire);
+                const uint32_t offset = static_cast<uint32_t>(head % mCapacity);
+                const uint32_t toEnd = mCapacity - offset;
+                const uint32_t pad = (toEnd < need) ? toEnd : 0;
+                if ((head - tail) + pad + need > mCapacity) {
+                    return false;
+                }
+
+                if ((pad != 0) && (pad >= sizeof(Record))) {
+                    const Record skip = { pad, 0, 0, Skip, 0, 0 };
+                    ::memcpy(mData + offset, &skip, sizeof(skip));
+                }
+                uint8_t* target = mData + ((head + pad) % mCapacity);
+                const Record record = { static_cast<uint32_t>(need), connectionId, requestId,
+                    static_cast<uint32_t>(method.size()), static_cast<uint32_t>(payload.size()), 0 };
+                ::memcpy(target, &record, sizeof(record));
+                ::memcpy(target + sizeof(record), method.data(), method.size());
+                ::memcpy(target + sizeof(record) + method.size(), payload.data(), payload.size());
+
+                // Publish, then look at the consumer's progress (pairs with Drain())
+                mControl->head.store(head + pad + need, std::memory_order_seq_cst);
+                wasEmpty = (mControl->tail.load(std::memory_order_seq_cst) == head);
+                return true;
+            }
+
+            // Hands every frame in the ring to handler(const Frame&) and keeps going until
+            // the ring is seen empty after the tail was published. Returns the number of
+            // frames delivered; corrupt contents are dropped and counted in corrupt.
+            template <typename HANDLER>
+            uint32_t Drain(HANDLER&& handler, uint32_t& corrupt)
+            {
+                uint32_t delivered = 0;
+                corrupt = 0;
+                if (mControl == nullptr) {
+                    return 0;
+                }
+
+                Frame frame;
+                uint64_t tail = mControl->tail.load(std::memory_order_relaxed);
+                uint64_t head = mControl->head.load(std::memory_order_seq_cst);
+                while (head != tail) {
+                    if ((head < tail) || (head - tail > mCapacity)) {
+                        // Counters out of step: nothing in between can be trusted
+                        ++corrupt;
+                        tail = head;
+                        break;
+                    }
+                    while (tail != head) {
+                        const uint32_t offset = static_cast<uint32_t>(tail % mCapacity);
+                        const uint32_t toEnd = mCapacity - offset;
+                        Record record;
+                        if (toEnd < sizeof(Record)) {
+                            tail += toEnd;
+                            continue;
+                        }
+                        ::memcpy(&record, mData + offset, sizeof(record));
+                        if ((record.methodLength == Skip) && (record.size == toEnd)) {
+                            tail += toEnd;
+                            continue;
+                        }
+                        const uint64_t length = sizeof(Record) + static_cast<uint64_t>(record.methodLength) + record.payloadLength;
+                        if ((record.size < length) || ((record.size & 7) != 0) || (record.size > toEnd) || (record.size > head - tail)) {
+                            ++corrupt;
+                            tail = head;
+                            break;
+                        }
+                        frame.connectionId = record.connectionId;
+                        frame.requestId = record.requestId;
+                        const char* text = reinterpret_cast<const char*>(mData + offset + sizeof(record));
+                        frame.method.assign(text, record.methodLength);
+                        frame.payload.assign(text + record.methodLength, record.payloadLength);
+                        tail += record.size;
+
+                        // Hand the space back before the frame is handled
+                        mControl->tail.store(tail, std::memory_order_release);
+                        handler(static_cast<const Frame&>(frame));
+                        ++delivered;
+                    }
+                    // Publish, then look for frames pushed meanwhile (pairs with Push())
+                    mControl->tail.store(tail, std::memory_order_seq_cst);
+                    head = mControl->head.load(std::memory_order_seq_cst);
+                }
+                mControl->tail.store(tail, std::memory_order_seq_cst);
+                return delivered;
+            }
+
+        private:
+            static uint64_t NewKey()
+            {
+                std::random_device source;
+                uint64_t key = 0;
+                while (key == 0) {
+                    key = (static_cast<uint64_t>(source()) << 32) | source();
+                }
+                return key;
+            }
+
+            void Map(const std::string& name, void* base, const size_t size, const uint32_t capacity, const bool owner)
+            {
+                mName = name;
+                mData = static_cast<uint8_t*>(base) + sizeof(Control);
+                mCapacity = capacity;
+                mMapped = size;
+                mOwner = owner;
+            }
+
+            std::string mName;
+            Control* mControl;
+            uint8_t* mData;
+            uint32_t mCapacity;
+            size_t mMapped;
+            bool mOwner;
+        };
+    } // namespace Utils
+} // namespace WPEFramework
@@ -0,0 +1,264 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace WPEFramework
+{
+    namespace Utils
+    {
+        // Bounded queue of telemetry markers with its own sender thread, so a slow
+        // telemetry daemon never holds up the thread that reports (or flushes) the
+        // data. When the queue is full the oldest marker is dropped and counted.
+        //
+        // A Batch held while a flush is queued merges the sender's wake-ups: it is
+        // woken when the batch ends, or earlier once half the capacity is queued so
+        // it keeps up with a large flush. Nothing posted while a batch is open is
+        // dropped; the queue may grow past its capacity until the batch is sent.
+        //
+        // Without a running sender (before Start(), after Stop()) Post() sends on
+        // the caller's thread, as the telemetry code did before it had a queue.
+        class TelemetryQueue
+        {
+        public:
+            using Sender = std::function<void(const std::string& marker, const std::string& payload)>;
+
+            // Defers waking the sender until the scope ends; scopes may nest and overlap
+            class Batch
+            {
+            public:
+                explicit Batch(TelemetryQueue& queue)
+                    : mQueue(queue)
+                {
+                    std::lock_guard<std::mutex> lock(mQueue.mLock);
+                    ++mQueue.mBatches;
+                }
+                ~Batch()
+                {
+                    std::lock_guard<std::mutex> lock(mQueue.mLock);
+                    if ((--mQueue.mBatches == 0) && !mQueue.mQueue.empty()) {
+                        mQueue.mWakeUp.notify_all();
+                    }
+                }
+                Batch(const Batch&) = delete;
+                Batch& operator=(const Batch&) = delete;
+
+            private:
+                TelemetryQueue& mQueue;
+            };
+
+            TelemetryQueue(Sender sender, const uint32_t capacity)
+                : mSender(std::move(sender))
+                , mLock()
+                , mWakeUp()
+                , mIdle()
+                , mQueue()
+                , mCapacity(capacity == 0 ? 1 : capacity)
+                , mBatches(0)
+                , mSending(false)
+                , mDraining(false)
+                , mRunning(false)
+                , mStopping(false)
+                , mDropped(0)
+                , mReported(0)
+                , mSent(0)
+                , mThread()
+            {
+            }
+
+            ~TelemetryQueue()
+            {
+                Stop(0);
+            }
+
+            TelemetryQueue(const TelemetryQueue&) = delete;
+            TelemetryQueue& operator=(const TelemetryQueue&) = delete;
+
+            // Starts the sender thread; false if it is already running
+            bool Start()
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                if (mRunning) {
+                    return false;
+                }
+                mRunning = true;
+                mDraining = false;
+                mStopping = false;
+                mThread = std::thread(&TelemetryQueue::Run, this);
+                return true;
+            }
+
+            // Gives the sender up to timeoutMs to empty the queue, then stops it. What
+            // it could not send is dropped and counted. Returns true if nothing was lost.
+            // The limit is best effort: the marker being sent by then is allowed to
+            // finish, so a daemon stuck in that call holds Stop() up past timeoutMs.
+            bool Stop(const uint32_t timeoutMs)
+            {
+                std::thread sender;
+                bool drained = true;
+                {
+                    std::unique_lock<std::mutex> lock(mLock);
+                    if (!mRunning) {
+                        return true;
+                    }
+                    // Open batches no longer hold the sender back
+                    mDraining = true;
+                    mWakeUp.notify_all();
+                    drained = mIdle.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                        [this] { return mQueue.empty() && !mSending; });
+                    mDropped += mQueue.size();
+                    mQueue.clear();
+                    mStopping = true;
+                    mRunning = false;
+                    mWakeUp.notify_all();
+                    sender = std::move(mThread);
+                }
+                // The marker being sent right now is allowed to finish
+                if (sender.joinable()) {
+                    sender.join();
+                }
+                return drained;
+            }
+
+            void Post(std::string&& marker, std::string&& payload)
+            {
+                std::unique_lock<std::mutex> lock(mLock);
+                if (!mRunning) {
+                    lock.unlock();
+                    mSender(marker, payload);
+                    return;
+                }
+                if ((mBatches == 0) && (mQueue.size() >= mCapacity)) {
+                    mQueue.pop_front();
+                    ++mDropped;
+                }
+                mQueue.emplace_back(std::move(marker), std::move(payload));
+                if ((mBatches == 0) || (mQueue.size() == WakeUpLevel())) {
+                    mWakeUp.notify_all();
+                }
+            }
+
+            void Post(const std::string& marker, const std::string& payload)
+            {
+                Post(std::string(marker), std::string(payload));
+            }
+
+            void SetCapacity(const uint32_t capacity)
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                mCapacity = (capacity == 0 ? 1 : capacity);
+                while (mQueue.size() > mCapacity) {
+                    mQueue.pop_front();
+                    ++mDropped;
+                }
+            }
+
+            uint32_t Capacity() const
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                return mCapacity;
+            }
+
+            uint32_t Pending() const
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                return static_cast<uint32_t>(mQueue.size());
+            }
+
+            // Markers dropped since construction, on overflow or at Stop()
+            uint64_t Dropped() const
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                return mDropped;
+            }
+
+            // Markers handed to the sender by the sender thread
+            uint64_t Sent() const
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                return mSent;
+            }
+
+            // Drops seen since the last call, for the caller to report; 0 if none
+            uint64_t TakeDropped()
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                const uint64_t dropped = mDropped - mReported;
+                mReported = mDropped;
+                return dropped;
+            }
+
+        private:
+            // Queued markers that wake the sender while a batch is open
+            size_t WakeUpLevel() const
+            {
+                return (static_cast<size_t>(mCapacity) + 1) / 2;
+            }
+
+            void Run()
+            {
+                std::unique_lock<std::mutex> lock(mLock);
+                while (!mStopping) {
+                    mWakeUp.wait(lock, [this] {
+                        return mStopping || (!mQueue.empty() && ((mBatches == 0) || mDraining || (mQueue.size() >= WakeUpLevel())));
+                    });
+
+                    // One wake-up sends everything queued by then, a marker at a time so
+                    // Stop() can cut a slow daemon off between two of them
+                    mSending = true;
+                    while (!mStopping && !mQueue.empty()) {
+                        std::pair<std::string, std::string> item(std::move(mQueue.front()));
+                        mQueue.pop_front();
+                        lock.unlock();
+                        mSender(item.first, item.second);
+                        lock.lock();
+                        ++mSent;
+                    }
+                    mSending = false;
+                    mIdle.notify_all();
+                }
+            }
+
+            Sender mSender;
+            mutable std::mutex mLock;
+            std::condition_variable mWakeUp;
+            std::condition_variable mIdle;
+            std::deque<std::pair<std::string, std::string>> mQueue;
+            uint32_t mCapacity;
+            uint32_t mBatches;
+            bool mSending;
+            bool mDraining;
+            bool mRunning;
+            bool mStopping;
+            uint64_t mDropped;
+            uint64_t mReported;
+            uint64_t mSent;
+            std::thread mThread;
+        };
+    } // namespace Utils
+} // namespace WPEFramework
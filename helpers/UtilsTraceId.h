@@ -0,0 +1,103 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unistd.h>
+
+namespace WPEFramework
+{
+    namespace Utils
+    {
+        // Compact request trace identifier. Next() is a process-wide counter salted
+        // with the pid, so IDs are unique within a run and unlikely to repeat across
+        // restarts, without the cost of a UUID. The ID of the request being handled
+        // on a thread is installed with a Scope; jobs capture Current() when they are
+        // created and reinstall it when they run, so every hop of one request logs the
+        // same ID. 0 means "no trace".
+        class TraceId
+        {
+        public:
+            class Scope
+            {
+            public:
+                explicit Scope(const uint64_t id)
+                    : mPrevious(Slot())
+                {
+                    Slot() = id;
+                }
+                ~Scope()
+                {
+                    Slot() = mPrevious;
+                }
+
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+
+            private:
+                const uint64_t mPrevious;
+            };
+
+            TraceId() = delete;
+
+            static uint64_t Next()
+            {
+                static const uint64_t salt = (static_cast<uint64_t>(::getpid()) & 0xFFFF) << 48;
+                static std::atomic<uint64_t> counter(0);
+                const uint64_t id = salt | ((counter.fetch_add(1, std::memory_order_relaxed) + 1) & 0xFFFFFFFFFFFFULL);
+                return (id == 0) ? 1 : id;
+            }
+
+            static uint64_t Current()
+            {
+                return Slot();
+            }
+
+            // The current ID, or a fresh one for work that did not arrive with a trace
+            static uint64_t CurrentOrNext()
+            {
+                const uint64_t id = Slot();
+                return (id != 0) ? id : Next();
+            }
+
+            // 16 lowercase hex digits; empty for 0
+            static std::string ToString(const uint64_t id)
+            {
+                if (id == 0) {
+                    return std::string();
+                }
+                static const char digits[] = "0123456789abcdef";
+                std::string text(16, '0');
+                for (int index = 15; index >= 0; --index) {
+                    text[index] = digits[(id >> ((15 - index) * 4)) & 0xF];
+                }
+                return text;
+            }
+
+        private:
+            static uint64_t& Slot()
+            {
+                static thread_local uint64_t current = 0;
+                return current;
+            }
+        };
+    } // namespace Utils
+} // namespace WPEFramework
@@ -0,0 +1,225 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace WPEFramework
+{
+    namespace Utils
+    {
+        // Versioned binary snapshot of state that is expensive to rebuild at start-up.
+        // The file carries the caller's schema version and a fingerprint of the sources
+        // the state was derived from; Reader refuses it if either differs or if the
+        // payload checksum does not match, so a stale or torn snapshot is never used.
+        // Writer replaces the file atomically (temporary file, fsync, rename).
+        //
+        // Layout: magic, format version, schema version, fingerprint, payload length,
+        // payload, FNV-1a checksum of the payload. The payload is a sequence of
+        // 32-bit values and length-prefixed strings in host byte order; a snapshot is
+        // only ever read back on the device that wrote it.
+        class WarmSnapshot
+        {
+        public:
+            class Writer
+            {
+            public:
+                Writer(const uint32_t schemaVersion, const uint64_t fingerprint)
+                    : mSchemaVersion(schemaVersion)
+                    , mFingerprint(fingerprint)
+                    , mPayload()
+                {
+                }
+
+                void Put(const uint32_t value)
+                {
+                    mPayload.append(reinterpret_cast<const char*>(&value), sizeof(value));
+                }
+
+                void Put(const std::string& value)
+                {
+                    Put(static_cast<uint32_t>(value.size()));
+                    mPayload.append(value);
+                }
+
+                bool Commit(const std::string& path) const
+                {
+                    const std::string temporary = path + ".tmp";
+                    FILE* file = std::fopen(temporary.c_str(), "wb");
+                    if (file == nullptr) {
+                        return false;
+                    }
+                    Header header;
+                    header.magic = Magic;
+                    header.format = FormatVersion;
+                    header.schema = mSchemaVersion;
+                    header.length = static_cast<uint32_t>(mPayload.size());
+                    header.fingerprint = mFingerprint;
+                    const uint64_t checksum = Hash(Seed, mPayload.data(), mPayload.size());
+
+                    bool written = (std::fwrite(&header, sizeof(header), 1, file) == 1)
+                        && (mPayload.empty() || std::fwrite(mPayload.data(), mPayload.size(), 1, file) == 1)
+                        && (std::fwrite(&checksum, sizeof(checksum), 1, file) == 1)
+                        && (std::fflush(file) == 0)
+                        && (::fsync(::fileno(file)) == 0);
+                    written = (std::fclose(file) == 0) && written;
+                    if (!written || std::rename(temporary.c_str(), path.c_str()) != 0) {
+                        std::remove(temporary.c_str());
+                        return false;
+                    }
+                    return true;
+                }
+
+            private:
+                const uint32_t mSchemaVersion;
+                const uint64_t mFingerprint;
+                std::string mPayload;
+            };
+
+            class Reader
+            {
+            public:
+                Reader()
+                    : mPayload()
+                    , mOffset(0)
+                {
+                }
+
+                // False if the file is missing, torn, or was written for other sources or schema
+                bool Open(const std::string& path, const uint32_t schemaVersion, const uint64_t fingerprint)
+                {
+                    mPayload.clear();
+                    mOffset = 0;
+                    std::ifstream file(path, std::ios::in | std::ios::binary);
+                    if (!file.is_open()) {
+                        return false;
+                    }
+                    Header header;
+                    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+                        || header.magic != Magic || header.format != FormatVersion
+                        || header.schema != schemaVersion || header.fingerprint != fingerprint) {
+                        return false;
+                    }
+                    mPayload.resize(header.length);
+                    uint64_t checksum = 0;
+                    if ((header.length > 0 && !file.read(&mPayload[0], header.length))
+                        || !file.read(reinterpret_cast<char*>(&checksum), sizeof(checksum))
+                        || checksum != Hash(Seed, mPayload.data(), mPayload.size())) {
+                        mPayload.clear();
+                        return false;
+                    }
+                    return true;
+                }
+
+                bool Get(uint32_t& value)
+                {
+                    if (mPayload.size() - mOffset < sizeof(value)) {
+                        return false;
+                    }
+                    ::memcpy(&value, mPayload.data() + mOffset, sizeof(value));
+                    mOffset += sizeof(value);
+                    return true;
+                }
+
+                bool Get(std::string& value)
+                {
+                    uint32_t length = 0;
+                    if (!Get(length) || mPayload.size() - mOffset < length) {
+                        return false;
+                    }
+                    value.assign(mPayload, mOffset, length);
+                    mOffset += length;
+                    return true;
+                }
+
+                bool AtEnd() const
+                {
+                    return mOffset == mPayload.size();
+                }
+
+            private:
+                std::string mPayload;
+                size_t mOffset;
+            };
+
+            WarmSnapshot() = delete;
+
+            // Identifies the exact source files: path, mtime, size and content hash of
+            // each, in order. A missing file contributes a marker, so a source that
+            // appears or disappears also invalidates the snapshot.
+            static uint64_t Fingerprint(const std::vector<std::string>& sources)
+            {
+                uint64_t hash = Seed;
+                for (const std::string& path : sources) {
+                    hash = Hash(hash, path.data(), path.size() + 1);
+                    struct stat info;
+                    if (::stat(path.c_str(), &info) != 0) {
+                        static const char missing[] = "\xff";
+                        hash = Hash(hash, missing, sizeof(missing));
+                        continue;
+                    }
+                    const uint64_t stamp[3] = {
+                        static_cast<uint64_t>(info.st_mtim.tv_sec),
+                        static_cast<uint64_t>(info.st_mtim.tv_nsec),
+                        static_cast<uint64_t>(info.st_size)
+                    };
+                    hash = Hash(hash, stamp, sizeof(stamp));
+
+                    std::ifstream file(path, std::ios::in | std::ios::binary);
+                    const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+                    hash = Hash(hash, content.data(), content.size());
+                }
+                return hash;
+            }
+
+        private:
+            enum : uint32_t {
+                Magic = 0x53574741, // "AGWS"
+                FormatVersion = 1
+            };
+            static constexpr uint64_t Seed = 14695981039346656037ULL;
+
+            struct Header
+            {
+                uint32_t magic;
+                uint32_t format;
+                uint32_t schema;
+                uint32_t length;
+                uint64_t fingerprint;
+            };
+
+            static uint64_t Hash(uint64_t hash, const void* data, const size_t length)
+            {
+                const unsigned char* bytes = static_cast<const unsigned char*>(data);
+                for (size_t index = 0; index < length; ++index) {
+                    hash = (hash ^ bytes[index]) * 1099511628211ULL;
+                }
+                return hash;
+            }
+        };
+    } // namespace Utils
+} // namespace WPEFramework
@@ -0,0 +1,581 @@
+/**
+ * If not stated otherwise in this file or this component's LICENSE
+ * file the following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define UTILS_WEBSOCKET_PAYLOAD_X86 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__aarch64__)
+#include <arm_neon.h>
+#define UTILS_WEBSOCKET_PAYLOAD_NEON 1
+#endif
+
+namespace WPEFramework
+{
+    namespace Utils
+    {
+        // Payload kernels for inbound WebSocket frames: XOR unmasking (RFC 6455 5.3)
+        // and the ASCII scan that lets UTF-8 validation of text frames skip whole
+        // blocks. Each has a scalar version and, where the CPU has one, a vector
+        // version (SSE2/AVX2 on x86, NEON on ARM). The best available set is picked
+        // once at first use; Select() overrides it for tests and benchmarks.
+        class WebSocketPayload
+        {
+        public:
+            typedef void (*UnmaskFunction)(uint8_t* data, size_t length, const uint8_t key[4], uint8_t phase);
+            typedef size_t (*AsciiFunction)(const uint8_t* data, size_t length);
+
+            struct Kernels
+            {
+                const char* name;
+                UnmaskFunction unmask;
+                AsciiFunction ascii;
+            };
+
+            // XORs data with key, starting at key byte phase (0..3)
+            static void Unmask(uint8_t* data, const size_t length, const uint8_t key[4], const uint8_t phase)
+            {
+                Active().unmask(data, length, key, phase);
+            }
+
+            // Number of leading bytes below 0x80
+            static size_t AsciiPrefix(const uint8_t* data, const size_t length)
+            {
+                return (Active().ascii(data, length));
+            }
+
+            static const Kernels& Active()
+            {
+                const Kernels* kernels = ActiveSlot().load(std::memory_order_acquire);
+                if (kernels == nullptr) {
+                    kernels = &Best();
+                    ActiveSlot().store(kernels, std::memory_order_release);
+                }
+                return (*kernels);
+            }
+
+            // Kernel sets usable on this CPU, scalar first; returns the count
+            static uint8_t Available(const Kernels* list[], const uint8_t max)
+            {
+                uint8_t count = 0;
+                const Kernels* candidates[] = { &Scalar(), Vector128(), Vector256() };
+                for (const Kernels* candidate : candidates) {
+                    if ((candidate != nullptr) && (count < max)) {
+                        list[count++] = candidate;
+                    }
+                }
+                return (count);
+            }
+
+            // Makes the named set active; false if it is not available here
+            static bool Select(const char* name)
+            {
+                const Kernels* list[3];
+                const uint8_t count = Available(list, 3);
+                for (uint8_t index = 0; index < count; ++index) {
+                    if (::strcmp(list[index]->name, name) == 0) {
+                        ActiveSlot().store(list[index], std::memory_order_release);
+                        return (true);
+                    }
+                }
+                return (false);
+            }
+
+        private:
+            static std::atomic<const Kernels*>& ActiveSlot()
+            {
+                static std::atomic<const Kernels*> slot(nullptr);
+                return (slot);
+            }
+
+            static const Kernels& Best()
+            {
+                const Kernels* wide = Vector256();
+                if (wide != nullptr) {
+                    return (*wide);
+                }
+                const Kernels* vector = Vector128();
+                return (vector != nullptr ? *vector : Scalar());
+            }
+
+            // The key repeated over 8 bytes, rotated so byte 0 lines up with phase
+            static uint64_t KeyWord(const uint8_t key[4], const uint8_t phase)
+            {
+                uint8_t bytes[8];
+                for (uint8_t index = 0; index < 8; ++index) {
+                    bytes[index] = key[(phase + index) & 0x03];
+                }
+                uint64_t word;
+                ::memcpy(&word, bytes, sizeof(word));
+                return (word);
+            }
+
+            static void UnmaskTail(uint8_t* data, const size_t length, const uint8_t key[4], const uint8_t phase)
+            {
+                for (size_t index = 0; index < length; ++index) {
+                    data[index] ^= key[(phase + index) & 0x03];
+                }
+            }
+
+            static void UnmaskScalar(uint8_t* data, const size_t length, const uint8_t key[4], const uint8_t phase)
+            {
+                // Eight bytes at a time; 8 is a multiple of the key length so the
+                // phase is unchanged for the tail
+                const uint64_t mask = KeyWord(key, phase);
+                size_t index = 0;
+                for (; index + 8 <= length; index += 8) {
+                    uint64_t word;
+                    ::memcpy(&word, data + index, sizeof(word));
+                    word ^= mask;
+                    ::memcpy(data + index, &word, sizeof(word));
+                }
+                UnmaskTail(data + index, length - index, key, phase);
+            }
+
+            static size_t AsciiScalar(const uint8_t* data, const size_t length)
+            {
+                size_t index = 0;
+                for (; index + 8 <= length; index += 8) {
+                    uint64_t word;
+                    ::memcpy(&word, data + index, sizeof(word));
+                    if ((word & 0x8080808080808080ULL) != 0) {
+                        break;
+                    }
+                }
+                while ((index < length) && (data[index] < 0x80)) {
+                    ++index;
+                }
+                return (index);
+            }
+
+            static const Kernels& Scalar()
+            {
+                static const Kernels kernels = { "scalar", &UnmaskScalar, &AsciiScalar };
+                return (kernels);
+            }
+
+#if defined(UTILS_WEBSOCKET_PAYLOAD_X86)
+            __attribute__((target("sse2"))) static void UnmaskSSE2(uint8_t* data, const size_t length, const uint8_t key[4], const uint8_t phase)
+            {
+                const __m128i mask = _mm_set1_epi64x(static_cast<long long>(KeyWord(key, phase)));
+                size_t index = 0;
+                for (; index + 16 <= length; index += 16) {
+                    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(data + index), _mm_xor_si128(block, mask));
+                }
+                UnmaskScalar(data + index, length - index, key, phase);
+            }
+
+            __attribute__((target("sse2"))) static size_t AsciiSSE2(const uint8_t* data, const size_t length)
+            {
+                size_t index = 0;
+                for (; index + 16 <= length; index += 16) {
+                    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+                    if (_mm_movemask_epi8(block) != 0) {
+                        break;
+                    }
+                }
+                return (index + AsciiScalar(data + index, length - index));
+            }
+
+            __attribute__((target("avx2"))) static void UnmaskAVX2(uint8_t* data, const size_t length, const uint8_t key[4], const uint8_t phase)
+            {
+                const __m256i mask = _mm256_set1_epi64x(static_cast<long long>(KeyWord(key, phase)));
+                size_t index = 0;
+                for (; index + 32 <= length; index += 32) {
+                    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + index), _mm256_xor_si256(block, mask));
+                }
+                UnmaskSSE2(data + index, length - index, key, phase);
+            }
+
+            __attribute__((target("avx2"))) static size_t AsciiAVX2(const uint8_t* data, const size_t length)
+            {
+                size_t index = 0;
+                for (; index + 32 <= length; index += 32) {
+                    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+                    if (_mm256_movemask_epi8(block) != 0) {
+                        break;
+                    }
+                }
+                return (index + AsciiSSE2(data + index, length - index));
+            }
+
+            static const Kernels* Vector128()
+            {
+                static const Kernels kernels = { "sse2", &UnmaskSSE2, &AsciiSSE2 };
+                return (__builtin_cpu_supports("sse2") ? &kernels : nullptr);
+            }
+
+            static const Kernels* Vector256()
+            {
+                static const Kernels kernels = { "avx2", &UnmaskAVX2, &AsciiAVX2 };
+                return (__builtin_cpu_supports("avx2") ? &kernels : nullptr);
+            }
+#elif defined(UTILS_WEBSOCKET_PAYLOAD_NEON)
+            static void UnmaskNEON(uint8_t* data, const size_t length, const uint8_t key[4], const uint8_t phase)
+            {
+                const uint8x16_t mask = vreinterpretq_u8_u64(vdupq_n_u64(KeyWord(key, phase)));
+                size_t index = 0;
+                for (; index + 16 <= length; index += 16) {
+                    vst1q_u8(data + index, veorq_u8(vld1q_u8(data + index), mask));
+                }
+                UnmaskScalar(data + index, length - index, key, phase);
+            }
+
+            static size_t AsciiNEON(const uint8_t* data, const size_t length)
+            {
+                size_t index = 0;
+                for (; index + 16 <= length; index += 16) {
+                    const uint8x16_t block = vld1q_u8(data + index);
+#if defined(__aarch64__)
+                    if (vmaxvq_u8(block) >= 0x80) {
+                        break;
+                    }
+#else
+                    uint8x8_t folded = vorr_u8(vget_low_u8(block), vget_high_u8(block));
+                    if ((vget_lane_u64(vreinterpret_u64_u8(folded), 0) & 0x8080808080808080ULL) != 0) {
+                        break;
+                    }
+#endif
+                }
+                return (index + AsciiScalar(data + index, length - index));
+            }
+
+            static const Kernels* Vector128()
+            {
+                static const Kernels kernels = { "neon", &UnmaskNEON, &AsciiNEON };
+                return (&kernels);
+            }
+
+            static const Kernels* Vector256()
+            {
+                return (nullptr);
+            }
+#else
+            static const Kernels* Vector128()
+            {
+                return (nullptr);
+            }
+
+            static const Kernels* Vector256()
+            {
+                return (nullptr);
+            }
+#endif
+        };
+
+        // Incremental UTF-8 validator for text messages that arrive in pieces (frames,
+        // socket reads). Rejects overlong forms, surrogates and code points above
+        // U+10FFFF; runs of ASCII are skipped with WebSocketPayload::AsciiPrefix().
+        class Utf8Validator
+        {
+        public:
+            Utf8Validator()
+                : mNeed(0)
+                , mLower(0x80)
+                , mUpper(0xBF)
+                , mValid(true)
+            {
+            }
+
+            void Reset()
+            {
+                mNeed = 0;
+                mLower = 0x80;
+                mUpper = 0xBF;
+                mValid = true;
+            }
+
+            bool Update(const uint8_t* data, const size_t length)
+            {
+                size_t index = 0;
+                while (mValid && (index < length)) {
+                    if (mNeed == 0) {
+                        index += WebSocketPayload::AsciiPrefix(data + index, length - index);
+                        if (index == length) {
+                            break;
+                        }
+                    }
+                    mValid = Step(data[index++]);
+                }
+                return (mValid);
+            }
+
+            // True if everything seen so far ends on a character boundary
+            bool Complete() const
+            {
+                return (mValid && (mNeed == 0));
+            }
+
+            static bool IsValid(const uint8_t* data, const size_t length)
+            {
+                Utf8Validator validator;
+                return (validator.Update(data, length) && validator.Complete());
+            }
+
+        private:
+            bool Step(const uint8_t byte)
+            {
+                if (mNeed != 0) {
+                    if ((byte < mLower) || (byte > mUpper)) {
+                        return (false);
+                    }
+                    --mNeed;
+                    mLower = 0x80;
+                    mUpper = 0xBF;
+                    return (true);
+                }
+                if (byte < 0x80) {
+                    return (true);
+                }
+                if ((byte >= 0xC2) && (byte <= 0xDF)) {
+                    mNeed = 1;
+                } else if (byte == 0xE0) {
+                    mNeed = 2;
+                    mLower = 0xA0;
+                } else if (byte == 0xED) {
+                    mNeed = 2;
+                    mUpper = 0x9F;
+                } else if ((byte >= 0xE1) && (byte <= 0xEF)) {
+                    mNeed = 2;
+                } else if (byte == 0xF0) {
+                    mNeed = 3;
+                    mLower = 0x90;
+                } else if (byte == 0xF4) {
+                    mNeed = 3;
+                    mUpper = 0x8F;
+                } else if ((byte >= 0xF1) && (byte <= 0xF3)) {
+                    mNeed = 3;
+                } else {
+                    return (false);
+                }
+                return (true);
+            }
+
+            uint8_t mNeed;
+            uint8_t mLower;
+            uint8_t mUpper;
+            bool mValid;
+        };
+
+        // Follows the inbound frame stream of a WebSocket server link ahead of the
+        // protocol decoder. Masked frames are unmasked in place with the vector kernels
+        // and their header is rewritten as unmasked, so the decoder only parses it, and
+        // text messages are checked for valid UTF-8 across frames and reads.
+        //
+        // Prepare() is called with the bytes the decoder is about to see; on return the
+        // first skip bytes are the dropped masking key and must be consumed without
+        // decoding. A frame header that is not complete yet is left alone: the decoder
+        // does not consume it either and it is presented again with the next read.
+        // After a failure the stream is no longer followed and Failed() stays set.
+        class WebSocketInboundFrames
+        {
+        public:
+            WebSocketInboundFrames()
+                : mPending(0)
+                , mPhase(0)
+                , mMasked(false)
+                , mControl(false)
+                , mText(false)
+                , mFinal(false)
+                , mFailed(false)
+                , mKey()
+                , mUtf8()
+            {
+            }
+
+            void Reset()
+            {
+                mPending = 0;
+                mPhase = 0;
+                mMasked = false;
+                mControl = false;
+                mText = false;
+                mFinal = false;
+                mFailed = false;
+                mUtf8.Reset();
+            }
+
+            bool Failed() const
+            {
+                return (mFailed);
+            }
+
+            // False if a text message is not valid UTF-8 (RFC 6455 8.1: fail the connection)
+            bool Prepare(uint8_t* data, const size_t length, uint16_t& skip)
+            {
+                skip = 0;
+                if (mFailed == true) {
+                    return (false);
+                }
+                mFailed = (Follow(data, length, skip) == false);
+                return (mFailed == false);
+            }
+
+        private:
+            bool Follow(uint8_t* data, const size_t length, uint16_t& skip)
+            {
+                size_t offset = 0;
+
+                if (mPending == 0) {
+                    size_t header = 0;
+                    if (Header(data, length, header) == false) {
+                        return (true);
+                    }
+                    if (mMasked == true) {
+                        // Drop the key: move the rest of the header onto it
+                        ::memcpy(mKey, data + header - 4, 4);
+                        ::memmove(data + 4, data, header - 4);
+                        data[5] &= 0x7F;
+                        skip = 4;
+                    }
+                    offset = header;
+                    if ((mPending == 0) && (MessageEnd() == false)) {
+                        return (false);
+                    }
+                }
+
+                if ((mPending > 0) && (offset < length)) {
+                    const size_t available = length - offset;
+                    const size_t chunk = (mPending < available ? static_cast<size_t>(mPending) : available);
+                    uint8_t* payload = data + offset;
+                    if (mMasked == true) {
+                        WebSocketPayload::Unmask(payload, chunk, mKey, mPhase);
+                        mPhase = static_cast<uint8_t>((mPhase + chunk) & 0x03);
+                    }
+                    mPending -= chunk;
+                    if ((mControl == false) && (mText == true) && (mUtf8.Update(payload, chunk) == false)) {
+                        return (false);
+                    }
+                    if ((mPending == 0) && (MessageEnd() == false)) {
+                        return (false);
+                    }
+                }
+                return (true);
+            }
+
+            // Parses a complete frame header, returning its size including the key
+            bool Header(const uint8_t* data, const size_t length, size_t& size)
+            {
+                if (length < 2) {
+                    return (false);
+                }
+                const uint8_t opcode = data[0] & 0x0F;
+                if ((data[0] & 0x70) != 0) {
+                    // Reserved bits: no extension is negotiated, leave it to the decoder
+                    return (false);
+                }
+                uint64_t payload = data[1] & 0x7F;
+                size = 2;
+                if (payload == 126) {
+                    size += 2;
+                } else if (payload == 127) {
+                    size += 8;
+                }
+                const bool masked = ((data[1] & 0x80) != 0);
+                if (masked) {
+                    size += 4;
+                }
+                if (length < size) {
+                    return (false);
+                }
+                if (payload == 126) {
+                    payload = (static_cast<uint64_t>(data[2]) << 8) | data[3];
+                } else if (payload == 127) {
+                    payload = 0;
+                    for (uint8_t index = 2; index < 10; ++index) {
+                        payload = (payload << 8) | data[index];
+                    }
+                }
+
+                mPending = payload;
+                mPhase = 0;
+                mMasked = masked;
+                mControl = ((opcode & 0x08) != 0);
+                if (mControl == false) {
+                    if (opcode != 0) {
+                        // First frame of a message; continuation frames keep its type
+                        mText = (opcode == 0x01);
+                        mUtf8.Reset();
+                    }
+                    mFinal = ((data[0] & 0x80) != 0);
+                }
+                return (true);
+            }
+
+            bool MessageEnd()
+            {
+                if ((mControl == false) && (mFinal == true) && (mText == true)) {
+                    const bool complete = mUtf8.Complete();
+                    mUtf8.Reset();
+                    mText = false;
+                    return (complete);
+                }
+                return (true);
+            }
+
+            uint64_t mPending;
+            uint8_t mPhase;
+            bool mMasked;
+            bool mControl;
+            bool mText;
+            bool mFinal;
+            bool mFailed;
+            uint8_t mKey[4];
+            Utf8Validator mUtf8;
+        };
+
+        // Close frame sent by the server (RFC 6455 5.5.1): status code followed by a
+        // reason, such as 1012 (service restart) with a retry hint. Server frames are
+        // not masked. The reason is cut to what fits a control frame, never inside a
+        // UTF-8 character.
+        class WebSocketCloseFrame
+        {
+        public:
+            static constexpr uint16_t ServiceRestart = 1012;
+            static constexpr uint8_t MaxReason = 123;
+
+            static std::string Build(const uint16_t code, const std::string& reason)
+            {
+                size_t length = (reason.size() > MaxReason ? MaxReason : reason.size());
+                if (length < reason.size()) {
+                    while ((length > 0) && ((static_cast<uint8_t>(reason[length]) & 0xC0) == 0x80)) {
+                        --length;
+                    }
+                }
+
+                std::string frame;
+                frame.reserve(4 + length);
+                frame.push_back(static_cast<char>(0x88));
+                frame.push_back(static_cast<char>(2 + length));
+                frame.push_back(static_cast<char>(code >> 8));
+                frame.push_back(static_cast<char>(code & 0xFF));
+                frame.append(reason, 0, length);
+                return (frame);
+            }
+        };
+    } // namespace Utils
+} // namespace WPEFramework
@@ -24,6 +24,7 @@
 #include <messaging/messaging.h>
 #include <interfaces/definitions.h>
 #include "UtilsLogging.h"
+#include "UtilsWebSocketPayload.h"
 
 namespace WPEFramework {
 namespace Web {
@@ -233,6 +234,9 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _inbound()
+                , _closeFrame()
+                , _closePending(false)
             {
             }
             template <typename... Args>
@@ -250,6 +254,9 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _inbound()
+                , _closeFrame()
+                , _closePending(false)
             {
             }
 POP_WARNING()
@@ -385,6 +392,32 @@ POP_WARNING()
 
                 return (result);
             }
+            // As above, but a WebSocket gets a close frame with code and reason once
+            // everything queued before it has been sent
+            uint32_t Close(const uint32_t waitTime, const uint16_t code, const string& reason)
+            {
+                bool trigger = false;
+
+                _adminLock.Lock();
+
+                if (IsSuspended() == false) {
+                    if ((State() & WEBSOCKET) != 0) {
+                        _closeFrame = Utils::WebSocketCloseFrame::Build(code, reason);
+                        _closePending = true;
+                        trigger = true;
+                    }
+
+                    _state |= SUSPENDED;
+                }
+
+                _adminLock.Unlock();
+
+                if (trigger == true) {
+                    ACTUALLINK::Trigger();
+                }
+
+                return (CheckForClose(waitTime));
+            }
 
             // Methods to extract and insert data into the socket buffers
             uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
@@ -401,6 +434,12 @@ POP_WARNING()
 
                         result = _handler.Encoder(dataFrame, (maxSendSize - 4), result);
                     }
+                    if ((result == 0) && (_closePending == true) && (maxSendSize >= _closeFrame.size())) {
+                        // Nothing else left to send, the close frame goes last
+                        ::memcpy(dataFrame, _closeFrame.data(), _closeFrame.size());
+                        result = static_cast<uint16_t>(_closeFrame.size());
+                        _closePending = false;
+                    }
                 } else {
                     result = _serializerImpl.Serialize(dataFrame, maxSendSize);
                 }
@@ -424,9 +463,30 @@ POP_WARNING()
                 if ((_state & WEBSOCKET) != 0) {
                     bool tooSmall = false;
 
+                    if (_inbound.Failed() == true) {
+                        // Closing after a protocol violation, nothing more is decoded
+                        result = receivedSize;
+                    }
+
                     // check for multiple messages if available...
                     while ((result < receivedSize) && (tooSmall == false)) {
                         uint16_t actualDataSize = receivedSize - result;
+                        uint16_t skip = 0;
+
+                        // Unmask and validate ahead of the decoder, see WebSocketInboundFrames
+                        if (_inbound.Prepare(&dataFrame[result], actualDataSize, skip) == false) {
+                            TRACE_L1("Invalid UTF-8 in a text message on the web socket, closing");
+
+                            // Fail the connection (RFC 6455 8.1)
+                            _handler.Close();
+                            ACTUALLINK::Trigger();
+
+                            result = receivedSize;
+                            break;
+                        }
+                        result += skip;
+                        actualDataSize -= skip;
+
                         uint16_t headerSize = _handler.Decoder(const_cast<uint8_t*>(&dataFrame[result]), actualDataSize);
                         uint64_t payloadSizeInControlFrame;
 
@@ -562,7 +622,7 @@ POP_WARNING()
             {
                 uint32_t result = 0;
 
-                if ((IsSuspended() == true) && (_serializerImpl.IsIdle() == true) && (_deserialiserImpl.IsIdle() == true) && (_parent.IsIdle() == true)) {
+                if ((IsSuspended() == true) && (_closePending == false) && (_serializerImpl.IsIdle() == true) && (_deserialiserImpl.IsIdle() == true) && (_parent.IsIdle() == true)) {
                     result = ACTUALLINK::Close(waitTime);
                 } else
                     while (waitTime > 0) {
@@ -576,7 +636,7 @@ POP_WARNING()
                                 waitTime -= sleepTime;
                             }
                         }
-                        if ((IsOpen() == false) || ((IsSuspended() == true) && (_serializerImpl.IsIdle() == true) && (_deserialiserImpl.IsIdle() == true) && (_parent.IsIdle() == true))) {
+                        if ((IsOpen() == false) || ((IsSuspended() == true) && (_closePending == false) && (_serializerImpl.IsIdle() == true) && (_deserialiserImpl.IsIdle() == true) && (_parent.IsIdle() == true))) {
                             result = ACTUALLINK::Close(waitTime);
 
                             waitTime = 0;
@@ -676,6 +736,7 @@ POP_WARNING()
 
                     _adminLock.Lock();
 
+                    _inbound.Reset();
                     _state = (_state & 0xF0) | WEBSOCKET;
 
                     _parent.StateChange();
@@ -742,6 +803,7 @@ POP_WARNING()
                     _adminLock.Lock();
 
                     // Seems like we succeeded, turn on the link..
+                    _inbound.Reset();
                     _state = (_state & 0xF0) | WEBSOCKET;
 
                     _parent.StateChange();
@@ -773,6 +835,9 @@ POP_WARNING()
             string _commandData;
             Core::ProxyType<typename OUTBOUND::BaseElement> _webSocketMessage;
             uint64_t _pingFireTime;
+            Utils::WebSocketInboundFrames _inbound;
+            string _closeFrame;
+            std::atomic<bool> _closePending;
         };
 
     public:
@@ -896,6 +961,10 @@ POP_WARNING()
         {
             return (_channel.Close(waitTime));
         }
+        uint32_t Close(const uint32_t waitTime, const uint16_t code, const string& reason)
+        {
+            return (_channel.Close(waitTime, code, reason));
+        }
         void Ping()
         {
             _channel.Ping();
@@ -1070,6 +1139,10 @@ POP_WARNING()
         {
             return (_channel.Close(waitTime));
         }
+        uint32_t Close(const uint32_t waitTime, const uint16_t code, const string& reason)
+        {
+            return (_channel.Close(waitTime, code, reason));
+        }
         
         const string& Query() const
         {
@@ -19,8 +19,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <memory>
+#include <set>
+#include <vector>
 #include <plugins/plugins.h>
 #include "UtilsLogging.h"
 #include "WebSocketLink.h"
@@ -29,8 +32,15 @@
 // TODO: Remove once IsNullValue() in core/JSON.h is fixed
 // and replace StreamJSONOneShotType with StreamJSONType
 #include "StreamJSONOneShot.h"
+#include "UtilsFirebolt.h"
 
 #define DEFAULT_SOCKET_ADDRESS "127.0.0.1"
+
+// Send buffer of each connection. Messages whose payload is larger are queued as
+// preformatted text and streamed through it piece by piece (one frame per fill)
+// instead of being built and serialized as JSON-RPC elements.
+#define WEBSOCKET_SEND_BUFFER_SIZE 8096
+
 using namespace WPEFramework;
 
 class WebSocketConnectionManager
@@ -106,7 +116,7 @@ public:
                   false, false, false,
                   connector,
                   remoteNode.AnyInterface(),
-                  8096, 8096),
+                  WEBSOCKET_SEND_BUFFER_SIZE, 8096),
         _id(0),
         _parent(static_cast<WebSocketConnectionManager::WebSocketChannel &>(*parent)),
         _queue(10){
@@ -151,6 +161,12 @@ public:
             if (this->IsOpen())
             {
                 LOGTRACE("Open - OK");
+                auto& manager = _parent.Interface();
+                if (manager.IsDraining() == true) {
+                    LOGWARN("Draining, turning away connectionId: %d", _id);
+                    this->Close(0, WPEFramework::Utils::WebSocketCloseFrame::ServiceRestart, manager._drainReason);
+                    return;
+                }
                 const std::string &query = Link().Query();
                 if (_parent.Interface()._authHandler != nullptr) {
                     bool authResult = _parent.Interface()._authHandler(_id, query);
@@ -167,6 +183,7 @@ public:
             else if(this->IsSuspended())
             {
                 LOGTRACE("Closed - %s", this->IsSuspended() ? _T("SUSPENDED") : _T("OK"));
+                _parent.Interface().Track(Id(), false);
                 if (_parent.Interface()._disconnectHandler != nullptr) {
                     _parent.Interface()._disconnectHandler(Id());
                 }
@@ -200,6 +217,7 @@ public:
         void Id(const uint32_t id){
             LOGTRACE("Assigning connectionId: %d", id);
             _id = id;
+            _parent.Interface().Track(id, true);
 
             // Process any pending messages for this connection
             _qLock.Lock();
@@ -239,6 +257,24 @@ public:
                         return;
                     }
 
+                    // A frame without a method that carries result or error answers a
+                    // request the gateway sent to this app
+                    if (!message->Designator.IsSet() && (message->Result.IsSet() || message->Error.IsSet())) {
+                        auto& manager = _parent.Interface();
+                        if (manager._responseHandler) {
+                            string payload;
+                            if (message->Error.IsSet()) {
+                                message->Error.ToString(payload);
+                            } else {
+                                payload = message->Result.Value();
+                            }
+                            manager._responseHandler(_id, static_cast<uint32_t>(requestId), payload, message->Error.IsSet());
+                        } else {
+                            LOGWARN("Response %d on connection %d dropped, no response handler set", requestId, connectionId);
+                        }
+                        return;
+                    }
+
                     // Extract method name from designator
                     if(!message->Designator.IsSet()) {
                         SendJSONRPCResponse(R"({"error": "Message MUST contain a method field"})", requestId, connectionId);
@@ -363,6 +399,7 @@ public:
     using MessageHandler = std::function<void(const std::string& method, const std::string& params, const uint32_t requestId, const uint32_t connectionId)>;
     using AuthHandler = std::function<bool(const uint32_t connectionId, const std::string& token)>;
     using DisconnectHandler = std::function<void(const uint32_t connectionId)>;
+    using ResponseHandler = std::function<bool(const uint32_t connectionId, const uint32_t requestId, const std::string& payload, const bool isError)>;
 
 #ifdef ENABLE_APP_GATEWAY_AUTOMATION
     // JSON container classes for automation messages
@@ -404,6 +441,8 @@ public:
 
     void SetDisconnectHandler(DisconnectHandler handler) { _disconnectHandler = handler; }
 
+    void SetResponseHandler(const ResponseHandler& handler) { _responseHandler = handler; }
+
     // NEW: Setter for automation ID
     void SetAutomationId(uint32_t automationId) { 
         _automationId = automationId; 
@@ -411,6 +450,31 @@ public:
     }
 
 private:
+    static std::string EnvelopeStart()
+    {
+        return std::string("{\"jsonrpc\":\"") + Core::JSONRPC::Message::DefaultVersion + "\",";
+    }
+
+    static std::string Quoted(const std::string &text)
+    {
+        Core::JSON::String value;
+        value = text;
+        std::string quoted;
+        value.ToString(quoted);
+        return quoted;
+    }
+
+    // Queues text that is already in wire form; streamed through the send buffer
+    // without an intermediate JSON element
+    void SubmitPreformatted(const uint32_t connectionId, const std::shared_ptr<const Core::PreformattedMessage> &message)
+    {
+        Core::ProxyType<WebSocketServer> client = mChannel->Client(connectionId);
+        if (client.IsValid() == true) {
+            LOGTRACE("WebSocket streaming %u bytes to connectionId: %d", message->Length(), connectionId);
+            client->Submit(message);
+        }
+    }
+
     // Helper method to forward messages to automation server
     void ForwardToAutomation(const std::string& designator, const std::string& payload) {
         #ifdef ENABLE_APP_GATEWAY_AUTOMATION
@@ -430,18 +494,10 @@ public:
     // Use the SendJSONRPCResponse in Websocket Server to send the message
     bool SendMessageToConnection(const uint32_t connectionId, const std::string &result, const int requestId)
     {
-        Core::ProxyType<Core::JSONRPC::Message> response = Core::ProxyType<Core::JSONRPC::Message>::Create();
-        response->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
-        response->Id = requestId;
-
+        // Constant outcomes (null/true/false, the fixed Firebolt errors) are not parsed
+        const std::shared_ptr<const Core::PreformattedMessage> constant = ConstantEnvelope(requestId, result);
         Core::JSONRPC::Message::Info info;
-        if (info.FromString(result) && info.Code.IsSet() && info.Text.IsSet()) {
-            response->Error = info;
-        } else {
-            response->Result = result;
-        }
-
-
+        const bool isError = (constant == nullptr) && (info.FromString(result) && info.Code.IsSet() && info.Text.IsSet());
 
         LOGTRACE("[SendJSONRPCResponse] Sending response for requestId=%d, connectionId=%d response=%s", requestId, connectionId, result.c_str());
 
@@ -450,7 +506,21 @@ public:
             LOGWARN("[SendJSONRPCResponse] mChannel is null, dropping response for requestId=%d, connectionId=%d", requestId, connectionId);
             return false;
         }
-        mChannel->Submit(connectionId, Core::ProxyType<Core::JSON::IElement>(response));
+        if (constant != nullptr) {
+            SubmitPreformatted(connectionId, constant);
+        } else if ((isError == false) && (result.size() > WEBSOCKET_SEND_BUFFER_SIZE)) {
+            SubmitPreformatted(connectionId, ResponseEnvelope(requestId, result));
+        } else {
+            Core::ProxyType<Core::JSONRPC::Message> response = Core::ProxyType<Core::JSONRPC::Message>::Create();
+            response->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+            response->Id = requestId;
+            if (isError == true) {
+                response->Error = info;
+            } else {
+                response->Result = result;
+            }
+            mChannel->Submit(connectionId, Core::ProxyType<Core::JSON::IElement>(response));
+        }
         
         #ifdef ENABLE_APP_GATEWAY_AUTOMATION
         // Forward to automation server after sending response
@@ -473,16 +543,20 @@ public:
 
     bool DispatchNotificationToConnection(const uint32_t connectionId, const std::string &designator, const std::string &payload)
     {
-        Core::ProxyType<Core::JSONRPC::Message> event = Core::ProxyType<Core::JSONRPC::Message>::Create();
-        event->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
-        event->Designator = designator;
-        event->Parameters = payload;
         LOGTRACE("Emit Event for method=%s, connectionId=%d params=%s", designator.c_str(), connectionId, payload.c_str());
         if (nullptr == mChannel) {
             LOGWARN("[DispatchNotificationToConnection] mChannel is null, dropping notification for method=%s, connectionId=%d", designator.c_str(), connectionId);
             return false;
         }
-        mChannel->Submit(connectionId, Core::ProxyType<Core::JSON::IElement>(event));
+        if (payload.size() > WEBSOCKET_SEND_BUFFER_SIZE) {
+            SubmitPreformatted(connectionId, NotificationEnvelope(designator, payload));
+        } else {
+            Core::ProxyType<Core::JSONRPC::Message> event = Core::ProxyType<Core::JSONRPC::Message>::Create();
+            event->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+            event->Designator = designator;
+            event->Parameters = payload;
+            mChannel->Submit(connectionId, Core::ProxyType<Core::JSON::IElement>(event));
+        }
         
         #ifdef ENABLE_APP_GATEWAY_AUTOMATION
         // Forward to automation server after sending notification
@@ -505,18 +579,21 @@ public:
 
     bool SendRequestToConnection(const uint32_t connectionId, const std::string &designator, const uint32_t requestId, const std::string &params)
     {
-        Core::ProxyType<Core::JSONRPC::Message> request = Core::ProxyType<Core::JSONRPC::Message>::Create();
-        request->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
-        request->Id = requestId;
-        request->Designator = designator;
-        request->Parameters = params;
-
         LOGTRACE("Send Request for method=%s, connectionId=%d params=%s", designator.c_str(), connectionId, params.c_str());
         if (nullptr == mChannel) {
             LOGWARN("[SendRequestToConnection] mChannel is null, dropping request for method=%s, connectionId=%d", designator.c_str(), connectionId);
             return false;
         }
-        mChannel->Submit(connectionId, Core::ProxyType<Core::JSON::IElement>(request));
+        if (params.size() > WEBSOCKET_SEND_BUFFER_SIZE) {
+            SubmitPreformatted(connectionId, RequestEnvelope(designator, requestId, params));
+        } else {
+            Core::ProxyType<Core::JSONRPC::Message> request = Core::ProxyType<Core::JSONRPC::Message>::Create();
+            request->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+            request->Id = requestId;
+            request->Designator = designator;
+            request->Parameters = params;
+            mChannel->Submit(connectionId, Core::ProxyType<Core::JSON::IElement>(request));
+        }
 
         #ifdef ENABLE_APP_GATEWAY_AUTOMATION
         // Forward to automation server after sending request
@@ -538,6 +615,41 @@ public:
         return true;
     }
 
+    // Wire form of a response, notification or request with an opaque payload, the
+    // same text Core::JSONRPC::Message serializes for those fields
+    static std::shared_ptr<const Core::PreformattedMessage> ResponseEnvelope(const int requestId, const std::string &result)
+    {
+        return std::make_shared<const Core::PreformattedMessage>(
+            EnvelopeStart() + "\"id\":" + std::to_string(static_cast<uint32_t>(requestId)) + ",\"result\":",
+            std::make_shared<const std::string>(result), std::string("}"));
+    }
+
+    // Wire form of a response whose body is one of the ConstantResponses, or an empty
+    // pointer; the rendered tail is shared, only the ID part is built per response
+    static std::shared_ptr<const Core::PreformattedMessage> ConstantEnvelope(const int requestId, const std::string &result)
+    {
+        const std::shared_ptr<const std::string> &tail = ConstantResponses::Tail(result);
+        if (tail == nullptr) {
+            return nullptr;
+        }
+        return std::make_shared<const Core::PreformattedMessage>(
+            EnvelopeStart() + "\"id\":" + std::to_string(static_cast<uint32_t>(requestId)), tail, std::string());
+    }
+
+    static std::shared_ptr<const Core::PreformattedMessage> NotificationEnvelope(const std::string &designator, const std::string &payload)
+    {
+        return std::make_shared<const Core::PreformattedMessage>(
+            EnvelopeStart() + "\"method\":" + Quoted(designator) + ",\"params\":",
+            std::make_shared<const std::string>(payload), std::string("}"));
+    }
+
+    static std::shared_ptr<const Core::PreformattedMessage> RequestEnvelope(const std::string &designator, const uint32_t requestId, const std::string &params)
+    {
+        return std::make_shared<const Core::PreformattedMessage>(
+            EnvelopeStart() + "\"id\":" + std::to_string(requestId) + ",\"method\":" + Quoted(designator) + ",\"params\":",
+            std::make_shared<const std::string>(params), std::string("}"));
+    }
+
     // Method to update connection status to automation server
     void UpdateConnection(uint32_t connectionId, const std::string& appId, bool connected) {
         #ifdef ENABLE_APP_GATEWAY_AUTOMATION
@@ -582,6 +694,58 @@ public:
         }
     }
 
+    // Turns away new connections from now on with a service restart close frame
+    // carrying reason (e.g. a retry hint); established ones are left alone until
+    // CloseAll()
+    void BeginDrain(const std::string &reason)
+    {
+        std::lock_guard<std::mutex> lock(_connectionsLock);
+        _drainReason = reason;
+        _draining = true;
+    }
+
+    bool IsDraining() const
+    {
+        return (_draining.load(std::memory_order_acquire));
+    }
+
+    // Sends every connection the close frame given to BeginDrain() after what is
+    // already queued for it, then waits up to waitMs for them to go down. Returns
+    // the number of connections still up.
+    uint32_t CloseAll(const uint32_t waitMs)
+    {
+        std::vector<uint32_t> connections;
+        std::string reason;
+        {
+            std::lock_guard<std::mutex> lock(_connectionsLock);
+            connections.assign(_connections.begin(), _connections.end());
+            reason = _drainReason;
+        }
+        if (nullptr == mChannel) {
+            return 0;
+        }
+        for (const uint32_t connectionId : connections) {
+            Core::ProxyType<WebSocketServer> client = mChannel->Client(connectionId);
+            if (client.IsValid() == true) {
+                client->Close(0, WPEFramework::Utils::WebSocketCloseFrame::ServiceRestart, reason);
+            }
+        }
+
+        const uint64_t deadline = Core::Time::Now().Add(waitMs).Ticks();
+        uint32_t remaining = Connections();
+        while ((remaining > 0) && (Core::Time::Now().Ticks() < deadline)) {
+            SleepMs(10);
+            remaining = Connections();
+        }
+        return remaining;
+    }
+
+    uint32_t Connections() const
+    {
+        std::lock_guard<std::mutex> lock(_connectionsLock);
+        return static_cast<uint32_t>(_connections.size());
+    }
+
     // Close connection for a given connection id
     void Close(const uint32_t connectionId) {
         if (nullptr == mChannel) {
@@ -597,6 +761,23 @@ private:
     MessageHandler _messageHandler;
     AuthHandler _authHandler;
     DisconnectHandler _disconnectHandler;
+    ResponseHandler _responseHandler;
     WebSocketChannel *mChannel = nullptr;
     uint32_t _automationId = 0;
+
+    // Connections that are up, for CloseAll()
+    void Track(const uint32_t connectionId, const bool up)
+    {
+        std::lock_guard<std::mutex> lock(_connectionsLock);
+        if (up == true) {
+            _connections.insert(connectionId);
+        } else {
+            _connections.erase(connectionId);
+        }
+    }
+
+    mutable std::mutex _connectionsLock;
+    std::set<uint32_t> _connections;
+    std::atomic<bool> _draining{false};
+    std::string _drainReason;
 };